@@ -41,19 +41,32 @@ void mix_main (void *pargs)
 	while (_InterlockedAnd (&a->run, 1))
 	{
 		WaitForMultipleObjects (a->nactive, a->Aready, TRUE, INFINITE);
+		if (!_InterlockedAnd (&a->run, 1)) break;
 		xaamix (a);
 		(*a->Outbound)(a->outbound_id, a->outsize, a->out);
 		// WriteAudio (30.0, 48000, a->outsize, a->out, 3);
 	}
+	ReleaseSemaphore (a->Done, 1, 0);
 	_endthread();
 }
 
 void start_mixthread (AAMIX a)
 {
+	InterlockedBitTestAndSet (&a->threadrun, 0);
 	HANDLE handle = (HANDLE) _beginthread(mix_main, 0, (void *)a);
 	//SetThreadPriority (handle, THREAD_PRIORITY_HIGHEST);
 }
 
+void stop_mixthread (AAMIX a)
+{
+	int i;
+	InterlockedBitTestAndReset (&a->run, 0);			// set a trap for the mixer thread
+	for (i = 0; i < a->ninputs; i++)
+		ReleaseSemaphore (a->Ready[i], 1, 0);			// be sure the mixer thread can pass WaitForMultipleObjects in main()
+	if (InterlockedBitTestAndReset (&a->threadrun, 0))
+		WaitForSingleObject (a->Done, INFINITE);		// wait for the mixer thread to leave main()
+}
+
 enum _slew
 {
 	BEGIN = 0,
@@ -162,7 +175,10 @@ void* create_aamix (
 	a->slew.tdelaydown = tdelaydown;
 	a->slew.tslewdown = tslewdown;
 	for (i = 0; i < a->ninputs; i++)
+	{
 		a->ring[i] = (double*) malloc0 (a->rsize * sizeof (complex));
+		a->tags[i] = create_prbq ();
+	}
 	a->out = (double*) malloc0 (a->outsize * sizeof (complex));
 	a->nactive = 0;
 	for (i = 0; i < a->ninputs; i++)
@@ -173,7 +189,7 @@ void* create_aamix (
 		a->outidx[i]		= 0;
 		a->unqueuedsamps[i] = 0;
 		a->Ready[i] = CreateSemaphore (0, 0, 1000, 0);
-		InitializeCriticalSectionAndSpinCount(&a->cs_in[i], 2500);
+		a->busy[i] = 0;
 		if (_InterlockedAnd(&a->active, 0xffffffff) & (1 << i))
 		{
 			a->Aready[a->nactive++] = a->Ready[i];
@@ -196,7 +212,7 @@ void* create_aamix (
 		a->resampbuff[i] = (double *) malloc0 (a->ringinsize * sizeof (complex));
 		a->rsmp[i] = create_resample (run, size, 0, a->resampbuff[i], a->inrate[i], a->outrate, 0.0, 0, 1.0);
 	}
-	InitializeCriticalSectionAndSpinCount(&a->cs_out, 2500);
+	a->Done = CreateSemaphore (0, 0, 1, 0);
 	// slew
 	create_aaslew (a);
 	// slew_end
@@ -212,21 +228,20 @@ void destroy_aamix (void* ptr, int id)
 	AAMIX a;
 	if (ptr == 0)	a = paamix[id];
 	else			a = (AAMIX)ptr;
-	InterlockedBitTestAndReset (&a->run, 0);
-	for (i = 0; i < a->ninputs; i++)
-		ReleaseSemaphore (a->Ready[i], 1, 0);
-	Sleep (2);
-	DeleteCriticalSection (&a->cs_out);
+	stop_mixthread (a);
+	CloseHandle (a->Done);
 	for (i = 0; i < a->ninputs; i++)
 	{
 		destroy_resample (a->rsmp[i]);
 		_aligned_free (a->resampbuff[i]);
-		DeleteCriticalSection (&a->cs_in[i]);
 		CloseHandle (a->Ready[i]);
 	}
 	_aligned_free (a->out);
 	for (i = 0; i < a->ninputs; i++)
+	{
+		destroy_prbq (a->tags[i]);
 		_aligned_free (a->ring[i]);
+	}
 	// slew
 	destroy_aaslew (a);
 	// slew_end
@@ -234,16 +249,22 @@ void destroy_aamix (void* ptr, int id)
 }
 
 // loads data from a buffer into an audio mixer ring
+//	each ring has a single producer (the thread calling xMixAudio() for that stream) and a single consumer
+//	(the mixer thread); the Ready semaphore publishes the data, so no lock is held, and the resampler runs
+//	on the producer's thread.  'busy' lets close_mixer() wait for an infusion that is already past the gate.
 void xMixAudio (void* ptr, int id, int stream, double* data)
 {
 	int first, second, n;
+	long long t;
 	double* indata;
 	AAMIX a;
 	if (ptr == 0)	a = paamix[id];
 	else			a = (AAMIX)ptr;
+	_InterlockedIncrement (&a->busy[stream]);
 	if (_InterlockedAnd (&a->accept[stream], 1))
 	{
-		EnterCriticalSection (&a->cs_in[stream]);
+		probe_now (&t);
+		inprbq (a->tags[stream], a->ringinsize, t);
 		if (a->rsmp[stream]->run)
 		{
 			a->rsmp[stream]->in = data;
@@ -264,6 +285,8 @@ void xMixAudio (void* ptr, int id, int stream, double* data)
 		}
 		memcpy (a->ring[stream] + 2 * a->inidx[stream], indata,             first  * sizeof (complex));
 		memcpy (a->ring[stream],						indata + 2 * first, second * sizeof (complex));
+		if ((a->inidx[stream] += a->ringinsize) >= a->rsize)
+			a->inidx[stream] -= a->rsize;
 
 		if ((a->unqueuedsamps[stream] += a->ringinsize) >= a->outsize)
 		{
@@ -271,10 +294,8 @@ void xMixAudio (void* ptr, int id, int stream, double* data)
 			ReleaseSemaphore (a->Ready[stream], n, 0);
 			a->unqueuedsamps[stream] -= n * a->outsize;
 		}
-		if ((a->inidx[stream] += a->ringinsize) >= a->rsize)
-			a->inidx[stream] -= a->rsize;
-		LeaveCriticalSection (&a->cs_in[stream]);
 	}
+	_InterlockedDecrement (&a->busy[stream]);
 }
 
 void upslew (AAMIX a)
@@ -419,18 +440,20 @@ void downslew (AAMIX a)
 	}
 }
 
+void mixadd (int n, double vol, double* in, double* out)
+{	// out += vol * in, n complex samples
+	int i;
+	const __m128d v = _mm_set1_pd (vol);
+	for (i = 0; i < n; i++)
+		_mm_storeu_pd (&out[2 * i], _mm_add_pd (_mm_loadu_pd (&out[2 * i]), _mm_mul_pd (v, _mm_loadu_pd (&in[2 * i]))));
+}
+
 // pulls data from audio rings and mixes with output
 void xaamix (AAMIX a)
 {
-	int i, j;
+	int i, first;
 	int what, mask, idx;
-	EnterCriticalSection(&a->cs_out);
-	if (!_InterlockedAnd (&a->run, 1)) 
-	{
-		LeaveCriticalSection (&a->cs_out);
-		_endthread();
-		return; //MW0LGE_21j
-	}
+	long long t0, t1;
 	memset (a->out, 0, a->outsize * sizeof (complex));
 	what = _InterlockedAnd(&a->what, 0xffffffff) & _InterlockedAnd(&a->active, 0xffffffff);
 	i = 0;
@@ -438,24 +461,26 @@ void xaamix (AAMIX a)
 	{
 		mask = 1 << i;
 		if ((mask & what) != 0)
-		{
+		{	// at most two contiguous segments of the ring
 			idx = a->outidx[i];
-			for (j = 0; j < a->outsize; j++)
-			{
-				a->out[2 * j + 0] += a->tvol[i] * a->ring[i][2 * idx + 0];
-				a->out[2 * j + 1] += a->tvol[i] * a->ring[i][2 * idx + 1];
-				if (++idx == a->rsize) idx = 0;
-			}
+			first = a->rsize - idx;
+			if (first > a->outsize) first = a->outsize;
+			mixadd (first, a->tvol[i], a->ring[i] + 2 * idx, a->out);
+			mixadd (a->outsize - first, a->tvol[i], a->ring[i], a->out + 2 * first);
 			what &= ~mask;
 		}
 		i++;
 	}
+	probe_now (&t1);
 	for (i = 0; i < a->ninputs; i++)
 		if (_InterlockedAnd (&a->accept[i], 1))
+		{
 			if ((a->outidx[i] += a->outsize) >= a->rsize) a->outidx[i] -= a->rsize;
+			outprbq (a->tags[i], a->outsize, &t0);
+			if (a->id >= 0) xprobe (i, PRB_MIX, t0, t1);		// inputs of the radio's mixers are wdsp channels
+		}
 	if (_InterlockedAnd (&a->slew.uflag, 1)) upslew   (a);
 	if (_InterlockedAnd (&a->slew.dflag, 1)) downslew (a);
-	LeaveCriticalSection(&a->cs_out);
 }
 
 void flush_mix_ring (AAMIX a, int stream)
@@ -466,6 +491,7 @@ void flush_mix_ring (AAMIX a, int stream)
 	a->unqueuedsamps[stream] = 0;
 	while (!WaitForSingleObject (a->Ready[stream], 1)) ;
 	flush_resample (a->rsmp[stream]);
+	flush_prbq (a->tags[stream], 0);
 }
 
 void close_mixer (AAMIX a)
@@ -476,16 +502,10 @@ void close_mixer (AAMIX a)
 	InterlockedBitTestAndReset (&a->slew.dflag, 0);
 	for (i = 0; i < a->ninputs; i++)
 		InterlockedBitTestAndReset(&a->accept[i], 0);	// shut the gates to prevent new infusions
-	Sleep(1);											// if a thread has just passed the gate, allow time to get cs_in and get through
-	for (i = 0; i < a->ninputs; i++)
-		EnterCriticalSection (&a->cs_in[i]);			// wait until the current infusions are all finished
-	EnterCriticalSection (&a->cs_out);					// block the mixer thread at the beginning of xaamix()
-	Sleep (25);											// wait for thread to arrive at the top of the main() loop
-	InterlockedBitTestAndReset(&a->run, 0);				// set a trap for the mixer thread
 	for (i = 0; i < a->ninputs; i++)
-		ReleaseSemaphore(a->Ready[i], 1, 0);			// be sure the mixer thread can pass WaitForMultipleObjects in main()
-	LeaveCriticalSection (&a->cs_out);					// let the thread pass to the trap in xaamix()
-	Sleep (2);											// wait for the mixer thread to die
+		while (_InterlockedAnd (&a->busy[i], 0xffffffff))
+			Sleep (0);									// wait until the current infusions are all finished
+	stop_mixthread (a);									// trap the mixer thread and wait for it to exit
 	for (i = 0; i < a->ninputs; i++)
 		flush_mix_ring (a, i);							// restore rings to pristine condition
 }
@@ -496,8 +516,6 @@ void open_mixer (AAMIX a)
 	InterlockedBitTestAndSet (&a->slew.uflag, 0);		// set a bit telling upslew to proceed (when there are samples flowing)
 	InterlockedBitTestAndSet(&a->run,0);				// remove the mixer thread trap
 	if (a->nactive) start_mixthread (a);				// start the mixer thread if there's anything to mix
-	for (i = a->ninputs - 1; i >= 0; i--)
-		LeaveCriticalSection (&a->cs_in[i]);			// enable xMixAudio() processing
 	for (i = a->ninputs - 1; i >= 0; i--)
 		if (_InterlockedAnd (&a->active, 0xffffffff) & (1 << i))
 			InterlockedBitTestAndSet(&a->accept[i], 0);	// open the xMixAudio() gates for active streams
@@ -600,11 +618,9 @@ void SetAAudioMixVolume (void* ptr, int id, double volume)
 	AAMIX a;
 	if (ptr == 0)	a = paamix[id];
 	else			a = (AAMIX)ptr;
-	EnterCriticalSection(&a->cs_out);
 	a->volume = volume;
 	for (i = 0; i < 32; i++)
-		a->tvol[i] = a->volume * a->vol[i];
-	LeaveCriticalSection(&a->cs_out);
+		a->tvol[i] = a->volume * a->vol[i];				// aligned doubles, the mixer picks up each one atomically
 }
 
 PORT
@@ -613,10 +629,8 @@ void SetAAudioMixVol (void* ptr, int id, int stream, double vol)
 	AAMIX a;
 	if (ptr == 0)	a = paamix[id];
 	else			a = (AAMIX)ptr;
-	EnterCriticalSection(&a->cs_out);
 	a->vol [stream] = vol;
 	a->tvol[stream] = a->vol[stream] * a->volume;
-	LeaveCriticalSection(&a->cs_out);
 }
 
 void SetAAudioRingInsize (void* ptr, int id, int size)
@@ -28,6 +28,7 @@ warren@wpratt.com
 #define _aamix_h
 
 #include "resample.h"
+#include "probe.h"
 
 typedef struct _aamix
 {
@@ -52,12 +53,14 @@ typedef struct _aamix
 	int unqueuedsamps[32];						// for each ring, number of complex samples not yet released for mixing
 	HANDLE Ready[32];							// semaphore handles, one per possible input
 	HANDLE Aready[32];							// semaphore handles for active inputs
-	CRITICAL_SECTION cs_in[32];					// cs to protect input process
-	CRITICAL_SECTION cs_out;					// cs to protect output process
+	volatile long busy[32];						// set while a producer is inside xMixAudio() for that input
+	volatile long threadrun;					// set while the mixer thread is alive
+	HANDLE Done;								// released by the mixer thread as it exits
 	RESAMPLE rsmp[32];							// array of resampler pointers
 	int inrate[32];								// sample rates of the inputs
 	int outrate;								// sample rate of the output
 	double* resampbuff[32];						// buffers for resampler outputs
+	PRBQ tags[32];								// arrival times of the samples in the rings
 	void (*Outbound)(int id, int nsamples, double* buff);	// function to call with output data
 	struct
 	{
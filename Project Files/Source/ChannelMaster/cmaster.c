@@ -295,6 +295,7 @@ void create_cmaster()
 void destroy_cmaster()
 {
 	int i;
+	destroy_replay();
 	destroy_router(0, 0);
 	destroy_cmasio();
 	destroy_aamix  (0, 0);
@@ -308,6 +309,19 @@ void destroy_cmaster()
 	}
 }
 
+// latency probe hops owned by the cmaster thread:  'tfex' is the time fexchange0() was entered, 'tret' the
+//	time it returned; the path ends at Outbound() id 'obid'
+void probe_cmaster (int stream, int channel, int obid, long long tfex, long long tret)
+{
+	long long t;
+	CMB a = pcm->pdbuff[stream];
+	probe_now (&t);
+	xprobe (channel, PRB_ROUTER, a->torigin, a->tread);
+	xprobe (channel, PRB_PIPE0, a->tread, tfex);
+	xprobe (channel, PRB_PIPE1, tret, t);
+	sumprobe (channel, obid);
+}
+
 PORT
 void xcmaster (int stream)
 {
@@ -316,6 +330,7 @@ void xcmaster (int stream)
 	switch (stype (stream))
 	{
 	int rx, tx, j, k;
+	long long tfex, tret;
 
 	case 0:  // standard receiver
 		rx = rxid (stream);
@@ -324,11 +339,14 @@ void xcmaster (int stream)
 		xnob (pcm->rcvr[rx].pnob);																// nb2
 		Spectrum0  (_InterlockedAnd (&pcm->rcvr[rx].run_pan, 0xffffffff), rx, 0, 0,				// panadapter 
 			pcm->in[stream]);
+		probe_now (&tfex);
 		for (j = 0; j < pcm->cmSubRCVR; j++)
 			fexchange0 (chid (stream, j), pcm->in[stream], pcm->rcvr[rx].audio[j], &error);		// dsp
+		probe_now (&tret);
 		xpipe (stream, 1, pcm->rcvr[rx].audio);
 		for (j = 0; j < pcm->cmSubRCVR; j++)
 		{
+			probe_cmaster (stream, chid (stream, j), 0, tfex, tret);								// latency probes
 			xMixAudio (0, 0, chid (stream, j), pcm->rcvr[rx].audio[j]);							// mix audio
 			for (k = 0; k < pcm->cmXMTR; k++)
 				xMixAudio (pcm->xmtr[k].pavoxmix, -1, chid (stream, j), pcm->rcvr[rx].audio[j]);// send audio to anti-vox mixer(s)
@@ -341,13 +359,16 @@ void xcmaster (int stream)
 		asioIN(pcm->in[stream]);
 		xpipe (stream, 0, pcm->in);
 		xdexp (tx);																				// vox-dexp
+		probe_now (&tfex);
 		fexchange0 (chid (stream, 0), pcm->in[stream], pcm->xmtr[tx].out[0], &error);			// dsp
+		probe_now (&tret);
 		xpipe (stream, 1, pcm->xmtr[tx].out);
 		// Spectrum0 (1, stream, 0, 0, pcm->xmtr[tx].out[0]);									// panadapter
 		xMixAudio (0, 0, chid (stream, 0), pcm->xmtr[tx].out[0]);								// mix monitor audio
 		// WriteAudio(30.0, 192000, 256, pcm->xmtr[0].out[0], 3);
 		xtxgain (pcm->xmtr[tx].pgain);															// Gain for Penelope & amp_protect
 		xeer (pcm->xmtr[tx].peer);																// EER transmission
+		probe_cmaster (stream, chid (stream, 0), 1, tfex, tret);								// latency probes
 		xilv(pcm->xmtr[tx].pilv, pcm->xmtr[tx].out);											// interleave EER, call Outbound()
 		break;
 
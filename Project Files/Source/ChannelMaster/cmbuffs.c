@@ -54,6 +54,7 @@ void create_cmbuffs (int id, int accept, int max_insize, int max_outsize, int ou
 	a->Sem_BuffReady = CreateSemaphore(0, 0, 1000, 0);
 	InitializeCriticalSectionAndSpinCount ( &a->csIN, 2500 );
 	InitializeCriticalSectionAndSpinCount ( &a->csOUT,  2500 );
+	a->tags = create_prbq ();
 	start_cmthread (id);
 }
 
@@ -71,6 +72,7 @@ void destroy_cmbuffs (int id)
 	DeleteCriticalSection (&a->csOUT);
 	DeleteCriticalSection (&a->csIN);
 	CloseHandle (a->Sem_BuffReady);
+	destroy_prbq (a->tags);
 	_aligned_free (a->r1_baseptr);
 	_aligned_free (a);
 }
@@ -83,18 +85,20 @@ void flush_cmbuffs (int id)
 	a->r1_outidx = 0;
 	a->r1_unqueuedsamps = 0;
 	while (!WaitForSingleObject (a->Sem_BuffReady, 1)) ;
+	flush_prbq (a->tags, 0);
 }
 
-PORT
-void Inbound (int id, int nsamples, double* in)
+void xinbound (CMB a, int nsamples, double* in)
 {
 	int n;
 	int first, second;
-	CMB a = pcm->pebuff[id];
+	long long t;
 
 	if (_InterlockedAnd (&a->accept, 1))
 	{
 		EnterCriticalSection (&a->csIN);
+		probe_now (&t);
+		inprbq (a->tags, nsamples, t);
 		if (nsamples > (a->r1_active_buffsize - a->r1_inidx))
 		{
 			first = a->r1_active_buffsize - a->r1_inidx;
@@ -120,6 +124,14 @@ void Inbound (int id, int nsamples, double* in)
 	}
 }
 
+PORT
+void Inbound (int id, int nsamples, double* in)
+{	// live input; dropped while the stream is being replayed from a file
+	CMB a = pcm->pebuff[id];
+	if (!_InterlockedAnd (&a->replay, 1))
+		xinbound (a, nsamples, in);
+}
+
 void cmdata (int id, double* out)
 {
 	int first, second;
@@ -145,6 +157,8 @@ void cmdata (int id, double* out)
 	memcpy (out + 2 * first, a->r1_baseptr,                    second * sizeof (complex));
 	if ((a->r1_outidx += a->r1_outsize) >= a->r1_active_buffsize)
 		a->r1_outidx -= a->r1_active_buffsize;
+	outprbq (a->tags, a->r1_outsize, &a->torigin);
+	probe_now (&a->tread);
 	LeaveCriticalSection (&a->csOUT);
 }
 
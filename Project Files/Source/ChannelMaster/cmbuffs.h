@@ -45,9 +45,13 @@ typedef struct _cmb
 	int   r1_unqueuedsamps;						// number of input samples not yet queued/released for execution
 	volatile long run;							// when 1, thread loops; when 0, thread terminates
 	volatile long accept;						// flag indicating whether accepting input data
+	volatile long replay;						// stream is fed by replay.c; live Inbound() calls are dropped
 	HANDLE Sem_BuffReady;						// count = number of output-sized buffers queued for processing
 	CRITICAL_SECTION csOUT;						// used to block output while parameters are updated or buffers flushed
 	CRITICAL_SECTION csIN;						// used to block input while parameters are updated or buffers flushed
+	PRBQ tags;									// arrival times of the samples in the ring
+	long long torigin;							// arrival time of the buffer last read by cmdata()
+	long long tread;							// time it was read
 } cmb, *CMB;
 
 extern void create_cmbuffs (int id, int accept, int max_insize, int max_outsize, int outsize);
@@ -56,6 +60,8 @@ extern void destroy_cmbuffs (int id);
 
 extern void flush_cmbuffs (int id);
 
+extern void xinbound (CMB a, int nsamples, double* in);
+
 extern __declspec (dllexport) void Inbound (int id, int nsamples, double* in);
 
 extern void cmdata (int id, double* out);
@@ -40,6 +40,8 @@ warren@wpratt.com
 #include "ilv.h"
 #include "ivac.h"
 #include "pipe.h"
+#include "recorder.h"
+#include "replay.h"
 #include "ring.h"
 #include "router.h"
 #include "sync.h"
@@ -90,6 +90,8 @@ PORT void create_ivac(
 	a->swapIQout = 0;
 	a->exclusive_in = 0;
 	a->exclusive_out = 0;
+	a->sample_format = 0;
+	a->native_format = paFloat64;
 	create_resamps(a);
 	{
 		int inrate[2] = { a->audio_rate, a->txmon_rate };
@@ -155,6 +157,105 @@ void xvac_out(int id, int nsamples, double* buff)
 	// if (id == 0) WriteAudio (120.0, 48000, a->audio_size, buff, 3);
 }
 
+// conversions between the stream's native format and the doubles used by rmatch; 'n' is the number of values
+
+void cvt_f32_f64 (int n, const float* in, double* out)
+{
+	int i;
+	__m128 x;
+	const int n4 = n & ~3;
+	for (i = 0; i < n4; i += 4)
+	{
+		x = _mm_loadu_ps (&in[i]);
+		_mm_storeu_pd (&out[i + 0], _mm_cvtps_pd (x));
+		_mm_storeu_pd (&out[i + 2], _mm_cvtps_pd (_mm_movehl_ps (x, x)));
+	}
+	for (; i < n; i++)
+		out[i] = (double)in[i];
+}
+
+void cvt_f64_f32 (int n, const double* in, float* out)
+{
+	int i;
+	const int n4 = n & ~3;
+	for (i = 0; i < n4; i += 4)
+		_mm_storeu_ps (&out[i], _mm_movelh_ps (_mm_cvtpd_ps (_mm_loadu_pd (&in[i + 0])), _mm_cvtpd_ps (_mm_loadu_pd (&in[i + 2]))));
+	for (; i < n; i++)
+		out[i] = (float)in[i];
+}
+
+void cvt_i32_f64 (int n, const int* in, double* out)
+{
+	int i;
+	__m128i x;
+	const __m128d k = _mm_set1_pd (1.0 / 2147483648.0);
+	const int n4 = n & ~3;
+	for (i = 0; i < n4; i += 4)
+	{
+		x = _mm_loadu_si128 ((const __m128i *)&in[i]);
+		_mm_storeu_pd (&out[i + 0], _mm_mul_pd (k, _mm_cvtepi32_pd (x)));
+		_mm_storeu_pd (&out[i + 2], _mm_mul_pd (k, _mm_cvtepi32_pd (_mm_shuffle_epi32 (x, 0x0e))));
+	}
+	for (; i < n; i++)
+		out[i] = (1.0 / 2147483648.0) * (double)in[i];
+}
+
+void cvt_f64_i32 (int n, const double* in, int* out)
+{	// clipped to full scale; an out-of-range conversion would otherwise wrap to the negative limit
+	int i;
+	double x;
+	const __m128d k  = _mm_set1_pd (2147483648.0);
+	const __m128d hi = _mm_set1_pd (2147483647.0 / 2147483648.0);
+	const __m128d lo = _mm_set1_pd (-1.0);
+	const int n4 = n & ~3;
+	for (i = 0; i < n4; i += 4)
+		_mm_storeu_si128 ((__m128i *)&out[i], _mm_unpacklo_epi64 (
+			_mm_cvtpd_epi32 (_mm_mul_pd (k, _mm_max_pd (lo, _mm_min_pd (hi, _mm_loadu_pd (&in[i + 0]))))),
+			_mm_cvtpd_epi32 (_mm_mul_pd (k, _mm_max_pd (lo, _mm_min_pd (hi, _mm_loadu_pd (&in[i + 2])))))));
+	for (; i < n; i++)
+	{
+		x = in[i] < -1.0 ? -1.0 : (in[i] > 2147483647.0 / 2147483648.0 ? 2147483647.0 / 2147483648.0 : in[i]);
+		out[i] = _mm_cvtsd_si32 (_mm_set_sd (2147483648.0 * x));	// rounds like the vector body
+	}
+}
+
+void reset_cbstats (IVAC a)
+{
+	a->cb_last = 0.0;
+	a->cb_count = 0;
+	a->cb_int_sum = 0.0;
+	a->cb_int_min = 0.0;
+	a->cb_int_max = 0.0;
+	a->cb_exec_sum = 0.0;
+	a->cb_exec_max = 0.0;
+	memset (a->cb_xruns, 0, sizeof (a->cb_xruns));
+}
+
+void xcbstats (IVAC a, double t0, double t1, PaStreamCallbackFlags statusFlags)
+{
+	double dt;
+	if (a->cb_reset)
+	{
+		a->cb_reset = 0;
+		reset_cbstats (a);
+	}
+	if (statusFlags & paInputUnderflow)		a->cb_xruns[0]++;
+	if (statusFlags & paInputOverflow)		a->cb_xruns[1]++;
+	if (statusFlags & paOutputUnderflow)	a->cb_xruns[2]++;
+	if (statusFlags & paOutputOverflow)		a->cb_xruns[3]++;
+	if (a->cb_last > 0.0)
+	{
+		dt = t0 - a->cb_last;
+		a->cb_int_sum += dt;
+		if ((a->cb_count == 0) || (dt < a->cb_int_min)) a->cb_int_min = dt;
+		if (dt > a->cb_int_max) a->cb_int_max = dt;
+		a->cb_exec_sum += t1 - t0;
+		if (t1 - t0 > a->cb_exec_max) a->cb_exec_max = t1 - t0;
+		a->cb_count++;
+	}
+	a->cb_last = t0;
+}
+
 int CallbackIVAC(const void *input,
 	void *output,
 	unsigned long frameCount,
@@ -166,25 +267,96 @@ int CallbackIVAC(const void *input,
 	IVAC a = pvac[id];
 	double* out_ptr = (double*)output;
 	double* in_ptr = (double*)input;
+	double t0 = Pa_GetStreamTime (a->Stream);
 	(void)timeInfo;
-	(void)statusFlags;
 
 	if (!a->run) return 0;
+	switch (a->native_format)
+	{
+	case paFloat32:
+		cvt_f32_f64 (2 * a->vac_size, (const float *)input, a->inbuff);
+		in_ptr = a->inbuff;
+		out_ptr = a->outbuff;
+		break;
+	case paInt32:
+		cvt_i32_f64 (2 * a->vac_size, (const int *)input, a->inbuff);
+		in_ptr = a->inbuff;
+		out_ptr = a->outbuff;
+		break;
+	}
 	xrmatchIN (a->rmatchIN, in_ptr);	// MIC data from VAC
 	xrmatchOUT(a->rmatchOUT, out_ptr);	// audio or I-Q data to VAC
 	// if (id == 0)  WriteAudio (120.0, 48000, a->vac_size, out_ptr, 3); //
 	if (a->iq_type && a->swapIQout)
 		for (int i = 0, j = 1; i < a->vac_size; i++, j+=2)
 			out_ptr[j] = -out_ptr[j];
+	switch (a->native_format)
+	{
+	case paFloat32:
+		cvt_f64_f32 (2 * a->vac_size, a->outbuff, (float *)output);
+		break;
+	case paInt32:
+		cvt_f64_i32 (2 * a->vac_size, a->outbuff, (int *)output);
+		break;
+	}
+	xcbstats (a, t0, Pa_GetStreamTime (a->Stream), statusFlags);
 	return 0;
 }
 
+PaSampleFormat negotiate_format (IVAC a, PaHostApiTypeId type)
+{	// prefer the device's own format so that portaudio's converters are bypassed; float64 is the fallback
+	int i, n = 0;
+	PaSampleFormat fmt[2];
+	switch (a->sample_format)
+	{
+	case 1:
+		fmt[n++] = paFloat32;
+		break;
+	case 2:
+		fmt[n++] = paInt32;
+		break;
+	case 3:
+		break;
+	default:
+		// ALSA hardware and exclusive-mode WASAPI are normally integer; JACK and shared WASAPI are float
+		if ((type == paALSA) || ((type == paWASAPI) && (a->exclusive_in || a->exclusive_out)))
+		{
+			fmt[n++] = paInt32;
+			fmt[n++] = paFloat32;
+		}
+		else
+		{
+			fmt[n++] = paFloat32;
+			fmt[n++] = paInt32;
+		}
+		break;
+	}
+	for (i = 0; i < n; i++)
+	{
+		a->inParam.sampleFormat = a->outParam.sampleFormat = fmt[i];
+		if (Pa_IsFormatSupported (&a->inParam, &a->outParam, a->vac_rate) == paFormatIsSupported)
+			return fmt[i];
+	}
+	a->inParam.sampleFormat = a->outParam.sampleFormat = paFloat64;
+	return paFloat64;
+}
+
+void free_vacbuffs (IVAC a)
+{
+	if (a->inbuff)  _aligned_free (a->inbuff);
+	if (a->outbuff) _aligned_free (a->outbuff);
+	a->inbuff = a->outbuff = NULL;
+	a->native_format = paFloat64;
+}
+
 PORT int StartAudioIVAC(int id)
 {
 	IVAC a = pvac[id];
 	int error = 0;
 	int in_dev = Pa_HostApiDeviceIndexToDeviceIndex(a->host_api_index, a->input_dev_index);
 	int out_dev = Pa_HostApiDeviceIndexToDeviceIndex(a->host_api_index, a->output_dev_index);
+	const PaHostApiInfo* hostInfo = Pa_GetHostApiInfo(a->host_api_index);
+	PaHostApiTypeId host_type = hostInfo ? hostInfo->type : paInDevelopment;
 
 	a->inParam.device = in_dev;
 	a->inParam.channelCount = 2;
@@ -239,6 +411,15 @@ PORT int StartAudioIVAC(int id)
 	}
 	//
 
+	a->native_format = negotiate_format (a, host_type);
+	if (a->native_format != paFloat64)
+	{
+		a->inbuff  = (double *) malloc0 (a->vac_size * sizeof (complex));
+		a->outbuff = (double *) malloc0 (a->vac_size * sizeof (complex));
+	}
+	a->cb_reset = 0;
+	reset_cbstats (a);
+
 	error = Pa_OpenStream(&a->Stream,
 		&a->inParam,
 		&a->outParam,
@@ -248,11 +429,21 @@ PORT int StartAudioIVAC(int id)
 		CallbackIVAC,
 		(void*)id);	// pass 'id' as userData
 
-	if (error != 0) return -1;
+	if (error != 0)
+	{
+		free_vacbuffs (a);
+		return -1;
+	}
 
 	error = Pa_StartStream(a->Stream);
 
-	if (error != 0) return -1;
+	if (error != 0)
+	{
+		Pa_CloseStream(a->Stream);
+		a->Stream = NULL;
+		free_vacbuffs (a);
+		return -1;
+	}
 
 	return 1;
 }
@@ -267,6 +458,8 @@ PORT void StopAudioIVAC(int id)
 {
 	IVAC a = pvac[id];
 	Pa_CloseStream(a->Stream);
+	a->Stream = NULL;
+	free_vacbuffs (a);
 }
 
 PORT void SetIVACrun(int id, int run)
@@ -574,6 +767,42 @@ void getIVACdiags (int id, int type, int* underflows, int* overflows, double* va
 	getRMatchDiags (a, underflows, overflows, var, ringsize, nring);
 }
 
+PORT
+void setIVACTelemetry (int id, int type, int run, int size)
+{
+	// type:  0 - From VAC; 1 - To VAC
+	void* a;
+	if (type == 0)
+		a = pvac[id]->rmatchOUT;
+	else
+		a = pvac[id]->rmatchIN;
+	setRMatchTelemetry (a, run, size);
+}
+
+PORT
+void getIVACTelemetry (int id, int type, int max, int* count, int* lost, double* t, int* nring, double* var, int* flags)
+{
+	// type:  0 - From VAC; 1 - To VAC
+	void* a;
+	if (type == 0)
+		a = pvac[id]->rmatchOUT;
+	else
+		a = pvac[id]->rmatchIN;
+	getRMatchTelemetry (a, max, count, lost, t, nring, var, flags);
+}
+
+PORT
+void dumpIVACTelemetry (int id, int type, const char* filename, int binary, int* count)
+{
+	// type:  0 - From VAC; 1 - To VAC
+	void* a;
+	if (type == 0)
+		a = pvac[id]->rmatchOUT;
+	else
+		a = pvac[id]->rmatchIN;
+	dumpRMatchTelemetry (a, filename, binary, count);
+}
+
 PORT
 void forceIVACvar (int id, int type, int force, double fvar)
 {
@@ -697,6 +926,17 @@ PORT void SetIVACFFAlpha(int id, int type, double ff_alpha)
 //		a = b->rmatchIN;
 //	setRMatchVar(a, var);
 //}
+PORT void SetIVACInterp(int id, int type, int interp)
+{
+	IVAC b = pvac[id];
+	// type = 0 out, 1 = in
+	void* a;
+	if (type == 0)
+		a = b->rmatchOUT;
+	else
+		a = b->rmatchIN;
+	setRMatchInterp(a, interp);
+}
 PORT
 void GetIVACControlFlag(int id, int type, int* control_flag)
 {
@@ -751,4 +991,53 @@ void SetIVACExclusiveIn(int id, int exclusive_in)
 	IVAC a = pvac[id];
 	a->exclusive_in = exclusive_in;
 }
-//
\ No newline at end of file
+//
+
+PORT
+void SetIVACSampleFormat(int id, int format)
+{	// takes effect at the next StartAudioIVAC(); 0 = negotiate, 1 = float32, 2 = int32, 3 = float64
+	IVAC a = pvac[id];
+	a->sample_format = format;
+}
+
+PORT
+void GetIVACSampleFormat(int id, int* format)
+{	// format of the running stream, as for SetIVACSampleFormat()
+	IVAC a = pvac[id];
+	switch (a->native_format)
+	{
+	case paFloat32:
+		*format = 1;
+		break;
+	case paInt32:
+		*format = 2;
+		break;
+	default:
+		*format = 3;
+		break;
+	}
+}
+
+PORT
+void getIVACCallbackStats (int id, int* count, double* int_mean, double* int_min, double* int_max, 
+	double* exec_mean, double* exec_max, int* xruns, double* cpu_load)
+{
+	// times in milliseconds; xruns[4]:  input underflow, input overflow, output underflow, output overflow
+	IVAC a = pvac[id];
+	int n = a->cb_count;
+	*count = n;
+	*int_mean  = n ? 1.0e+03 * a->cb_int_sum / n : 0.0;
+	*int_min   = 1.0e+03 * a->cb_int_min;
+	*int_max   = 1.0e+03 * a->cb_int_max;
+	*exec_mean = n ? 1.0e+03 * a->cb_exec_sum / n : 0.0;
+	*exec_max  = 1.0e+03 * a->cb_exec_max;
+	memcpy (xruns, a->cb_xruns, sizeof (a->cb_xruns));
+	*cpu_load = a->Stream ? Pa_GetStreamCpuLoad (a->Stream) : 0.0;
+}
+
+PORT
+void resetIVACCallbackStats (int id)
+{
+	IVAC a = pvac[id];
+	a->cb_reset = 1;
+}
@@ -88,6 +88,21 @@ typedef struct _ivac
 
 	int exclusive_in;				// only use with wasapi right now
 	int exclusive_out;				// only use with wasapi right now
+
+	int sample_format;				// 0 = negotiate (float32 or int32), 1 = float32, 2 = int32, 3 = float64
+	PaSampleFormat native_format;	// format the open stream runs in
+	double* inbuff;					// VAC input converted to double, unless the stream is paFloat64
+	double* outbuff;				// VAC output before conversion, unless the stream is paFloat64
+
+	volatile int cb_reset;			// set to restart the callback statistics
+	double cb_last;					// stream time at the start of the previous callback, seconds
+	int cb_count;					// number of callbacks timed
+	double cb_int_sum;				// interval between callbacks, seconds
+	double cb_int_min;
+	double cb_int_max;
+	double cb_exec_sum;				// time spent in the callback, seconds
+	double cb_exec_max;
+	int cb_xruns[4];				// input underflow, input overflow, output underflow, output overflow
 } ivac, *IVAC;
 
 void combinebuff (int n, double* a, double* combined);
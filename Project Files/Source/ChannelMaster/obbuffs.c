@@ -62,6 +62,7 @@ void create_obbuffs (int id, int accept, int max_insize, int outsize)
 	InitializeCriticalSectionAndSpinCount ( &a->csIN, 2500 );
 	InitializeCriticalSectionAndSpinCount ( &a->csOUT,  2500 );
 	a->out = (double *) calloc (obMAXSIZE, sizeof (complex));
+	a->tags = create_prbq ();
 	start_obthread (id);
 }
 
@@ -80,6 +81,7 @@ void destroy_obbuffs (int id)
 	DeleteCriticalSection (&a->csOUT);
 	DeleteCriticalSection (&a->csIN);
 	CloseHandle (a->Sem_BuffReady);
+	destroy_prbq (a->tags);
 	free (a->out);
 	free (a->r1_baseptr);
 	free (a);
@@ -93,6 +95,7 @@ void flush_obbuffs (int id)
 	a->r1_outidx = 0;
 	a->r1_unqueuedsamps = 0;
 	while (!WaitForSingleObject (a->Sem_BuffReady, 1)) ;
+	flush_prbq (a->tags, 0);
 }
 
 PORT
@@ -100,10 +103,13 @@ void OutBound (int id, int nsamples, double* in)
 {
 	int n;
 	int first, second;
+	long long t;
 	OBB a = obp.pebuff[id];
 	if (_InterlockedAnd (&a->accept, 1))
 	{
 		EnterCriticalSection (&a->csIN);
+		probe_now (&t);
+		inprbq (a->tags, nsamples, t);
 		if (nsamples > (a->r1_active_buffsize - a->r1_inidx))
 		{
 			first = a->r1_active_buffsize - a->r1_inidx;
@@ -148,6 +154,7 @@ void obdata (int id, double* out)
 	memcpy (out + 2 * first, a->r1_baseptr,                    second * sizeof (complex));
 	if ((a->r1_outidx += a->r1_outsize) >= a->r1_active_buffsize)
 		a->r1_outidx -= a->r1_active_buffsize;
+	outprbq (a->tags, a->r1_outsize, &a->torigin);
 }
 
 void ob_main (void *pargs)
@@ -159,6 +166,7 @@ void ob_main (void *pargs)
 
 	int id = (int)pargs;
 	OBB a = obp.pdbuff[id];
+	long long t;
 	
 	while (_InterlockedAnd (&a->run, 1))
 	{
@@ -167,6 +175,8 @@ void ob_main (void *pargs)
 		LeaveCriticalSection (&a->csOUT);
 		obdata (id, a->out);
 		sendOutbound(id, a->out);
+		probe_now (&t);
+		xprobeob (id, a->torigin, t);
 		// if (id == 0) WriteAudio(15.0, 48000, 126, a->out, 3);
 	}
 	_endthread();
@@ -31,6 +31,7 @@ warren@wpratt.com
 #include <time.h>
 #include <avrt.h>
 #include "cmUtilities.h"
+#include "probe.h"
 
 typedef double complex[2];
 #define PORT							__declspec( dllexport )
@@ -60,6 +61,8 @@ typedef struct _obb
 	CRITICAL_SECTION csOUT;						// used to block output while parameters are updated or buffers flushed
 	CRITICAL_SECTION csIN;						// used to block input while parameters are updated or buffers flushed
 	double* out;
+	PRBQ tags;									// arrival times of the samples in the ring
+	long long torigin;							// arrival time of the buffer last read by obdata()
 } obb, *OBB;
 
 extern void create_obbuffs (int id, int accept, int max_insize, int outsize);
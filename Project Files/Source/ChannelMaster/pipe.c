@@ -118,6 +118,7 @@ void create_pipe()
 void destroy_pipe()
 {
 	int i;
+	destroy_recorders();
 	destroy_spc0();
 	for (i = 0; i < pcm->cmRCVR; i++)
 	{
@@ -239,6 +240,7 @@ void xpipe (int stream, int pos, double** buffs)
 		xnob (ppip->spc0[sp0].pnob);								// nb2
 		Spectrum0 (_InterlockedAnd (&pip.rcvr[0].top_pan3_run, 0xffffffff), 0, 2, 0, buff);// stitched pan
 	}
+	xrecorder (stream, pos, buffs);													// native recorders
 }
 
 PORT
@@ -0,0 +1,334 @@
+/*  recorder.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+#include "cmcomm.h"
+
+/********************************************************************************************************
+*																										*
+*										Streaming IQ / Audio Recorder									*
+*																										*
+********************************************************************************************************/
+
+// Records any xpipe() tap to disk without blocking the DSP path.  The tap converts its samples into a set
+// of preallocated blocks; each full block is handed to a writer thread, which does all the file I/O.  If
+// the writer falls behind so far that no free block remains, the tap drops samples and counts them rather
+// than waiting.  WAV sizes are limited to 4 GB; use REC_RAW for longer full-band recordings.
+
+rec recs[cmMAXrec];
+volatile long nrecording;
+
+void tap_recorder (int stream, int pos, double** buffs, double** data, int* size, int* rate)
+{
+	int st = stype (stream);
+	*data = 0;
+	if (pos == 0)
+	{
+		*data = buffs[stream];
+		*size = pcm->xcm_insize[stream];
+		*rate = pcm->xcm_inrate[stream];
+	}
+	else if (st == 0)										// receiver audio, base sub-receiver
+	{
+		*data = buffs[0];
+		*size = pcm->rcvr[rxid (stream)].ch_outsize;
+		*rate = pcm->rcvr[rxid (stream)].ch_outrate;
+	}
+	else if (st == 1)										// transmitter I/Q
+	{
+		*data = buffs[0];
+		*size = pcm->xmtr[txid (stream)].ch_outsize;
+		*rate = pcm->xmtr[txid (stream)].ch_outrate;
+	}
+}
+
+void convert_recorder (int format, int n, double* in, char* out)
+{	// n complex samples
+	int i, v;
+	double x;
+	short* s = (short *)out;
+	float* f = (float *)out;
+	switch (format)
+	{
+	case REC_INT16:
+		for (i = 0; i < 2 * n; i++)
+		{
+			x = floor (32767.0 * in[i] + 0.5);
+			if (x > 32767.0) x = 32767.0;
+			if (x < -32768.0) x = -32768.0;
+			s[i] = (short)x;
+		}
+		break;
+	case REC_INT24:
+		for (i = 0; i < 2 * n; i++)
+		{
+			x = floor (8388607.0 * in[i] + 0.5);
+			if (x > 8388607.0) x = 8388607.0;
+			if (x < -8388608.0) x = -8388608.0;
+			v = (int)x;
+			out[3 * i + 0] = (char)(v & 0xff);
+			out[3 * i + 1] = (char)((v >> 8) & 0xff);
+			out[3 * i + 2] = (char)((v >> 16) & 0xff);
+		}
+		break;
+	default:
+		for (i = 0; i < 2 * n; i++)
+			f[i] = (float)in[i];
+		break;
+	}
+}
+
+void write_header (REC a)
+{	// 44-byte PCM header; float uses WAVE_FORMAT_EXTENSIBLE and a 'fact' chunk, 80 bytes.  The sizes are
+	// filled in when the recording stops.
+	unsigned char h[80];
+	int flt = a->format == REC_FLOAT32;
+	int hlen = flt ? 80 : 44;
+	unsigned int riff = (unsigned int)(a->bytes > 0xffffffffLL - (hlen - 8) ? 0xffffffffLL : a->bytes + (hlen - 8));
+	unsigned int data = (unsigned int)(a->bytes > 0xffffffffLL - 36 ? 0xffffffffLL - 36 : a->bytes);
+	unsigned int frames = (unsigned int)(a->bytes / a->bps > 0xffffffffLL ? 0xffffffffLL : a->bytes / a->bps);
+	unsigned short tag = flt ? 0xfffe : 1;
+	unsigned short channels = 2;
+	unsigned short align = (unsigned short)a->bps;
+	unsigned short bits = (unsigned short)(8 * a->bps / 2);
+	unsigned int fmtsize = flt ? 40 : 16;
+	unsigned int rate = a->rate;
+	unsigned int byterate = a->rate * a->bps;
+	unsigned short cbsize = 22;
+	unsigned int chmask = 0x3;						// front left, front right
+	unsigned int factsize = 4;
+	static const unsigned char subfloat[16] =		// KSDATAFORMAT_SUBTYPE_IEEE_FLOAT
+		{ 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 };
+	unsigned char* p = h + 36;
+	memcpy (h +  0, "RIFF", 4);
+	memcpy (h +  4, &riff, 4);
+	memcpy (h +  8, "WAVEfmt ", 8);
+	memcpy (h + 16, &fmtsize, 4);
+	memcpy (h + 20, &tag, 2);
+	memcpy (h + 22, &channels, 2);
+	memcpy (h + 24, &rate, 4);
+	memcpy (h + 28, &byterate, 4);
+	memcpy (h + 32, &align, 2);
+	memcpy (h + 34, &bits, 2);
+	if (flt)
+	{
+		memcpy (h + 36, &cbsize, 2);
+		memcpy (h + 38, &bits, 2);					// valid bits per sample
+		memcpy (h + 40, &chmask, 4);
+		memcpy (h + 44, subfloat, 16);
+		memcpy (h + 60, "fact", 4);
+		memcpy (h + 64, &factsize, 4);
+		memcpy (h + 68, &frames, 4);
+		p = h + 72;
+	}
+	memcpy (p + 0, "data", 4);
+	memcpy (p + 4, &data, 4);
+	fseek (a->file, 0, SEEK_SET);
+	fwrite (h, 1, hlen, a->file);
+}
+
+void publish_recorder (REC a)
+{
+	a->bsize[a->head] = a->fill;
+	if (++a->head == recNBLOCKS) a->head = 0;
+	a->fill = 0;
+	_InterlockedIncrement (&a->nfull);
+	ReleaseSemaphore (a->Sem_Ready, 1, 0);
+}
+
+void rec_main (void* pargs)
+{
+	REC a = (REC)pargs;
+	SetThreadPriority (GetCurrentThread (), THREAD_PRIORITY_ABOVE_NORMAL);
+	while (1)
+	{
+		WaitForSingleObject (a->Sem_Ready, INFINITE);
+		if (!_InterlockedAnd (&a->nfull, 0xffffffff))
+		{
+			if (_InterlockedAnd (&a->stop, 1)) break;
+			continue;
+		}
+		if (fwrite (a->block[a->tail], 1, a->bsize[a->tail], a->file) != (size_t)a->bsize[a->tail])
+			InterlockedExchange (&a->error, 1);
+		a->bytes += a->bsize[a->tail];
+		if (++a->tail == recNBLOCKS) a->tail = 0;
+		_InterlockedDecrement (&a->nfull);
+	}
+	ReleaseSemaphore (a->Done, 1, 0);
+	_endthread ();
+}
+
+void xrec (REC a, double* data, int n)
+{
+	int i = 0, k;
+	while (i < n)
+	{
+		if (a->fill == 0 && _InterlockedAnd (&a->nfull, 0xffffffff) == recNBLOCKS)
+		{	// no free block:  drop the remainder of this buffer
+			_InterlockedExchangeAdd (&a->overruns, n - i);
+			return;
+		}
+		if ((k = (a->blocksize - a->fill) / a->bps) > n - i) k = n - i;
+		convert_recorder (a->format, k, data + 2 * i, a->block[a->head] + a->fill);
+		a->fill += k * a->bps;
+		i += k;
+		if (a->fill == a->blocksize) publish_recorder (a);
+	}
+}
+
+// called at the end of xpipe() for each stream and position
+void xrecorder (int stream, int pos, double** buffs)
+{
+	int i, size, rate;
+	double* data;
+	REC a;
+	if (!_InterlockedAnd (&nrecording, 0xffffffff)) return;
+	for (i = 0; i < cmMAXrec; i++)
+	{
+		a = &recs[i];
+		_InterlockedIncrement (&a->busy);
+		if (_InterlockedAnd (&a->run, 1) && a->stream == stream && a->pos == pos)
+		{
+			tap_recorder (stream, pos, buffs, &data, &size, &rate);
+			if (data) xrec (a, data, size);
+		}
+		_InterlockedDecrement (&a->busy);
+	}
+}
+
+void destroy_recorders (void)
+{
+	int i;
+	for (i = 0; i < cmMAXrec; i++)
+		StopRecorder (i);
+}
+
+/********************************************************************************************************
+*																										*
+*											Recorder Properties											*
+*																										*
+********************************************************************************************************/
+
+// 'error' returns 0 on success, -1 if 'id', 'stream' or 'pos' is invalid or the recorder is already
+//	running or 'format' is not one of REC_INT16 .. REC_RAW, -2 if the file cannot be created, -3 if
+//	'filename' is too long for the REC_RAW sidecar name
+PORT
+void StartRecorder (int id, int stream, int pos, int format, const char* filename, int* error)
+{
+	int i, size, rate;
+	double* data;
+	char meta[MAX_PATH + 8];
+	FILE* mfile;
+	REC a;
+	*error = -1;
+	if (id < 0 || id >= cmMAXrec || stream < 0 || stream >= pcm->cmSTREAM || pos < 0 || pos > 1) return;
+	if (format < REC_INT16 || format > REC_RAW) return;
+	a = &recs[id];
+	if (_InterlockedAnd (&a->run, 1)) return;
+	tap_recorder (stream, pos, pcm->in, &data, &size, &rate);
+	if (!data) return;
+	*error = -3;
+	if (format == REC_RAW && strlen (filename) + sizeof (".txt") > sizeof (meta)) return;
+	*error = -2;
+	if (!(a->file = fopen (filename, "wb"))) return;
+	setvbuf (a->file, 0, _IONBF, 0);				// blocks are large; skip the stdio copy
+	a->stream = stream;
+	a->pos = pos;
+	a->format = format;
+	a->rate = rate;
+	switch (format)
+	{
+	case REC_INT16:	a->bps = 4; break;
+	case REC_INT24:	a->bps = 6; break;
+	default:		a->bps = 8; break;
+	}
+	a->blocksize = a->bps * (int)(recBLOCKTIME * rate);
+	if (a->blocksize < a->bps * size) a->blocksize = a->bps * size;
+	for (i = 0; i < recNBLOCKS; i++)
+		a->block[i] = (char *) malloc0 (a->blocksize);
+	a->head = a->fill = a->tail = 0;
+	a->nfull = 0;
+	a->overruns = 0;
+	a->stop = 0;
+	a->error = 0;
+	a->bytes = 0;
+	if (format == REC_RAW)
+	{
+		sprintf_s (meta, sizeof (meta), "%s.txt", filename);
+		if (mfile = fopen (meta, "w"))
+		{
+			fprintf (mfile, "format=float32le\nchannels=2\nrate=%d\nstream=%d\npos=%d\n", rate, stream, pos);
+			fclose (mfile);
+		}
+	}
+	else
+		write_header (a);
+	a->Sem_Ready = CreateSemaphore (0, 0, recNBLOCKS + 1, 0);
+	a->Done = CreateSemaphore (0, 0, 1, 0);
+	_beginthread (rec_main, 0, (void *)a);
+	InterlockedBitTestAndSet (&a->run, 0);
+	_InterlockedIncrement (&nrecording);
+	*error = 0;
+}
+
+PORT
+void StopRecorder (int id)
+{
+	int i;
+	REC a;
+	if (id < 0 || id >= cmMAXrec) return;
+	a = &recs[id];
+	if (!_InterlockedAnd (&a->run, 1)) return;
+	InterlockedBitTestAndReset (&a->run, 0);		// close the tap
+	while (_InterlockedAnd (&a->busy, 0xffffffff))
+		Sleep (0);									// wait for a tap already in progress
+	_InterlockedDecrement (&nrecording);
+	if (a->fill) publish_recorder (a);				// partial last block
+	InterlockedBitTestAndSet (&a->stop, 0);
+	ReleaseSemaphore (a->Sem_Ready, 1, 0);
+	WaitForSingleObject (a->Done, INFINITE);		// writer drains the blocks and exits
+	if (a->format != REC_RAW) write_header (a);
+	fclose (a->file);
+	CloseHandle (a->Done);
+	CloseHandle (a->Sem_Ready);
+	for (i = 0; i < recNBLOCKS; i++)
+		_aligned_free (a->block[i]);
+}
+
+PORT
+void GetRecorderStatus (int id, int* running, double* seconds, int* overruns, int* error)
+{
+	REC a;
+	*running = 0;
+	*seconds = 0.0;
+	*overruns = 0;
+	*error = 0;
+	if (id < 0 || id >= cmMAXrec) return;
+	a = &recs[id];											// the last recording's figures remain after it stops
+	*running = _InterlockedAnd (&a->run, 1);
+	if (a->bps && a->rate) *seconds = (double)a->bytes / ((double)a->bps * a->rate);
+	*overruns = _InterlockedAnd (&a->overruns, 0xffffffff);
+	*error = _InterlockedAnd (&a->error, 0xffffffff);
+}
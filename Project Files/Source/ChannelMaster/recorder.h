@@ -0,0 +1,77 @@
+/*  recorder.h
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+#ifndef _recorder_h
+#define _recorder_h
+
+#define cmMAXrec		(8)							// maximum number of simultaneous recorders
+#define recNBLOCKS		(16)						// preallocated blocks per recorder
+#define recBLOCKTIME	(0.1)						// seconds of samples per block
+
+enum _recformat
+{
+	REC_INT16,										// WAV, 16-bit PCM
+	REC_INT24,										// WAV, 24-bit PCM
+	REC_FLOAT32,									// WAV, 32-bit IEEE float
+	REC_RAW											// headerless 32-bit float, metadata in '<filename>.txt'
+};
+
+typedef struct _rec
+{
+	volatile long run;								// the tap accepts samples
+	volatile long busy;								// set while the tap is inside xrecorder()
+	int stream;										// xpipe() stream to record
+	int pos;										// xpipe() position, 0 = input, 1 = channel output
+	int format;
+	int rate;										// sample rate, for the header
+	int bps;										// bytes per complex sample
+	int blocksize;									// bytes per block
+	char* block[recNBLOCKS];
+	int bsize[recNBLOCKS];							// bytes in each published block
+	int head;										// block being filled by the tap
+	int fill;										// bytes in block 'head'
+	int tail;										// next block for the writer
+	volatile long nfull;							// blocks published but not yet written
+	volatile long overruns;							// samples dropped because the writer fell behind
+	volatile long stop;								// writer exits when all blocks are written
+	HANDLE Sem_Ready;								// one count per published block, plus one to stop
+	HANDLE Done;									// released by the writer as it exits
+	FILE* file;
+	long long bytes;								// sample bytes written
+	volatile long error;							// a write failed
+} rec, *REC;
+
+extern void xrecorder (int stream, int pos, double** buffs);
+
+extern void destroy_recorders (void);
+
+extern __declspec (dllexport) void StartRecorder (int id, int stream, int pos, int format, const char* filename, int* error);
+
+extern __declspec (dllexport) void StopRecorder (int id);
+
+extern __declspec (dllexport) void GetRecorderStatus (int id, int* running, double* seconds, int* overruns, int* error);
+
+#endif
@@ -0,0 +1,358 @@
+/*  replay.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+#include "cmcomm.h"
+
+/********************************************************************************************************
+*																										*
+*											  IQ File Replay											*
+*																										*
+********************************************************************************************************/
+
+// Feeds recorded files (see recorder.c) into cmaster streams in place of the radio; while a replay runs,
+// live Inbound() calls for the replayed streams are dropped.
+// Files are memory-mapped; one thread serves all sources, always advancing the one furthest behind in
+// time so that multiple DDCs stay in step.  In real-time mode injection is paced at the files' sample
+// rates.  Otherwise each injection waits only until the stream's input ring has room, so the receive
+// chain runs as fast as it can.  For bit-exact regression runs, open the wdsp channels with
+// block-for-output set and capture the result with a recorder.
+
+replay rpl;
+REPLAY prp = &rpl;
+
+int parse_wav (RPSRC a, long long length)
+{	// every read is checked against the end of the file; 'off' is the offset of the current chunk header
+	unsigned char* p;
+	long long off = 12;
+	unsigned int csize, rate = 0;
+	unsigned short tag = 0, channels = 0, bits = 0;
+	long long dsize = 0;
+	a->data = 0;
+	if (length < 12 || memcmp (a->view, "RIFF", 4) || memcmp (a->view + 8, "WAVE", 4)) return 0;
+	while (off + 8 <= length)
+	{
+		p = a->view + off;
+		memcpy (&csize, p + 4, 4);
+		if (!memcmp (p, "fmt ", 4) && csize >= 16)
+		{
+			if (off + 8 + 16 > length) return 0;
+			memcpy (&tag,      p +  8, 2);
+			memcpy (&channels, p + 10, 2);
+			memcpy (&rate,     p + 12, 4);
+			memcpy (&bits,     p + 22, 2);
+			if (tag == 0xfffe)
+			{	// WAVE_FORMAT_EXTENSIBLE:  the format tag is the first two bytes of the subformat GUID
+				if (csize < 40 || off + 8 + 40 > length) return 0;
+				memcpy (&tag,  p + 32, 2);
+			}
+		}
+		else if (!memcmp (p, "data", 4))
+		{
+			a->data = p + 8;
+			dsize = length - (off + 8);
+			if (csize < dsize && csize < 0xffffffffu - 36)	// a size clamped at 4 GB means "to the end"
+				dsize = csize;
+			break;
+		}
+		off += 8 + (long long)csize + (csize & 1);
+	}
+	if (!a->data || channels != 2) return 0;
+	if      (tag == 1 && bits == 16) { a->format = REC_INT16;   a->bps = 4; }
+	else if (tag == 1 && bits == 24) { a->format = REC_INT24;   a->bps = 6; }
+	else if (tag == 3 && bits == 32) { a->format = REC_FLOAT32; a->bps = 8; }
+	else return 0;
+	a->rate = rate;
+	a->nsamps = dsize / a->bps;
+	return 1;
+}
+
+int parse_raw (RPSRC a, const char* filename, long long length)
+{	// headerless float32 I/Q, rate from the '<filename>.txt' sidecar written by the recorder
+	char meta[MAX_PATH + 8];
+	char line[128];
+	FILE* mfile;
+	a->rate = 0;
+	if (strlen (filename) + sizeof (".txt") > sizeof (meta)) return 0;
+	sprintf_s (meta, sizeof (meta), "%s.txt", filename);
+	if (!(mfile = fopen (meta, "r"))) return 0;
+	while (fgets (line, sizeof (line), mfile))
+		sscanf_s (line, "rate=%d", &a->rate);
+	fclose (mfile);
+	if (a->rate <= 0) return 0;
+	a->format = REC_RAW;
+	a->bps = 8;
+	a->data = a->view;
+	a->nsamps = length / a->bps;
+	return 1;
+}
+
+void convert_replay (int format, int n, unsigned char* in, double* out)
+{	// n complex samples; scaling is the inverse of the recorder's
+	int i, v;
+	short s;
+	float f;
+	switch (format)
+	{
+	case REC_INT16:
+		for (i = 0; i < 2 * n; i++)
+		{
+			memcpy (&s, in + 2 * i, 2);
+			out[i] = (double)s / 32767.0;
+		}
+		break;
+	case REC_INT24:
+		for (i = 0; i < 2 * n; i++)
+		{
+			v = in[3 * i + 0] | (in[3 * i + 1] << 8) | ((signed char)in[3 * i + 2] * 65536);
+			out[i] = (double)v / 8388607.0;
+		}
+		break;
+	default:
+		for (i = 0; i < 2 * n; i++)
+		{
+			memcpy (&f, in + 4 * i, 4);
+			out[i] = (double)f;
+		}
+		break;
+	}
+}
+
+long long fill_replay (int stream)
+{	// samples waiting in the stream's input ring
+	CMB b = pcm->pcbuff[stream];
+	return b->tags->incount - b->tags->outcount;
+}
+
+void replay_main (void* pargs)
+{
+	int i, k, n, more;
+	double t, tmin = 0.0;
+	long long due;
+	LARGE_INTEGER now;
+	RPSRC s;
+	CMB b;
+	DWORD taskIndex = 0;
+	HANDLE hTask = AvSetMmThreadCharacteristics (TEXT("Pro Audio"), &taskIndex);
+	if (hTask != 0) AvSetMmThreadPriority (hTask, 2);
+	else SetThreadPriority (GetCurrentThread (), THREAD_PRIORITY_HIGHEST);
+
+	while (_InterlockedAnd (&prp->run, 1))
+	{
+		for (i = 0, k = -1; i < cmMAXreplay; i++)
+		{	// the source furthest behind goes next
+			s = &prp->src[i];
+			if (!s->open || s->pos >= s->nsamps) continue;
+			t = (double)s->sent / s->rate;
+			if (k < 0 || t < tmin)
+			{
+				k = i;
+				tmin = t;
+			}
+		}
+		if (k < 0)
+		{	// every file is at its end
+			for (i = 0, more = 0; i < cmMAXreplay; i++)
+				if (prp->src[i].open && prp->src[i].nsamps)
+				{
+					prp->src[i].pos = 0;
+					more = 1;
+				}
+			if (!prp->loop || !more) break;
+			continue;
+		}
+		s = &prp->src[k];
+		if ((n = s->size) > s->nsamps - s->pos) n = (int)(s->nsamps - s->pos);
+		if (prp->realtime)
+		{
+			due = prp->tbase + (long long)(tmin * prp->freq.QuadPart);
+			while (QueryPerformanceCounter (&now), now.QuadPart < due && _InterlockedAnd (&prp->run, 1))
+				Sleep (due - now.QuadPart > prp->freq.QuadPart / 500 ? 1 : 0);
+		}
+		else
+		{
+			b = pcm->pcbuff[s->stream];
+			while (fill_replay (s->stream) + n > b->r1_active_buffsize && _InterlockedAnd (&prp->run, 1))
+				Sleep (0);
+		}
+		convert_replay (s->format, n, s->data + s->pos * s->bps, s->buff);
+		xinbound (pcm->pebuff[s->stream], n, s->buff);
+		s->pos  += n;
+		s->sent += n;
+	}
+	for (i = 0; i < cmMAXreplay; i++)
+	{	// let the streams consume what was injected before reporting completion
+		s = &prp->src[i];
+		if (s->open)
+			while (fill_replay (s->stream) >= pcm->pcbuff[s->stream]->r1_outsize && _InterlockedAnd (&prp->run, 1))
+				Sleep (1);
+	}
+	for (i = 0; i < cmMAXreplay; i++)
+		if (prp->src[i].open)
+			InterlockedBitTestAndReset (&pcm->pebuff[prp->src[i].stream]->replay, 0);	// live input resumes
+	InterlockedBitTestAndReset (&prp->running, 0);
+	ReleaseSemaphore (prp->Done, 1, 0);
+	_endthread ();
+}
+
+void destroy_replay (void)
+{
+	int i;
+	StopReplay ();
+	for (i = 0; i < cmMAXreplay; i++)
+		CloseReplaySource (i);
+}
+
+/********************************************************************************************************
+*																										*
+*											Replay Properties											*
+*																										*
+********************************************************************************************************/
+
+// 'error' returns 0 on success, -1 if 'id' or 'stream' is invalid or a replay is in progress, -2 if the
+//	file cannot be mapped, -3 if its format is not supported, -4 if its rate differs from the stream's
+PORT
+void OpenReplaySource (int id, int stream, const char* filename, int* error)
+{
+	LARGE_INTEGER length;
+	RPSRC a;
+	const char* ext;
+	int ok;
+	*error = -1;
+	if (id < 0 || id >= cmMAXreplay || stream < 0 || stream >= pcm->cmSTREAM || prp->Done) return;
+	CloseReplaySource (id);
+	a = &prp->src[id];
+	*error = -2;
+	a->hfile = CreateFileA (filename, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0);
+	if (a->hfile == INVALID_HANDLE_VALUE) return;
+	if (!GetFileSizeEx (a->hfile, &length) || length.QuadPart == 0
+		|| !(a->hmap = CreateFileMappingA (a->hfile, 0, PAGE_READONLY, 0, 0, 0))
+		|| !(a->view = (unsigned char *) MapViewOfFile (a->hmap, FILE_MAP_READ, 0, 0, 0)))
+	{
+		if (a->hmap) CloseHandle (a->hmap);
+		CloseHandle (a->hfile);
+		a->hmap = 0;
+		return;
+	}
+	ext = strrchr (filename, '.');
+	if (ext && !_stricmp (ext, ".wav"))
+		ok = parse_wav (a, length.QuadPart);
+	else
+		ok = parse_raw (a, filename, length.QuadPart);
+	if (!ok || a->rate != pcm->xcm_inrate[stream])
+	{
+		*error = ok ? -4 : -3;
+		UnmapViewOfFile (a->view);
+		CloseHandle (a->hmap);
+		CloseHandle (a->hfile);
+		a->view = 0;
+		a->hmap = 0;
+		return;
+	}
+	a->stream = stream;
+	a->size = pcm->xcm_insize[stream];
+	if (a->size > pcm->cmMAXInbound[stream]) a->size = pcm->cmMAXInbound[stream];
+	a->buff = (double *) malloc0 (a->size * sizeof (complex));
+	a->pos = 0;
+	a->sent = 0;
+	a->open = 1;
+	*error = 0;
+}
+
+// ignored while a replay is in progress
+PORT
+void CloseReplaySource (int id)
+{
+	RPSRC a;
+	if (id < 0 || id >= cmMAXreplay || prp->Done) return;
+	a = &prp->src[id];
+	if (!a->open) return;
+	a->open = 0;
+	_aligned_free (a->buff);
+	UnmapViewOfFile (a->view);
+	CloseHandle (a->hmap);
+	CloseHandle (a->hfile);
+	a->view = 0;
+	a->hmap = 0;
+}
+
+// 'error' returns 0 on success, -1 if a replay is already in progress or no source is open
+PORT
+void StartReplay (int realtime, int loop, int* error)
+{
+	int i, n;
+	LARGE_INTEGER now;
+	*error = -1;
+	if (prp->Done) return;
+	for (i = 0, n = 0; i < cmMAXreplay; i++)
+		if (prp->src[i].open)
+		{
+			prp->src[i].pos = 0;
+			prp->src[i].sent = 0;
+			n++;
+		}
+	if (!n) return;
+	prp->realtime = realtime;
+	prp->loop = loop;
+	QueryPerformanceFrequency (&prp->freq);
+	QueryPerformanceCounter (&now);
+	prp->tbase = now.QuadPart;
+	prp->Done = CreateSemaphore (0, 0, 1, 0);
+	for (i = 0; i < cmMAXreplay; i++)
+		if (prp->src[i].open)
+			InterlockedBitTestAndSet (&pcm->pebuff[prp->src[i].stream]->replay, 0);		// gate the radio
+	InterlockedBitTestAndSet (&prp->run, 0);
+	InterlockedBitTestAndSet (&prp->running, 0);
+	_beginthread (replay_main, 0, (void *)prp);
+	*error = 0;
+}
+
+// stops a replay in progress, or releases one that has completed
+PORT
+void StopReplay (void)
+{
+	if (!prp->Done) return;
+	InterlockedBitTestAndReset (&prp->run, 0);
+	WaitForSingleObject (prp->Done, INFINITE);
+	CloseHandle (prp->Done);
+	prp->Done = 0;
+}
+
+// 'seconds' is the position of the source furthest behind, including earlier loops
+PORT
+void GetReplayStatus (int* running, double* seconds)
+{
+	int i, first = 1;
+	double t;
+	*running = _InterlockedAnd (&prp->running, 1);
+	*seconds = 0.0;
+	for (i = 0; i < cmMAXreplay; i++)
+		if (prp->src[i].open)
+		{
+			t = (double)prp->src[i].sent / prp->src[i].rate;
+			if (first || t < *seconds) *seconds = t;
+			first = 0;
+		}
+}
@@ -0,0 +1,74 @@
+/*  replay.h
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+#ifndef _replay_h
+#define _replay_h
+
+#define cmMAXreplay		(8)							// maximum number of replay sources (e.g., one per DDC)
+
+typedef struct _rpsrc
+{
+	int open;
+	int stream;										// cmaster stream fed through Inbound()
+	int format;										// sample format, enum _recformat
+	int rate;										// sample rate of the file
+	int bps;										// bytes per complex sample
+	HANDLE hfile;
+	HANDLE hmap;
+	unsigned char* view;							// mapped file
+	unsigned char* data;							// first sample
+	long long nsamps;								// complex samples in the file
+	long long pos;									// next sample to inject
+	long long sent;									// samples injected, including earlier loops
+	int size;										// samples per Inbound() call
+	double* buff;									// converted samples
+} rpsrc, *RPSRC;
+
+typedef struct _replay
+{
+	volatile long run;								// the replay thread loops while set
+	volatile long running;							// the replay thread is alive
+	int realtime;									// 1 = paced at the files' sample rates, 0 = as fast as the rings drain
+	int loop;										// restart at the end of the files
+	long long tbase;								// performance counter at start
+	LARGE_INTEGER freq;
+	HANDLE Done;									// released by the replay thread as it exits
+	rpsrc src[cmMAXreplay];
+} replay, *REPLAY;
+
+extern void destroy_replay (void);
+
+extern __declspec (dllexport) void OpenReplaySource (int id, int stream, const char* filename, int* error);
+
+extern __declspec (dllexport) void CloseReplaySource (int id);
+
+extern __declspec (dllexport) void StartReplay (int realtime, int loop, int* error);
+
+extern __declspec (dllexport) void StopReplay (void);
+
+extern __declspec (dllexport) void GetReplayStatus (int* running, double* seconds);
+
+#endif
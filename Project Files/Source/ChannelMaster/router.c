@@ -70,7 +70,8 @@ void flush_router(ROUTER a)
 PORT
 void xrouter(void* ptr, int id, int port, int nsamples, double* data)
 {
-	int i, j, k, bport, sps, si, ctrl;
+	int i, j, k, bport, sps, ns, ctrl;
+	double* src;
 	ROUTER a;
 	if (ptr == 0)	a = prouter[id];
 	else			a = (ROUTER)ptr;
@@ -80,7 +81,8 @@ void xrouter(void* ptr, int id, int port, int nsamples, double* data)
 	bport = port - rtPORTBASE;												// 0-based port number
 	if (bport < a->ports)													// if the port is valid ...
 	{
-		sps = nsamples / a->nstreams[bport];								// samples per stream
+		ns = a->nstreams[bport];											// number of interleaved streams
+		sps = nsamples / ns;												// samples per stream
 		for (i = 0; i < a->ncalls; i++)
 		{
 			switch (a->function[bport][i][ctrl])
@@ -89,15 +91,13 @@ void xrouter(void* ptr, int id, int port, int nsamples, double* data)
 				Inbound(a->callid[bport][i][ctrl], nsamples, data);
 				break;
 			case 2:
-				for (j = 0; j < a->nstreams[bport]; j++)					// for each stream
+				if (InboundInterleaved(a->callid[bport][i][ctrl], sps, ns, data))
+					break;													// consumed straight from the interleaved payload
+				for (j = 0; j < ns; j++)									// for each stream
 				{
-					si = j * sps;											// stream index
-					ptrs[j] = &(a->ddata[2 * si]);							// save pointer to the stream
-					for (k = 0; k < sps; k++)								// for each sample of the stream
-					{
-						a->ddata[2 * (si + k) + 0] = data[2 * (a->nstreams[bport] * k + j) + 0];
-						a->ddata[2 * (si + k) + 1] = data[2 * (a->nstreams[bport] * k + j) + 1];
-					}
+					ptrs[j] = &(a->ddata[2 * j * sps]);						// save pointer to the stream
+					for (k = 0, src = data + 2 * j; k < sps; k++, src += 2 * ns)
+						_mm_storeu_pd (&ptrs[j][2 * k], _mm_loadu_pd (src));	// one complex sample
 				}
 				InboundBlock(a->callid[bport][i][ctrl], sps, ptrs);
 				break;
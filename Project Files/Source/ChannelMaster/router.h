@@ -31,7 +31,7 @@ warren@wpratt.com
 #define rtMAXCALLS		(2)							// maximum number of calls for each data buffer
 #define rtMAXPORTS		(12)						// maximum number of ports to be used
 #define rtPORTBASE		(1035)						// base number for port group to be routed
-#define rtMAXSTREAMS	(2)							// maximum number of streams to be interleaved
+#define rtMAXSTREAMS	(8)							// maximum number of streams to be interleaved
 #define rtMAXSIZE		(720)						// maximum number of complex samples in a buffer of data
 
 typedef struct _router
@@ -66,6 +66,21 @@ void InboundBlock (int id, int nsamples, double** data)
 	}
 }
 
+// called by the router with the interleaved payload before it de-interleaves;
+//	returns 1 if the data was consumed directly, 0 if InboundBlock() should be called with separate streams
+int InboundInterleaved (int id, int nsamples, int nstreams, double* data)
+{
+	switch (id)
+	{
+	case 0: // diversity receivers
+		xdivEXTIL (0, nsamples, nstreams, data, psyn->divbuff);
+		Inbound (0, nsamples, psyn->divbuff);
+		return 1;
+	default:
+		return 0;
+	}
+}
+
 PORT
 void SetPSTxIdx (int id, int idx)
 {
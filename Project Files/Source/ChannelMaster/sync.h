@@ -46,4 +46,6 @@ extern void destroy_sync();
 
 extern __declspec (dllexport) void InboundBlock (int id, int nsamples, double** data);
 
+extern int InboundInterleaved (int id, int nsamples, int nstreams, double* data);
+
 #endif
\ No newline at end of file
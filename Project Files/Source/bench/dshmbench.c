@@ -0,0 +1,163 @@
+/*  dshmbench.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+// Standalone benchmark for the display shared-memory publication; not part of any project.  It runs the
+// wdsp publisher and the reader library in one process.  Build from this directory with:
+//
+//	cl /O2 /I..\wdsp dshmbench.c ..\wdsp\dshmpub.c ..\wdsp\dshmread.c
+//
+// Usage:  dshmbench [readers [pixels [frames/sec [seconds]]]]; a rate of 0 publishes as fast as possible.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "comm.h"
+
+// stand-ins for the wdsp state and utilities dshmpub.c refers to; only the display publisher is exercised
+
+struct _ch ch[MAX_CHANNELS];
+struct _rxa rxa[MAX_CHANNELS];
+struct _txa txa[MAX_CHANNELS];
+DP pdisp[dMAX_DISPLAYS];
+
+void *malloc0 (int size)
+{
+	void* p = _aligned_malloc (size, 16);
+	if (p != 0) memset (p, 0, size);
+	return p;
+}
+
+/********************************************************************************************************
+*																										*
+*											Benchmark													*
+*																										*
+********************************************************************************************************/
+
+typedef struct _dshmbench
+{
+	int npixels;
+	volatile long* stop;
+	HANDLE done;
+	long frames;								// frames read
+	long missed;								// frames published after the first one read but never read
+} dshmbench, *DSHMBENCH;
+
+void dshm_bench_reader (void* arg)
+{
+	DSHMBENCH b = (DSHMBENCH)arg;
+	DSHM_READER r = dshm_open_display (dMAX_DISPLAYS);
+	float* pix = (float *) malloc0 (b->npixels * sizeof (float));
+	dshm_frame hdr;
+	long prev = -1;
+	if (r)
+	{
+		while (!*b->stop)
+			if (dshm_wait_frame (r, 100) > 0 && dshm_read_frame (r, pix, b->npixels, &hdr) > 0)
+			{
+				if (prev >= 0) b->missed += hdr.serial - prev - 1;
+				prev = hdr.serial;
+				b->frames++;
+			}
+		dshm_close_display (r);
+	}
+	_aligned_free (pix);
+	ReleaseSemaphore (b->done, 1, 0);
+}
+
+void bench_display (int nreaders, int npixels, double rate, double seconds, 
+	double* write_fps, double* read_fps, double* missed)
+{	// publishes frames of 'npixels' at 'rate' frames/sec (0 for as fast as possible) to 'nreaders' reader
+	// threads for 'seconds'; reports the frames/sec written, the mean frames/sec read per reader, and the
+	// fraction of frames the readers did not see
+	int i;
+	long nw = 0, nr = 0, nm = 0;
+	volatile long stop = 0;
+	double elapsed = 0.0, freq;
+	LARGE_INTEGER t0, now;
+	DSHMPUB a = create_dshmpub (dMAX_DISPLAYS, 0, npixels);
+	DSHMBENCH b = (DSHMBENCH) malloc0 (nreaders * sizeof (dshmbench));
+	dOUTREAL* pix = (dOUTREAL *) malloc0 (npixels * sizeof (dOUTREAL));
+	HANDLE done = CreateSemaphore (0, 0, nreaders + 1, 0);
+	*write_fps = 0.0;
+	*read_fps = 0.0;
+	*missed = 0.0;
+	if (a)
+	{
+		for (i = 0; i < nreaders; i++)
+		{
+			b[i].npixels = npixels;
+			b[i].stop = &stop;
+			b[i].done = done;
+			_beginthread (dshm_bench_reader, 0, (void *)&b[i]);
+		}
+		Sleep (50);												// let the readers attach
+		QueryPerformanceFrequency (&now);
+		freq = (double)now.QuadPart;
+		QueryPerformanceCounter (&t0);
+		while (elapsed < seconds)
+		{
+			if (rate <= 0.0 || (double)nw < elapsed * rate)
+			{
+				for (i = 0; i < npixels; i++)
+					pix[i] = (dOUTREAL)(-140.0 + (double)((nw + i) & 63));
+				xdshmpub (a, npixels, 0.0, 0.0, pix);
+				nw++;
+			}
+			else
+				Sleep (0);
+			QueryPerformanceCounter (&now);
+			elapsed = (double)(now.QuadPart - t0.QuadPart) / freq;
+		}
+		InterlockedExchange (&stop, 1);
+		for (i = 0; i < nreaders; i++)
+			WaitForSingleObject (done, INFINITE);
+		for (i = 0; i < nreaders; i++)
+		{
+			nr += b[i].frames;
+			nm += b[i].missed;
+		}
+		*write_fps = (double)nw / elapsed;
+		if (nreaders > 0)
+			*read_fps = (double)nr / (double)nreaders / elapsed;
+		if (nr + nm > 0)
+			*missed = (double)nm / (double)(nr + nm);
+		destroy_dshmpub (a);
+	}
+	CloseHandle (done);
+	_aligned_free (pix);
+	_aligned_free (b);
+}
+
+int main (int argc, char** argv)
+{
+	int nreaders   = argc > 1 ? atoi (argv[1]) : 4;
+	int npixels    = argc > 2 ? atoi (argv[2]) : 4096;
+	double rate    = argc > 3 ? atof (argv[3]) : 60.0;
+	double seconds = argc > 4 ? atof (argv[4]) : 5.0;
+	double write_fps, read_fps, missed;
+	bench_display (nreaders, npixels, rate, seconds, &write_fps, &read_fps, &missed);
+	printf ("%d readers, %d pixels:  wrote %.1f frames/sec, read %.1f frames/sec per reader, missed %.3f%%\n",
+		nreaders, npixels, write_fps, read_fps, 100.0 * missed);
+	return 0;
+}
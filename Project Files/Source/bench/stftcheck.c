@@ -0,0 +1,273 @@
+/*  stftcheck.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+// Standalone regression check for the wdsp STFT engine; not part of any project.  Build from this
+// directory with, e.g., for x64:
+//
+//	cl /O2 /I..\wdsp stftcheck.c ..\wdsp\stft.c ..\..\lib\fftw_x64\libfftw3-3.lib
+//
+// and run with libfftw3-3.dll alongside.  The exit code is the number of failing combinations.
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "comm.h"
+
+// stand-ins for the wdsp utilities stft.c uses; this program is single-threaded
+
+void *malloc0 (int size)
+{
+	void* p = _aligned_malloc (size, 16);
+	if (p != 0) memset (p, 0, size);
+	return p;
+}
+
+void enter_planner (void) { }
+
+void leave_planner (void) { }
+
+/********************************************************************************************************
+*																										*
+*										Regression Check												*
+*																										*
+********************************************************************************************************/
+
+// Reference:  the ring-buffer overlap-add that EMNR and CFCOMP carried before they moved to this engine,
+// kept verbatim except that the input ring is sized fsize + bsize.  The original sized it fsize when
+// fsize > bsize, which let a block overwrite unread samples whenever fsize > bsize > incr.
+
+typedef struct _stft_ref
+{
+	int bsize;
+	int fsize;
+	int ovrlp;
+	int incr;
+	int msize;
+	int iasize;
+	int iainidx;
+	int iaoutidx;
+	int nsamps;
+	int oasize;
+	int oainidx;
+	int init_oainidx;
+	int oaoutidx;
+	int saveidx;
+	double* inaccum;
+	double* outaccum;
+	double** save;
+} stft_ref, *STFT_REF;
+
+typedef struct _stft_check
+{
+	int msize;
+	double* mask;
+	double* forfftout;
+	double* revfftin;
+} stft_check, *STFT_CHECK;
+
+void frame_stft_check (void* ptr)
+{	// a fixed, non-trivial spectral mask
+	STFT_CHECK c = (STFT_CHECK)ptr;
+	int i;
+	for (i = 0; i < c->msize; i++)
+	{
+		c->revfftin[2 * i + 0] = c->mask[i] * c->forfftout[2 * i + 0];
+		c->revfftin[2 * i + 1] = c->mask[i] * c->forfftout[2 * i + 1];
+	}
+}
+
+void flush_stft_ref (STFT_REF r)
+{
+	int i;
+	memset (r->inaccum, 0, r->iasize * sizeof (double));
+	for (i = 0; i < r->ovrlp; i++)
+		memset (r->save[i], 0, r->fsize * sizeof (double));
+	memset (r->outaccum, 0, r->oasize * sizeof (double));
+	r->nsamps   = 0;
+	r->iainidx  = 0;
+	r->iaoutidx = 0;
+	r->oainidx  = r->init_oainidx;
+	r->oaoutidx = 0;
+	r->saveidx  = 0;
+}
+
+void xstft_ref (STFT_REF r, STFT a, double* in, double* out, double* window, double pregain, double postgain)
+{	// uses the engine's fft buffers and plans, so both paths see the same transform
+	int i, j, k, sbuff, sbegin;
+	for (i = 0; i < 2 * r->bsize; i += 2)
+	{
+		r->inaccum[r->iainidx] = in[i];
+		r->iainidx = (r->iainidx + 1) % r->iasize;
+	}
+	r->nsamps += r->bsize;
+	while (r->nsamps >= r->fsize)
+	{
+		for (i = 0, j = r->iaoutidx; i < r->fsize; i++, j = (j + 1) % r->iasize)
+			a->forfftin[i] = pregain * window[i] * r->inaccum[j];
+		r->iaoutidx = (r->iaoutidx + r->incr) % r->iasize;
+		r->nsamps -= r->incr;
+		fftw_execute (a->Rfor);
+		(*a->frame)(a->ptr);
+		fftw_execute (a->Rrev);
+		for (i = 0; i < r->fsize; i++)
+			r->save[r->saveidx][i] = postgain * window[i] * a->revfftout[i];
+		for (i = r->ovrlp; i > 0; i--)
+		{
+			sbuff = (r->saveidx + i) % r->ovrlp;
+			sbegin = r->incr * (r->ovrlp - i);
+			for (j = sbegin, k = r->oainidx; j < r->incr + sbegin; j++, k = (k + 1) % r->oasize)
+			{
+				if ( i == r->ovrlp)
+					r->outaccum[k]  = r->save[sbuff][j];
+				else
+					r->outaccum[k] += r->save[sbuff][j];
+			}
+		}
+		r->saveidx = (r->saveidx + 1) % r->ovrlp;
+		r->oainidx = (r->oainidx + r->incr) % r->oasize;
+	}
+	for (i = 0; i < r->bsize; i++)
+	{
+		out[2 * i + 0] = r->outaccum[r->oaoutidx];
+		out[2 * i + 1] = 0.0;
+		r->oaoutidx = (r->oaoutidx + 1) % r->oasize;
+	}
+}
+
+double check_stft (int bsize, int fsize, int ovrlp, int nblocks)
+{	// runs 'nblocks' of noise through the engine and the reference, flushing both half way, and returns
+	// the largest absolute difference between their outputs
+	int i, n, j;
+	unsigned int seed = 12345;
+	double maxdiff = 0.0, d;
+	double* in   = (double *) malloc0 (bsize * sizeof (complex));
+	double* out  = (double *) malloc0 (bsize * sizeof (complex));
+	double* rout = (double *) malloc0 (bsize * sizeof (complex));
+	double* window = (double *) malloc0 (fsize * sizeof (double));
+	double pregain = 2.0 / (double)fsize;
+	double postgain = 0.5 / (double)ovrlp;
+	STFT_CHECK c = (STFT_CHECK) malloc0 (sizeof (stft_check));
+	STFT_REF r = (STFT_REF) malloc0 (sizeof (stft_ref));
+	STFT a;
+	c->msize = fsize / 2 + 1;
+	c->mask = (double *) malloc0 (c->msize * sizeof (double));
+	for (i = 0; i < c->msize; i++)
+		c->mask[i] = 0.25 + 0.75 * (double)((i * 7) % 11) / 10.0;
+	a = create_stft (bsize, in, out, fsize, ovrlp, frame_stft_check, (void *)c);
+	c->forfftout = a->forfftout;
+	c->revfftin = a->revfftin;
+	for (i = 0; i < fsize; i++)
+		window[i] = sin (PI * ((double)i + 0.5) / (double)fsize);
+	setWindow_stft (a, window, pregain, postgain);
+	r->bsize = bsize;
+	r->fsize = fsize;
+	r->ovrlp = ovrlp;
+	r->incr = fsize / ovrlp;
+	r->msize = fsize / 2 + 1;
+	r->iasize = fsize + bsize;
+	if (fsize > bsize)
+	{
+		if (bsize > r->incr) r->oasize = bsize;
+		else				 r->oasize = r->incr;
+		r->init_oainidx = (fsize - bsize - r->incr) % r->oasize;
+	}
+	else
+	{
+		r->oasize = bsize;
+		r->init_oainidx = fsize - r->incr;
+	}
+	r->inaccum  = (double *) malloc0 (r->iasize * sizeof (double));
+	r->outaccum = (double *) malloc0 (r->oasize * sizeof (double));
+	r->save = (double **) malloc0 (ovrlp * sizeof (double *));
+	for (i = 0; i < ovrlp; i++)
+		r->save[i] = (double *) malloc0 (fsize * sizeof (double));
+	flush_stft_ref (r);
+	for (n = 0; n < nblocks; n++)
+	{
+		if (n == nblocks / 2)
+		{
+			flush_stft (a);
+			flush_stft_ref (r);
+		}
+		for (i = 0; i < bsize; i++)
+		{
+			seed = 1664525 * seed + 1013904223;
+			in[2 * i + 0] = (double)(seed >> 8) / (double)(1 << 24) - 0.5;
+			in[2 * i + 1] = 0.0;
+		}
+		xstft_ref (r, a, in, rout, window, pregain, postgain);
+		xstft (a);
+		for (j = 0; j < 2 * bsize; j++)
+			if ((d = fabs (out[j] - rout[j])) > maxdiff) maxdiff = d;
+	}
+	for (i = 0; i < ovrlp; i++)
+		_aligned_free (r->save[i]);
+	_aligned_free (r->save);
+	_aligned_free (r->outaccum);
+	_aligned_free (r->inaccum);
+	_aligned_free (r);
+	destroy_stft (a);
+	_aligned_free (c->mask);
+	_aligned_free (c);
+	_aligned_free (window);
+	_aligned_free (rout);
+	_aligned_free (out);
+	_aligned_free (in);
+	return maxdiff;
+}
+
+int CheckSTFT (double* maxdiff)
+{	// compares the engine against the reference across block/fft/overlap combinations that exercise
+	// every buffer-sizing branch of the reference; returns the number of combinations whose output differed
+	static const int cases[][3] =
+	{
+		{   64,  256, 4 },			// bsize == incr
+		{   64,  512, 4 },			// bsize < incr
+		{  128,  256, 4 },			// fsize > bsize > incr
+		{  128,  256, 2 },
+		{  256,  256, 4 },			// bsize == fsize
+		{  512,  256, 4 },			// bsize > fsize
+		{ 1024,  256, 8 },
+		{   32, 1024, 8 },
+		{ 2048,  128, 2 },
+	};
+	int i, nfail = 0;
+	double d;
+	*maxdiff = 0.0;
+	for (i = 0; i < (int)(sizeof (cases) / sizeof (cases[0])); i++)
+	{
+		d = check_stft (cases[i][0], cases[i][1], cases[i][2], 64 + 8 * cases[i][1] / cases[i][0]);
+		if (d != 0.0) nfail++;
+		if (d > *maxdiff) *maxdiff = d;
+	}
+	return nfail;
+}
+
+int main (void)
+{
+	double maxdiff;
+	int nfail = CheckSTFT (&maxdiff);
+	printf ("%d combination(s) differ from the reference; largest difference %g\n", nfail, maxdiff);
+	return nfail;
+}
@@ -28,12 +28,71 @@ warren@wpratt.com
 
 struct _rxa rxa[MAX_CHANNELS];
 
+void calc_buffs_rxa (int channel)
+{	// lays out midbuff, then inbuff and outbuff, in a fresh channel arena; falls back to the heap if the
+	// arena cannot be reserved or committed
+	int need = size_arena (2 * ch[channel].dsp_size    * sizeof (complex))
+			 + size_arena (1 * ch[channel].dsp_insize  * sizeof (complex))
+			 + size_arena (1 * ch[channel].dsp_outsize * sizeof (complex));
+	if ((rxa[channel].arena = create_arena (max (ARENA_RESERVE, 4 * need))) != 0)
+	{
+		rxa[channel].midbuff = (double *) alloc_arena (rxa[channel].arena, 2 * ch[channel].dsp_size    * sizeof (complex));
+		rxa[channel].iomark = mark_arena (rxa[channel].arena);
+		rxa[channel].inbuff  = (double *) alloc_arena (rxa[channel].arena, 1 * ch[channel].dsp_insize  * sizeof (complex));
+		rxa[channel].outbuff = (double *) alloc_arena (rxa[channel].arena, 1 * ch[channel].dsp_outsize * sizeof (complex));
+	}
+	if (rxa[channel].arena == 0 || rxa[channel].midbuff == 0 || rxa[channel].inbuff == 0 || rxa[channel].outbuff == 0)
+	{
+		destroy_arena (rxa[channel].arena);
+		rxa[channel].arena = 0;
+		rxa[channel].midbuff = (double *) malloc0 (2 * ch[channel].dsp_size    * sizeof (complex));
+		rxa[channel].inbuff  = (double *) malloc0 (1 * ch[channel].dsp_insize  * sizeof (complex));
+		rxa[channel].outbuff = (double *) malloc0 (1 * ch[channel].dsp_outsize * sizeof (complex));
+	}
+}
+
+void decalc_buffs_rxa (int channel)
+{
+	if (rxa[channel].arena)
+		destroy_arena (rxa[channel].arena);
+	else
+	{
+		_aligned_free (rxa[channel].outbuff);
+		_aligned_free (rxa[channel].inbuff);
+		_aligned_free (rxa[channel].midbuff);
+	}
+}
+
+void calc_iobuffs_rxa (int channel)
+{	// re-lays inbuff and outbuff after a rate change; midbuff, and every block pointing at it, stays put
+	if (rxa[channel].arena == 0)
+	{	// heap fallback
+		_aligned_free (rxa[channel].outbuff);
+		_aligned_free (rxa[channel].inbuff);
+		rxa[channel].inbuff  = (double *) malloc0 (1 * ch[channel].dsp_insize  * sizeof (complex));
+		rxa[channel].outbuff = (double *) malloc0 (1 * ch[channel].dsp_outsize * sizeof (complex));
+	}
+	else
+	{
+		rewind_arena (rxa[channel].arena, rxa[channel].iomark);
+		rxa[channel].inbuff  = (double *) alloc_arena (rxa[channel].arena, 1 * ch[channel].dsp_insize  * sizeof (complex));
+		rxa[channel].outbuff = (double *) alloc_arena (rxa[channel].arena, 1 * ch[channel].dsp_outsize * sizeof (complex));
+		if (rxa[channel].inbuff == 0 || rxa[channel].outbuff == 0)
+		{	// outgrew the reservation:  rebuild the arena and re-point the whole pipeline
+			setDSPBuffsize_rxa (channel);
+			return;
+		}
+	}
+	setBuffers_shift (rxa[channel].shift.p, rxa[channel].inbuff, rxa[channel].inbuff);
+	setBuffers_resample (rxa[channel].rsmpin.p, rxa[channel].inbuff, rxa[channel].midbuff);
+	setBuffers_resample (rxa[channel].rsmpout.p, rxa[channel].midbuff, rxa[channel].outbuff);
+}
+
 void create_rxa (int channel)
 {
 	rxa[channel].mode = RXA_LSB;
-	rxa[channel].inbuff  = (double *) malloc0 (1 * ch[channel].dsp_insize  * sizeof (complex));
-	rxa[channel].outbuff = (double *) malloc0 (1 * ch[channel].dsp_outsize * sizeof (complex));
-	rxa[channel].midbuff = (double *) malloc0 (2 * ch[channel].dsp_size    * sizeof (complex));
+	rxa[channel].lazy.trelease = -1.0;
+	calc_buffs_rxa (channel);
 
 	// shift to select a slice of spectrum
 	rxa[channel].shift.p = create_shift (
@@ -75,7 +134,7 @@ void create_rxa (int channel)
 		0.100,											// averaging time constant
 		0.100,											// peak decay time constant
 		rxa[channel].meter,								// result vector
-		rxa[channel].pmtupdate,							// locks for meter access
+		&rxa[channel].mseq,								// meter sequence count
 		RXA_ADC_AV,										// index for average value
 		RXA_ADC_PK,										// index for peak value
 		-1,												// index for gain value
@@ -148,7 +207,7 @@ void create_rxa (int channel)
 		0.100,											// averaging time constant
 		0.100,											// peak decay time constant
 		rxa[channel].meter,								// result vector
-		rxa[channel].pmtupdate,							// locks for meter access
+		&rxa[channel].mseq,								// meter sequence count
 		RXA_S_AV,										// index for average value
 		RXA_S_PK,										// index for peak value
 		-1,												// index for gain value
@@ -367,7 +426,7 @@ void create_rxa (int channel)
 		0.100,											// averaging time constant
 		0.100,											// peak decay time constant
 		rxa[channel].meter,								// result vector
-		rxa[channel].pmtupdate,							// locks for meter access
+		&rxa[channel].mseq,								// meter sequence count
 		RXA_AGC_AV,										// index for average value
 		RXA_AGC_PK,										// index for peak value
 		RXA_AGC_GAIN,									// index for gain value
@@ -519,9 +578,7 @@ void destroy_rxa (int channel)
 	destroy_gen (rxa[channel].gen0.p);
 	destroy_resample (rxa[channel].rsmpin.p);
 	destroy_shift (rxa[channel].shift.p);
-	_aligned_free (rxa[channel].midbuff);
-	_aligned_free (rxa[channel].outbuff);
-	_aligned_free (rxa[channel].inbuff);
+	decalc_buffs_rxa (channel);
 }
 
 void flush_rxa (int channel)
@@ -600,14 +657,11 @@ void xrxa (int channel)
 void setInputSamplerate_rxa (int channel)
 {
 	// buffers
-	_aligned_free (rxa[channel].inbuff);
-	rxa[channel].inbuff = (double *)malloc0(1 * ch[channel].dsp_insize  * sizeof(complex));
+	calc_iobuffs_rxa (channel);
 	// shift
-	setBuffers_shift (rxa[channel].shift.p, rxa[channel].inbuff, rxa[channel].inbuff);
 	setSize_shift (rxa[channel].shift.p, ch[channel].dsp_insize);
 	setSamplerate_shift (rxa[channel].shift.p, ch[channel].in_rate);
 	// input resampler
-	setBuffers_resample (rxa[channel].rsmpin.p, rxa[channel].inbuff, rxa[channel].midbuff);
 	setSize_resample (rxa[channel].rsmpin.p, ch[channel].dsp_insize);
 	setInRate_resample (rxa[channel].rsmpin.p, ch[channel].in_rate);
 	RXAResCheck (channel);
@@ -616,10 +670,8 @@ void setInputSamplerate_rxa (int channel)
 void setOutputSamplerate_rxa (int channel)
 {
 	// buffers
-	_aligned_free (rxa[channel].outbuff);
-	rxa[channel].outbuff = (double *)malloc0(1 * ch[channel].dsp_outsize * sizeof(complex));
+	calc_iobuffs_rxa (channel);
 	// output resampler
-	setBuffers_resample (rxa[channel].rsmpout.p, rxa[channel].midbuff, rxa[channel].outbuff);
 	setOutRate_resample (rxa[channel].rsmpout.p, ch[channel].out_rate);
 	RXAResCheck (channel);
 }
@@ -627,15 +679,10 @@ void setOutputSamplerate_rxa (int channel)
 void setDSPSamplerate_rxa (int channel)
 {
 	// buffers
-	_aligned_free (rxa[channel].inbuff);
-	rxa[channel].inbuff = (double *)malloc0(1 * ch[channel].dsp_insize  * sizeof(complex));
-	_aligned_free (rxa[channel].outbuff);
-	rxa[channel].outbuff = (double *)malloc0(1 * ch[channel].dsp_outsize * sizeof(complex));
+	calc_iobuffs_rxa (channel);
 	// shift
-	setBuffers_shift (rxa[channel].shift.p, rxa[channel].inbuff, rxa[channel].inbuff);
 	setSize_shift (rxa[channel].shift.p, ch[channel].dsp_insize);
 	// input resampler
-	setBuffers_resample (rxa[channel].rsmpin.p, rxa[channel].inbuff, rxa[channel].midbuff);
 	setSize_resample (rxa[channel].rsmpin.p, ch[channel].dsp_insize);
 	setOutRate_resample (rxa[channel].rsmpin.p, ch[channel].dsp_rate);
 	// dsp_rate blocks
@@ -665,7 +712,6 @@ void setDSPSamplerate_rxa (int channel)
 	setSamplerate_ssql (rxa[channel].ssql.p, ch[channel].dsp_rate);
 	setSamplerate_panel (rxa[channel].panel.p, ch[channel].dsp_rate);
 	// output resampler
-	setBuffers_resample (rxa[channel].rsmpout.p, rxa[channel].midbuff, rxa[channel].outbuff);
 	setInRate_resample (rxa[channel].rsmpout.p, ch[channel].dsp_rate);
 	RXAResCheck (channel);
 }
@@ -673,12 +719,8 @@ void setDSPSamplerate_rxa (int channel)
 void setDSPBuffsize_rxa (int channel)
 {
 	// buffers
-	_aligned_free(rxa[channel].inbuff);
-	rxa[channel].inbuff = (double *)malloc0(1 * ch[channel].dsp_insize  * sizeof(complex));
-	_aligned_free (rxa[channel].midbuff);
-	rxa[channel].midbuff = (double *)malloc0(2 * ch[channel].dsp_size * sizeof(complex));
-	_aligned_free (rxa[channel].outbuff);
-	rxa[channel].outbuff = (double *)malloc0(1 * ch[channel].dsp_outsize * sizeof(complex));
+	decalc_buffs_rxa (channel);
+	calc_buffs_rxa (channel);
 	// shift
 	setBuffers_shift (rxa[channel].shift.p, rxa[channel].inbuff, rxa[channel].inbuff);
 	setSize_shift (rxa[channel].shift.p, ch[channel].dsp_insize);
@@ -737,6 +779,7 @@ void setDSPBuffsize_rxa (int channel)
 	// output resampler
 	setBuffers_resample (rxa[channel].rsmpout.p, rxa[channel].midbuff, rxa[channel].outbuff);
 	setSize_resample (rxa[channel].rsmpout.p, ch[channel].dsp_size);
+	RXAIOPlan (channel);
 }
 
 /********************************************************************************************************
@@ -795,6 +838,19 @@ void RXAResCheck (int channel)
 	a = rxa[channel].rsmpout.p;
 	if (ch[channel].dsp_rate != ch[channel].out_rate)	a->run = 1;
 	else												a->run = 0;
+	RXAIOPlan (channel);
+}
+
+void RXAIOPlan (int channel)
+{	// a bypassed resampler would only copy between midbuff and inbuff / outbuff; instead, dexchange()
+	//	exchanges directly with midbuff and the shift works in place there
+	double* in  = rxa[channel].rsmpin.p->run  ? rxa[channel].inbuff  : rxa[channel].midbuff;
+	double* out = rxa[channel].rsmpout.p->run ? rxa[channel].outbuff : rxa[channel].midbuff;
+	setBuffers_shift (rxa[channel].shift.p, in, in);
+	setBuffers_resample (rxa[channel].rsmpin.p, in, rxa[channel].midbuff);
+	setBuffers_resample (rxa[channel].rsmpout.p, rxa[channel].midbuff, out);
+	rxa[channel].exin  = in;
+	rxa[channel].exout = out;
 }
 
 void RXAbp1Check (int channel, int amd_run, int snba_run, 
@@ -809,7 +865,12 @@ void RXAbp1Check (int channel, int amd_run, int snba_run,
 		anr_run)	gain = 2.0;
 	else			gain = 1.0;
 	if (a->gain != gain)
-		setGain_bandpass (a, gain, 0);
+	{
+		if (DeferChannelUpdate (channel, RXA_UPD_BP1))
+			a->gain = gain;
+		else
+			setGain_bandpass (a, gain, 0);
+	}
 }
 
 void RXAbp1Set (int channel)
@@ -876,7 +937,8 @@ void RXAbpsnbaCheck (int channel, int mode, int notch_run)
 		a->f_high = f_high;
 		a->run_notches = run_notches;
 		// f_low, f_high, run_notches are needed for the filter recalculation
-		recalc_bpsnba_filter (a, 0);
+		if (!DeferChannelUpdate (channel, RXA_UPD_BPSNBA))
+			recalc_bpsnba_filter (a, 0);
 	}
 }
 
@@ -955,4 +1017,88 @@ void RXASetMP (int channel, int mp)
 	SetRXAFMSQMP				(channel, mp);
 	SetRXAFMMPde				(channel, mp);
 	SetRXAFMMPaud				(channel, mp);
-}
\ No newline at end of file
+}
+
+/********************************************************************************************************
+*																										*
+*											Parameter Batches											*
+*																										*
+********************************************************************************************************/
+
+void designBatch_rxa (int channel, int dirty)
+{	// new masks for the filters whose design a batch deferred; they are not yet in use
+	if (dirty & RXA_UPD_BP1)
+		setGain_bandpass (rxa[channel].bp1.p, rxa[channel].bp1.p->gain, 0);
+	if (dirty & RXA_UPD_NBP0)
+	{
+		NBP a = rxa[channel].nbp0.p;
+		calc_nbp_impulse (a);
+		setImpulse_fircore (a->p, a->impulse, 0);
+		_aligned_free (a->impulse);
+		if (a->fnfrun) a->hadnotch = a->havnotch;
+	}
+	if (dirty & RXA_UPD_BPSNBA)
+		recalc_bpsnba_filter (rxa[channel].bpsnba.p, 0);
+	if (dirty & RXA_UPD_EQP)
+	{
+		EQP a = rxa[channel].eqp.p;
+		double* impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
+		setImpulse_fircore (a->p, impulse, 0);
+		_aligned_free (impulse);
+	}
+}
+
+void applyBatch_rxa (int channel, int dirty)
+{	// called with csDSP held
+	if (dirty & RXA_UPD_BP1)    setUpdate_fircore (rxa[channel].bp1.p->p);
+	if (dirty & RXA_UPD_NBP0)   setUpdate_fircore (rxa[channel].nbp0.p->p);
+	if (dirty & RXA_UPD_BPSNBA) setUpdate_fircore (rxa[channel].bpsnba.p->bpsnba->p);
+	if (dirty & RXA_UPD_EQP)    setUpdate_fircore (rxa[channel].eqp.p->p);
+}
+
+/********************************************************************************************************
+*																										*
+*										Deferred Block Construction										*
+*																										*
+********************************************************************************************************/
+
+// EMNR and SNBA allocate their internals only when first switched on.  RXAPrewarm() lets the host
+// do that ahead of time, from a non-dsp thread; RXAReleaseIdle(), called periodically by the host,
+// frees blocks that have been off for longer than the time set with SetRXALazyRelease().  The internals
+// are built outside csDSP and swapped in under it, so the dsp thread never waits on the fft planning.
+
+PORT
+void RXAPrewarm (int channel)
+{
+	stage_emnr (rxa[channel].emnr.p, &ch[channel].csDSP);
+	stage_snba (rxa[channel].snba.p, &ch[channel].csDSP);
+}
+
+PORT
+void SetRXALazyRelease (int channel, double seconds)
+{
+	EnterCriticalSection (&ch[channel].csDSP);
+	rxa[channel].lazy.trelease = seconds;
+	LeaveCriticalSection (&ch[channel].csDSP);
+}
+
+PORT
+void RXAReleaseIdle (int channel)
+{
+	EMNR emnr = rxa[channel].emnr.p;
+	SNBA snba = rxa[channel].snba.p;
+	LARGE_INTEGER now, freq;
+	double tmin;
+	QueryPerformanceFrequency (&freq);
+	QueryPerformanceCounter (&now);
+	EnterCriticalSection (&ch[channel].csDSP);
+	if (rxa[channel].lazy.trelease >= 0.0)
+	{
+		tmin = rxa[channel].lazy.trelease * (double)freq.QuadPart;
+		if (emnr->live && !emnr->run && (double)(now.QuadPart - emnr->toff.QuadPart) >= tmin)
+			release_emnr (emnr);
+		if (snba->live && !snba->run && (double)(now.QuadPart - snba->toff.QuadPart) >= tmin)
+			release_snba (snba);
+	}
+	LeaveCriticalSection (&ch[channel].csDSP);
+}
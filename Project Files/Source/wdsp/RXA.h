@@ -56,14 +56,26 @@ enum rxaMeterType
 	RXA_METERTYPE_LAST
 };
 
+enum rxaUpdate
+{	// filter designs a parameter batch defers to CommitChannelUpdate()
+	RXA_UPD_BP1    = 0x01,
+	RXA_UPD_NBP0   = 0x02,
+	RXA_UPD_BPSNBA = 0x04,
+	RXA_UPD_EQP    = 0x08
+};
+
 struct _rxa
 {
+	ARENA arena;				// midbuff, then inbuff and outbuff; 0 if they fell back to the heap
+	int iomark;					// arena offset of inbuff
 	double* inbuff;
 	double* outbuff;
 	double* midbuff;
+	double* exin;				// buffer dexchange() fills:  inbuff, or midbuff when the input resampler is bypassed
+	double* exout;				// buffer dexchange() drains:  outbuff, or midbuff when the output resampler is bypassed
 	int mode;
 	double meter[RXA_METERTYPE_LAST];
-	CRITICAL_SECTION* pmtupdate[RXA_METERTYPE_LAST];
+	volatile long mseq;			// meter sequence count, odd while a meter is publishing
 	struct
 	{
 		METER p;
@@ -164,6 +176,10 @@ struct _rxa
 	{
 		SSQL p;
 	} ssql;
+	struct
+	{
+		double trelease;		// seconds a switched-off block stays allocated; < 0.0 for never
+	} lazy;
 };
 
 extern struct _rxa rxa[];
@@ -184,12 +200,18 @@ extern void setDSPSamplerate_rxa (int channel);
 
 extern void setDSPBuffsize_rxa (int channel);
 
+extern void designBatch_rxa (int channel, int dirty);
+
+extern void applyBatch_rxa (int channel, int dirty);
+
 // RXA Properties
 
 extern __declspec (dllexport) void SetRXAMode (int channel, int mode);
 
 extern void RXAResCheck (int channel);
 
+extern void RXAIOPlan (int channel);
+
 extern void RXAbp1Check (int channel, int amd_run, int snba_run, int emnr_run, int anf_run, int anr_run);
 
 extern void RXAbp1Set (int channel);
@@ -198,4 +220,10 @@ extern void RXAbpsnbaCheck (int channel, int mode, int notch_run);
 
 extern void RXAbpsnbaSet (int channel);
 
+extern __declspec (dllexport) void RXAPrewarm (int channel);
+
+extern __declspec (dllexport) void SetRXALazyRelease (int channel, double seconds);
+
+extern __declspec (dllexport) void RXAReleaseIdle (int channel);
+
 #endif
\ No newline at end of file
@@ -28,14 +28,73 @@ warren@wpratt.com
 
 struct _txa txa[MAX_CHANNELS];
 
+void calc_buffs_txa (int channel)
+{	// lays out midbuff, then inbuff and outbuff, in a fresh channel arena; falls back to the heap if the
+	// arena cannot be reserved or committed
+	int need = size_arena (2 * ch[channel].dsp_size    * sizeof (complex))
+			 + size_arena (1 * ch[channel].dsp_insize  * sizeof (complex))
+			 + size_arena (1 * ch[channel].dsp_outsize * sizeof (complex));
+	if ((txa[channel].arena = create_arena (max (ARENA_RESERVE, 4 * need))) != 0)
+	{
+		txa[channel].midbuff = (double *) alloc_arena (txa[channel].arena, 2 * ch[channel].dsp_size    * sizeof (complex));
+		txa[channel].iomark = mark_arena (txa[channel].arena);
+		txa[channel].inbuff  = (double *) alloc_arena (txa[channel].arena, 1 * ch[channel].dsp_insize  * sizeof (complex));
+		txa[channel].outbuff = (double *) alloc_arena (txa[channel].arena, 1 * ch[channel].dsp_outsize * sizeof (complex));
+	}
+	if (txa[channel].arena == 0 || txa[channel].midbuff == 0 || txa[channel].inbuff == 0 || txa[channel].outbuff == 0)
+	{
+		destroy_arena (txa[channel].arena);
+		txa[channel].arena = 0;
+		txa[channel].midbuff = (double *) malloc0 (2 * ch[channel].dsp_size    * sizeof (complex));
+		txa[channel].inbuff  = (double *) malloc0 (1 * ch[channel].dsp_insize  * sizeof (complex));
+		txa[channel].outbuff = (double *) malloc0 (1 * ch[channel].dsp_outsize * sizeof (complex));
+	}
+}
+
+void decalc_buffs_txa (int channel)
+{
+	if (txa[channel].arena)
+		destroy_arena (txa[channel].arena);
+	else
+	{
+		_aligned_free (txa[channel].outbuff);
+		_aligned_free (txa[channel].inbuff);
+		_aligned_free (txa[channel].midbuff);
+	}
+}
+
+void calc_iobuffs_txa (int channel)
+{	// re-lays inbuff and outbuff after a rate change; midbuff, and every block pointing at it, stays put
+	if (txa[channel].arena == 0)
+	{	// heap fallback
+		_aligned_free (txa[channel].outbuff);
+		_aligned_free (txa[channel].inbuff);
+		txa[channel].inbuff  = (double *) malloc0 (1 * ch[channel].dsp_insize  * sizeof (complex));
+		txa[channel].outbuff = (double *) malloc0 (1 * ch[channel].dsp_outsize * sizeof (complex));
+	}
+	else
+	{
+		rewind_arena (txa[channel].arena, txa[channel].iomark);
+		txa[channel].inbuff  = (double *) alloc_arena (txa[channel].arena, 1 * ch[channel].dsp_insize  * sizeof (complex));
+		txa[channel].outbuff = (double *) alloc_arena (txa[channel].arena, 1 * ch[channel].dsp_outsize * sizeof (complex));
+		if (txa[channel].inbuff == 0 || txa[channel].outbuff == 0)
+		{	// outgrew the reservation:  rebuild the arena and re-point the whole pipeline
+			setDSPBuffsize_txa (channel);
+			return;
+		}
+	}
+	setBuffers_resample (txa[channel].rsmpin.p, txa[channel].inbuff, txa[channel].midbuff);
+	setBuffers_resample (txa[channel].rsmpout.p, txa[channel].midbuff, txa[channel].outbuff);
+	setBuffers_meter (txa[channel].outmeter.p, txa[channel].outbuff);
+}
+
 void create_txa (int channel)
 {
 	txa[channel].mode   = TXA_LSB;
+	txa[channel].lazy.trelease = -1.0;
 	txa[channel].f_low  = -5000.0;
 	txa[channel].f_high = - 100.0;
-	txa[channel].inbuff  = (double *) malloc0 (1 * ch[channel].dsp_insize  * sizeof (complex));
-	txa[channel].outbuff = (double *) malloc0 (1 * ch[channel].dsp_outsize * sizeof (complex));
-	txa[channel].midbuff = (double *) malloc0 (2 * ch[channel].dsp_size    * sizeof (complex));
+	calc_buffs_txa (channel);
 
 	txa[channel].rsmpin.p = create_resample (
 		0,											// run - will be turned on below if needed
@@ -86,7 +145,7 @@ void create_txa (int channel)
 		0.100,										// averaging time constant
 		0.100,										// peak decay time constant
 		txa[channel].meter,							// result vector
-		txa[channel].pmtupdate,						// locks for meter access
+		&txa[channel].mseq,							// meter sequence count
 		TXA_MIC_AV,									// index for average value
 		TXA_MIC_PK,									// index for peak value
 		-1,											// index for gain value
@@ -136,7 +195,7 @@ void create_txa (int channel)
 		0.100,										// averaging time constant
 		0.100,										// peak decay time constant
 		txa[channel].meter,							// result vector
-		txa[channel].pmtupdate,						// locks for meter access
+		&txa[channel].mseq,							// meter sequence count
 		TXA_EQ_AV,									// index for average value
 		TXA_EQ_PK,									// index for peak value
 		-1,											// index for gain value
@@ -189,7 +248,7 @@ void create_txa (int channel)
 		0.100,										// averaging time constant
 		0.100,										// peak decay time constant
 		txa[channel].meter,							// result vector
-		txa[channel].pmtupdate,						// locks for meter access
+		&txa[channel].mseq,							// meter sequence count
 		TXA_LVLR_AV,								// index for average value
 		TXA_LVLR_PK,								// index for peak value
 		TXA_LVLR_GAIN,								// index for gain value
@@ -230,7 +289,7 @@ void create_txa (int channel)
 		0.100,										// averaging time constant
 		0.100,										// peak decay time constant
 		txa[channel].meter,							// result vector
-		txa[channel].pmtupdate,						// locks for meter access
+		&txa[channel].mseq,							// meter sequence count
 		TXA_CFC_AV,									// index for average value
 		TXA_CFC_PK,									// index for peak value
 		TXA_CFC_GAIN,								// index for gain value
@@ -302,7 +361,7 @@ void create_txa (int channel)
 		0.100,										// averaging time constant
 		0.100,										// peak decay time constant
 		txa[channel].meter,							// result vector
-		txa[channel].pmtupdate,						// locks for meter access
+		&txa[channel].mseq,							// meter sequence count
 		TXA_COMP_AV,								// index for average value
 		TXA_COMP_PK,								// index for peak value
 		-1,											// index for gain value
@@ -385,7 +444,7 @@ void create_txa (int channel)
 		0.100,										// averaging time constant
 		0.100,										// peak decay time constant
 		txa[channel].meter,							// result vector
-		txa[channel].pmtupdate,						// locks for meter access
+		&txa[channel].mseq,							// meter sequence count
 		TXA_ALC_AV,									// index for average value
 		TXA_ALC_PK,									// index for peak value
 		TXA_ALC_GAIN,								// index for gain value
@@ -468,7 +527,7 @@ void create_txa (int channel)
 		0.100,										// averaging time constant
 		0.100,										// peak decay time constant
 		txa[channel].meter,							// result vector
-		txa[channel].pmtupdate,						// locks for meter access
+		&txa[channel].mseq,							// meter sequence count
 		TXA_OUT_AV,									// index for average value
 		TXA_OUT_PK,									// index for peak value
 		-1,											// index for gain value
@@ -512,9 +571,7 @@ void destroy_txa (int channel)
 	destroy_panel (txa[channel].panel.p);
 	destroy_gen (txa[channel].gen0.p);
 	destroy_resample (txa[channel].rsmpin.p);
-	_aligned_free (txa[channel].midbuff);
-	_aligned_free (txa[channel].outbuff);
-	_aligned_free (txa[channel].inbuff);
+	decalc_buffs_txa (channel);
 }
 
 void flush_txa (int channel)
@@ -554,14 +611,94 @@ void flush_txa (int channel)
 	flush_meter (txa[channel].outmeter.p);
 }
 
+void xtxafront (int channel)
+{	// patch panel, phase rotator, MIC meter and downward expander capture in a single pass over midbuff;
+	//	the per-sample arithmetic is that of xpanel(), xphrot(), xmeter() and xamsqcap(), in the same order
+	PANEL p = txa[channel].panel.p;
+	PHROT r = txa[channel].phrot.p;
+	METER m = txa[channel].micmeter.p;
+	AMSQ  q = txa[channel].amsq.p;
+	double* buff = p->out;
+	int i, n, active;
+	double I, Q, gainI, gainQ, smag;
+	double np = 0.0;
+	int sI = p->inselect >> 1;
+	int sQ = p->inselect &  1;
+	if (p->in != buff || r->in != buff || r->out != buff || m->buff != buff || q->trigger != buff ||
+		r->size != p->size || m->size != p->size || q->size != p->size)
+	{
+		xpanel (p);
+		xphrot (r);
+		xmeter (m);
+		xamsqcap (q);
+		return;
+	}
+	gainI = p->gain1 * p->gain2I;
+	gainQ = p->gain1 * p->gain2Q;
+	EnterCriticalSection (&r->cs_update);
+	active = m->run && (m->prun != 0 ? *(m->prun) : 1);
+	for (i = 0; i < p->size; i++)
+	{
+		switch (p->copy)
+		{
+		case 0:	// no copy
+			I = buff[2 * i + 0] * sI;
+			Q = buff[2 * i + 1] * sQ;
+			break;
+		case 1:	// copy I to Q
+			I = buff[2 * i + 0] * sI;
+			Q = I;
+			break;
+		case 2:	// copy Q to I
+			Q = buff[2 * i + 1] * sQ;
+			I = Q;
+			break;
+		default:	// reverse
+			Q = buff[2 * i + 0] * sI;
+			I = buff[2 * i + 1] * sQ;
+			break;
+		}
+		I = gainI * I;
+		Q = gainQ * Q;
+		if (r->reverse) I = -I;
+		if (r->run)
+		{
+			r->x0[0] = I;
+			for (n = 0; n < r->nstages; n++)
+			{
+				if (n > 0) r->x0[n] = r->y0[n - 1];
+				r->y0[n]	= r->b0 * r->x0[n]
+							+ r->b1 * r->x1[n]
+							- r->a1 * r->y1[n];
+				r->y1[n] = r->y0[n];
+				r->x1[n] = r->x0[n];
+			}
+			I = r->y0[r->nstages - 1];
+		}
+		buff[2 * i + 0] = I;
+		buff[2 * i + 1] = Q;
+		if (active)
+		{
+			smag = I * I + Q * Q;
+			m->avg = m->avg * m->mult_average + (1.0 - m->mult_average) * smag;
+			m->peak *= m->mult_peak;
+			if (smag > np) np = smag;
+		}
+		if (q->run)
+		{
+			q->trigsig[2 * i + 0] = I;
+			q->trigsig[2 * i + 1] = Q;
+		}
+	}
+	results_meter (m, active, np);
+	LeaveCriticalSection (&r->cs_update);
+}
+
 void xtxa (int channel)
 {
 	xresample (txa[channel].rsmpin.p);				// input resampler
 	xgen (txa[channel].gen0.p);						// input signal generator
-	xpanel (txa[channel].panel.p);					// includes MIC gain
-	xphrot (txa[channel].phrot.p);					// phase rotator
-	xmeter (txa[channel].micmeter.p);				// MIC meter
-	xamsqcap (txa[channel].amsq.p);					// downward expander capture
+	xtxafront (channel);							// MIC gain, phase rotator, MIC meter, expander capture
 	xamsq (txa[channel].amsq.p);					// downward expander action
 	xeqp (txa[channel].eqp.p);						// pre-EQ
 	xmeter (txa[channel].eqmeter.p);				// EQ meter
@@ -594,10 +731,8 @@ void xtxa (int channel)
 void setInputSamplerate_txa (int channel)
 {
 	// buffers
-	_aligned_free (txa[channel].inbuff);
-	txa[channel].inbuff = (double *)malloc0(1 * ch[channel].dsp_insize  * sizeof(complex));
+	calc_iobuffs_txa (channel);
 	// input resampler
-	setBuffers_resample (txa[channel].rsmpin.p, txa[channel].inbuff, txa[channel].midbuff);
 	setSize_resample (txa[channel].rsmpin.p, ch[channel].dsp_insize);
 	setInRate_resample (txa[channel].rsmpin.p, ch[channel].in_rate);
 	TXAResCheck (channel);
@@ -606,16 +741,13 @@ void setInputSamplerate_txa (int channel)
 void setOutputSamplerate_txa (int channel)
 {
 	// buffers
-	_aligned_free (txa[channel].outbuff);
-	txa[channel].outbuff = (double *)malloc0(1 * ch[channel].dsp_outsize * sizeof(complex));
+	calc_iobuffs_txa (channel);
 	// cfir - needs to know input rate of firmware CIC
 	setOutRate_cfir (txa[channel].cfir.p, ch[channel].out_rate);
 	// output resampler
-	setBuffers_resample (txa[channel].rsmpout.p, txa[channel].midbuff, txa[channel].outbuff);
 	setOutRate_resample (txa[channel].rsmpout.p, ch[channel].out_rate);
 	TXAResCheck (channel);
 	// output meter
-	setBuffers_meter (txa[channel].outmeter.p, txa[channel].outbuff);
 	setSize_meter (txa[channel].outmeter.p, ch[channel].dsp_outsize);
 	setSamplerate_meter (txa[channel].outmeter.p, ch[channel].out_rate);
 }
@@ -623,12 +755,8 @@ void setOutputSamplerate_txa (int channel)
 void setDSPSamplerate_txa (int channel)
 {
 	// buffers
-	_aligned_free (txa[channel].inbuff);
-	txa[channel].inbuff = (double *)malloc0(1 * ch[channel].dsp_insize  * sizeof(complex));
-	_aligned_free (txa[channel].outbuff);
-	txa[channel].outbuff = (double *)malloc0(1 * ch[channel].dsp_outsize * sizeof(complex));
+	calc_iobuffs_txa (channel);
 	// input resampler
-	setBuffers_resample (txa[channel].rsmpin.p, txa[channel].inbuff, txa[channel].midbuff);
 	setSize_resample (txa[channel].rsmpin.p, ch[channel].dsp_insize);
 	setOutRate_resample (txa[channel].rsmpin.p, ch[channel].dsp_rate);
 	// dsp_rate blocks
@@ -660,23 +788,17 @@ void setDSPSamplerate_txa (int channel)
 	setSamplerate_iqc (txa[channel].iqc.p0, ch[channel].dsp_rate);
 	setSamplerate_cfir (txa[channel].cfir.p, ch[channel].dsp_rate);
 	// output resampler
-	setBuffers_resample (txa[channel].rsmpout.p, txa[channel].midbuff, txa[channel].outbuff);
 	setInRate_resample (txa[channel].rsmpout.p, ch[channel].dsp_rate);
 	TXAResCheck (channel);
 	// output meter
-	setBuffers_meter (txa[channel].outmeter.p, txa[channel].outbuff);
 	setSize_meter (txa[channel].outmeter.p, ch[channel].dsp_outsize);
 }
 
 void setDSPBuffsize_txa (int channel)
 {
 	// buffers
-	_aligned_free (txa[channel].inbuff);
-	txa[channel].inbuff = (double *)malloc0(1 * ch[channel].dsp_insize  * sizeof(complex));
-	_aligned_free (txa[channel].midbuff);
-	txa[channel].midbuff = (double *)malloc0(2 * ch[channel].dsp_size * sizeof(complex));
-	_aligned_free (txa[channel].outbuff);
-	txa[channel].outbuff = (double *)malloc0(1 * ch[channel].dsp_outsize * sizeof(complex));
+	decalc_buffs_txa (channel);
+	calc_buffs_txa (channel);
 	// input resampler
 	setBuffers_resample (txa[channel].rsmpin.p, txa[channel].inbuff, txa[channel].midbuff);
 	setSize_resample (txa[channel].rsmpin.p, ch[channel].dsp_insize);
@@ -741,6 +863,7 @@ void setDSPBuffsize_txa (int channel)
 	// output meter
 	setBuffers_meter (txa[channel].outmeter.p, txa[channel].outbuff);
 	setSize_meter (txa[channel].outmeter.p, ch[channel].dsp_outsize);
+	TXAIOPlan (channel);
 }
 
 /********************************************************************************************************
@@ -814,6 +937,19 @@ void TXAResCheck (int channel)
 	a = txa[channel].rsmpout.p;
 	if (ch[channel].dsp_rate != ch[channel].out_rate)	a->run = 1;
 	else												a->run = 0;
+	TXAIOPlan (channel);
+}
+
+void TXAIOPlan (int channel)
+{	// a bypassed resampler would only copy between midbuff and inbuff / outbuff; instead, dexchange()
+	//	exchanges directly with midbuff and the output meter reads it there
+	double* in  = txa[channel].rsmpin.p->run  ? txa[channel].inbuff  : txa[channel].midbuff;
+	double* out = txa[channel].rsmpout.p->run ? txa[channel].outbuff : txa[channel].midbuff;
+	setBuffers_resample (txa[channel].rsmpin.p, in, txa[channel].midbuff);
+	setBuffers_resample (txa[channel].rsmpout.p, txa[channel].midbuff, out);
+	setBuffers_meter (txa[channel].outmeter.p, out);
+	txa[channel].exin  = in;
+	txa[channel].exout = out;
 }
 
 int TXAUslewCheck (int channel)
@@ -826,9 +962,13 @@ int TXAUslewCheck (int channel)
 
 void TXASetupBPFilters (int channel)
 {
-	txa[channel].bp0.p->run = 1;
-	txa[channel].bp1.p->run = 0;
-	txa[channel].bp2.p->run = 0;
+	if (!DeferChannelUpdate (channel, TXA_UPD_BPF))
+		TXACalcBPFilters (channel, 1);
+}
+
+void TXACalcBPFilters (int channel, int update)
+{	// with update == 0 only the new masks are computed; the run flags and masks switch when called again with update == 1
+	int run1 = 0, run2 = 0;
 	switch (txa[channel].mode)
 	{
 	case TXA_LSB:
@@ -839,15 +979,15 @@ void TXASetupBPFilters (int channel)
 	case TXA_DIGU:
 	case TXA_SPEC:
 	case TXA_DRM:
-		CalcBandpassFilter (txa[channel].bp0.p, txa[channel].f_low, txa[channel].f_high, 2.0);
+		CalcBandpassFilter (txa[channel].bp0.p, txa[channel].f_low, txa[channel].f_high, 2.0, update);
 		if (txa[channel].compressor.p->run)
 		{
-			CalcBandpassFilter (txa[channel].bp1.p, txa[channel].f_low, txa[channel].f_high, 2.0);
-			txa[channel].bp1.p->run = 1;
+			CalcBandpassFilter (txa[channel].bp1.p, txa[channel].f_low, txa[channel].f_high, 2.0, update);
+			run1 = 1;
 			if (txa[channel].osctrl.p->run)
 			{
-				CalcBandpassFilter (txa[channel].bp2.p, txa[channel].f_low, txa[channel].f_high, 1.0);
-				txa[channel].bp2.p->run = 1;
+				CalcBandpassFilter (txa[channel].bp2.p, txa[channel].f_low, txa[channel].f_high, 1.0, update);
+				run2 = 1;
 			}
 		}
 		break;
@@ -857,47 +997,53 @@ void TXASetupBPFilters (int channel)
 	case TXA_FM:
 		if (txa[channel].compressor.p->run)
 		{
-			CalcBandpassFilter (txa[channel].bp0.p, 0.0, txa[channel].f_high, 2.0);
-			CalcBandpassFilter (txa[channel].bp1.p, 0.0, txa[channel].f_high, 2.0);
-			txa[channel].bp1.p->run = 1;
+			CalcBandpassFilter (txa[channel].bp0.p, 0.0, txa[channel].f_high, 2.0, update);
+			CalcBandpassFilter (txa[channel].bp1.p, 0.0, txa[channel].f_high, 2.0, update);
+			run1 = 1;
 			if (txa[channel].osctrl.p->run)
 			{
-				CalcBandpassFilter (txa[channel].bp2.p, 0.0, txa[channel].f_high, 1.0);
-				txa[channel].bp2.p->run = 1;
+				CalcBandpassFilter (txa[channel].bp2.p, 0.0, txa[channel].f_high, 1.0, update);
+				run2 = 1;
 			}
 		}
 		else
 		{
-			CalcBandpassFilter (txa[channel].bp0.p, txa[channel].f_low, txa[channel].f_high, 1.0);
+			CalcBandpassFilter (txa[channel].bp0.p, txa[channel].f_low, txa[channel].f_high, 1.0, update);
 		}
 		break;
 	case TXA_AM_LSB:
-		CalcBandpassFilter (txa[channel].bp0.p, -txa[channel].f_high, 0.0, 2.0);
+		CalcBandpassFilter (txa[channel].bp0.p, -txa[channel].f_high, 0.0, 2.0, update);
 		if (txa[channel].compressor.p->run)
 		{
-			CalcBandpassFilter (txa[channel].bp1.p, -txa[channel].f_high, 0.0, 2.0);
-			txa[channel].bp1.p->run = 1;
+			CalcBandpassFilter (txa[channel].bp1.p, -txa[channel].f_high, 0.0, 2.0, update);
+			run1 = 1;
 			if (txa[channel].osctrl.p->run)
 			{
-				CalcBandpassFilter (txa[channel].bp2.p, -txa[channel].f_high, 0.0, 1.0);
-				txa[channel].bp2.p->run = 1;
+				CalcBandpassFilter (txa[channel].bp2.p, -txa[channel].f_high, 0.0, 1.0, update);
+				run2 = 1;
 			}
 		}
 		break;
 	case TXA_AM_USB:
-		CalcBandpassFilter (txa[channel].bp0.p, 0.0, txa[channel].f_high, 2.0);
+		CalcBandpassFilter (txa[channel].bp0.p, 0.0, txa[channel].f_high, 2.0, update);
 		if (txa[channel].compressor.p->run)
 		{
-			CalcBandpassFilter (txa[channel].bp1.p, 0.0, txa[channel].f_high, 2.0);
-			txa[channel].bp1.p->run = 1;
+			CalcBandpassFilter (txa[channel].bp1.p, 0.0, txa[channel].f_high, 2.0, update);
+			run1 = 1;
 			if (txa[channel].osctrl.p->run)
 			{
-				CalcBandpassFilter (txa[channel].bp2.p, 0.0, txa[channel].f_high, 1.0);
-				txa[channel].bp2.p->run = 1;
+				CalcBandpassFilter (txa[channel].bp2.p, 0.0, txa[channel].f_high, 1.0, update);
+				run2 = 1;
 			}
 		}
 		break;
 	}
+	if (update)
+	{
+		txa[channel].bp0.p->run = 1;
+		txa[channel].bp1.p->run = run1;
+		txa[channel].bp2.p->run = run2;
+	}
 }
 
 /********************************************************************************************************
@@ -933,3 +1079,75 @@ void SetTXAFMAFFilter (int channel, double low, double high)
 	SetTXAFMPreEmphFreqs (channel, low, high);
 	SetTXAFMAFFreqs (channel, low, high);
 }
+
+/********************************************************************************************************
+*																										*
+*											Parameter Batches											*
+*																										*
+********************************************************************************************************/
+
+void designBatch_txa (int channel, int dirty)
+{	// new masks for the filters whose design a batch deferred; they are not yet in use
+	if (dirty & TXA_UPD_BPF)
+		TXACalcBPFilters (channel, 0);
+	if (dirty & TXA_UPD_EQP)
+	{
+		EQP a = txa[channel].eqp.p;
+		double* impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
+		setImpulse_fircore (a->p, impulse, 0);
+		_aligned_free (impulse);
+	}
+}
+
+void applyBatch_txa (int channel, int dirty)
+{	// called with csDSP held
+	if (dirty & TXA_UPD_BPF)
+	{
+		TXACalcBPFilters (channel, 1);					// filters are already current; this sets the run flags
+		setUpdate_fircore (txa[channel].bp0.p->p);
+		setUpdate_fircore (txa[channel].bp1.p->p);
+		setUpdate_fircore (txa[channel].bp2.p->p);
+	}
+	if (dirty & TXA_UPD_EQP)
+		setUpdate_fircore (txa[channel].eqp.p->p);
+}
+
+/********************************************************************************************************
+*																										*
+*										Deferred Block Construction										*
+*																										*
+********************************************************************************************************/
+
+// CFCOMP allocates its internals only when first switched on; see the RXA counterparts.
+
+PORT
+void TXAPrewarm (int channel)
+{
+	stage_cfcomp (txa[channel].cfcomp.p, &ch[channel].csDSP);
+}
+
+PORT
+void SetTXALazyRelease (int channel, double seconds)
+{
+	EnterCriticalSection (&ch[channel].csDSP);
+	txa[channel].lazy.trelease = seconds;
+	LeaveCriticalSection (&ch[channel].csDSP);
+}
+
+PORT
+void TXAReleaseIdle (int channel)
+{
+	CFCOMP cfcomp = txa[channel].cfcomp.p;
+	LARGE_INTEGER now, freq;
+	double tmin;
+	QueryPerformanceFrequency (&freq);
+	QueryPerformanceCounter (&now);
+	EnterCriticalSection (&ch[channel].csDSP);
+	if (txa[channel].lazy.trelease >= 0.0)
+	{
+		tmin = txa[channel].lazy.trelease * (double)freq.QuadPart;
+		if (cfcomp->live && !cfcomp->run && (double)(now.QuadPart - cfcomp->toff.QuadPart) >= tmin)
+			release_cfcomp (cfcomp);
+	}
+	LeaveCriticalSection (&ch[channel].csDSP);
+}
@@ -68,16 +68,26 @@ enum txaMeterType
 	TXA_METERTYPE_LAST
 };
 
+enum txaUpdate
+{	// filter designs a parameter batch defers to CommitChannelUpdate()
+	TXA_UPD_BPF    = 0x01,
+	TXA_UPD_EQP    = 0x02
+};
+
 struct _txa
 {
+	ARENA arena;				// midbuff, then inbuff and outbuff; 0 if they fell back to the heap
+	int iomark;					// arena offset of inbuff
 	double* inbuff;
 	double* outbuff;
 	double* midbuff;
+	double* exin;				// buffer dexchange() fills:  inbuff, or midbuff when the input resampler is bypassed
+	double* exout;				// buffer dexchange() drains:  outbuff, or midbuff when the output resampler is bypassed
 	int mode;
 	double f_low;
 	double f_high;
 	double meter[TXA_METERTYPE_LAST];
-	CRITICAL_SECTION* pmtupdate[TXA_METERTYPE_LAST];
+	volatile long mseq;			// meter sequence count, odd while a meter is publishing
 	struct
 	{
 		METER p;
@@ -160,6 +170,10 @@ struct _txa
 	{
 		CFIR p;
 	} cfir;
+	struct
+	{
+		double trelease;		// seconds a switched-off block stays allocated; < 0.0 for never
+	} lazy;
 };
 
 extern struct _txa txa[];
@@ -172,6 +186,8 @@ extern void flush_txa (int channel);
 
 extern void xtxa (int channel);
 
+extern void xtxafront (int channel);
+
 extern int TXAUslewCheck (int channel);
 
 extern void setInputSamplerate_txa (int channel);
@@ -182,12 +198,26 @@ extern void setDSPSamplerate_txa (int channel);
 
 extern void setDSPBuffsize_txa (int channel);
 
+extern void designBatch_txa (int channel, int dirty);
+
+extern void applyBatch_txa (int channel, int dirty);
+
 // TXA Properties
 
 extern __declspec (dllexport) void SetTXAMode (int channel, int mode);
 
 extern void TXAResCheck (int channel);
 
+extern void TXAIOPlan (int channel);
+
 extern void TXASetupBPFilters (int channel);
 
+extern void TXACalcBPFilters (int channel, int update);
+
+extern __declspec (dllexport) void TXAPrewarm (int channel);
+
+extern __declspec (dllexport) void SetTXALazyRelease (int channel, double seconds);
+
+extern __declspec (dllexport) void TXAReleaseIdle (int channel);
+
 #endif
\ No newline at end of file
@@ -557,6 +557,12 @@ void stitch(int disp)
 	DP a = pdisp[disp];
 	int i, j, k, n, m;
 	double* ptr;
+	WFHIST h;
+	DSHMPUB pub;
+
+	InterlockedIncrement (&a->stitch_users);			// pins 'hist' and 'shm' until this stitch is done with them
+	h = a->hist;
+	pub = a->shm;
 
 	// stitch
 	m = 0;
@@ -589,7 +595,11 @@ void stitch(int disp)
 		avenger (a->av_mode[i], a->num_pixels, &a->avail_frames[i], a->num_average[i], &a->av_in_idx[i], &a->av_out_idx[i],
 			a->av_backmult[i], a->scale, a->t_pixels[i], a->av_sum[i], a->av_buff[i], a->cd, a->normalize[i], a->norm_oneHz,
 			a->pixels[i][a->w_pix_buff[i]]);
+		if (h && (h->pixout == i))		// under ResampleSection so that rows are appended in time order
+			xwfhist (h, a->num_pixels, a->f_min, a->f_max, a->pixels[i][a->w_pix_buff[i]]);
 		LeaveCriticalSection(&a->ResampleSection);
+		if (pub && (pub->d->pixout == i))
+			xdshmpub (pub, a->num_pixels, a->f_min, a->f_max, a->pixels[i][a->w_pix_buff[i]]);
 
 		EnterCriticalSection(&a->PB_ControlsSection[i]);
 			a->last_pix_buff[i] = a->w_pix_buff[i];	
@@ -597,6 +607,7 @@ void stitch(int disp)
 		LeaveCriticalSection(&a->PB_ControlsSection[i]);
 		InterlockedBitTestAndSet(&(a->pb_ready[i][a->last_pix_buff[i]]), 0);
 	}
+	InterlockedDecrement (&a->stitch_users);
 }
 
 DWORD WINAPI spectra (void *pargs)
@@ -607,12 +618,6 @@ DWORD WINAPI spectra (void *pargs)
 	int LO = ((int)(uintptr_t)pargs) & 15;
 	DP a = pdisp[disp];
 
-	if (a->stop)
-	{
-		InterlockedDecrement(a->pnum_threads);
-		return 0;
-	}
-
 	if ((ss >= a->begin_ss) && (ss <= a->end_ss))
 	{
 		for (i = 0; i < a->size; i++)
@@ -621,18 +626,7 @@ DWORD WINAPI spectra (void *pargs)
 			if(++a->IQO_idx[ss][LO] >= a->bsize)
 				 a->IQO_idx[ss][LO] -= a->bsize;
 		}
-
-		if (a->stop)
-		{
-			InterlockedDecrement(a->pnum_threads);
-			return 0;
-		}
-		fftw_execute (a->plan[ss][LO]);
-	}
-	if (a->stop)
-	{
-		InterlockedDecrement(a->pnum_threads);
-		return 0;
+		fftw_execute_dft_r2c (a->pc->plan, a->fft_in[ss][LO], a->fft_out[ss][LO]);
 	}
 
 	EnterCriticalSection(&(a->EliminateSection[ss]));
@@ -676,12 +670,6 @@ DWORD WINAPI Cspectra (void *pargs)
 	DP a = pdisp[disp];
 	int trans_size = a->size * sizeof(double);
 
-	if (a->stop)
-	{
-		InterlockedDecrement(a->pnum_threads);
-		return 0;
-	}
-
 	if ((ss >= a->begin_ss) && (ss <= a->end_ss))
 	{
 		for (i = 0; i < a->size; i++)
@@ -691,18 +679,7 @@ DWORD WINAPI Cspectra (void *pargs)
 			if(++a->IQO_idx[ss][LO] >= a->bsize)
 				 a->IQO_idx[ss][LO] -= a->bsize;
 		}
-
-		if (a->stop)
-		{
-			InterlockedDecrement(a->pnum_threads);
-			return 0;
-		}
-		fftw_execute (a->Cplan[ss][LO]);
-	}
-	if (a->stop)
-	{
-		InterlockedDecrement(a->pnum_threads);
-		return 0;
+		fftw_execute_dft (a->pc->Cplan, a->Cfft_in[ss][LO], a->fft_out[ss][LO]);
 	}
 
 	if (InterlockedBitTestAndReset(&(a->snap[ss][LO]), 0))
@@ -886,6 +863,12 @@ void __cdecl sendbuf(void *arg)
 	DP a = pdisp[(int)(uintptr_t)arg];
 	while(!a->end_dispatcher)
 	{
+		if (a->hold)
+		{	// SetAnalyzer() is reconfiguring; wait here rather than ending the thread
+			SetEvent (a->hHeld);
+			WaitForSingleObject (a->hResume, INFINITE);
+			continue;
+		}
 		for (a->ss = 0; a->ss < a->num_stitch; a->ss++)
 			for (a->LO = 0; a->LO < a->num_fft; a->LO++)
 			{
@@ -919,7 +902,7 @@ void __cdecl sendbuf(void *arg)
 void CalcBandwidthNormalization (DP a)
 {
 	double bin_width;
-	bin_width = (double)a->sample_rate / (double)a->size;
+	bin_width = (double)a->sample_rate / ((double)a->size * (double)a->zoom);
 	a->norm_oneHz = 10.0 * mlog10 (1.0 / bin_width);
 }
 
@@ -995,6 +978,216 @@ void ResetPixelBuffers(int disp)
 	LeaveCriticalSection(&a->SetAnalyzerSection);
 }
 
+void calc_zoom (DP a, int flip, int *sz, int bf_sz, int *ovrlp, int clp, double *fscL, double *fscH, int *max_w)
+{	// use the largest decimation whose smaller fft still holds the span within the decimators' passband
+	int i, n, m, kc;
+	double p;
+	double kL = -0.5 * (double)*sz + 1.0 + (double)clp + *fscL;		// first and last bins of the span, relative to DC
+	double kH = +0.5 * (double)*sz - 1.0 - (double)clp - *fscH;
+	kc = (int)floor (0.5 * (kL + kH) + 0.5);
+	for (n = 0; (n < dMAX_ZOOM_STAGES) && ((2 << n) <= a->zoom_max); n++)
+	{
+		m = *sz >> (n + 1);
+		if ((*sz % (2 << n)) || (bf_sz % (2 << n)) ||
+			(kL - kc < -0.5 * dZOOM_SPAN * m) || (kH - kc > 0.5 * dZOOM_SPAN * m) ||
+			(kL - kc + 0.5 * m - 1.0 - clp < 0.0) || (0.5 * m - 1.0 - clp - (kH - kc) < 0.0))
+			break;
+	}
+	if (n == 0) return;
+	a->zoom_stages = n;
+	a->zoom = 1 << n;
+	a->zbuff = (double *) malloc0 (bf_sz * sizeof (complex));
+	a->zI = (dINREAL *) malloc0 (bf_sz * sizeof (dINREAL));
+	a->zQ = (dINREAL *) malloc0 (bf_sz * sizeof (dINREAL));
+	// shift is in bins at the full fft size; with a high-side LO the bins are read out reversed
+	a->zshift = create_shift (1, bf_sz, a->zbuff, a->zbuff, *sz, flip ? (double)kc : (double)(-kc));
+	for (i = 0; i < n; i++)
+	{	// passband edge p, relative to this stage's input rate; the stopband starts at 0.5 - p
+		p = 0.25 * dZOOM_SPAN * (double)(1 << i) / (double)(1 << (n - 1));
+		a->zdecim[i] = create_resample (1, bf_sz >> i, a->zbuff, a->zbuff, 2, 1, 0.5, (int)(12.0 / (0.5 - 2.0 * p)), 1.0);
+	}
+	m = *sz >> n;
+	*fscL = kL - kc + 0.5 * m - 1.0 - clp;
+	*fscH = 0.5 * m - 1.0 - clp - (kH - kc);
+	*ovrlp /= a->zoom;
+	*max_w /= a->zoom;
+	*sz = m;
+}
+
+void decalc_zoom (DP a)
+{
+	int i;
+	if (a->zoom > 1)
+	{
+		for (i = 0; i < a->zoom_stages; i++)
+			destroy_resample (a->zdecim[i]);
+		destroy_shift (a->zshift);
+		_aligned_free (a->zQ);
+		_aligned_free (a->zI);
+		_aligned_free (a->zbuff);
+	}
+	a->zoom = 1;
+	a->zoom_stages = 0;
+}
+
+void xzoom (DP a, dINREAL *pI, dINREAL *pQ)
+{	// zbuff holds buff_size input samples; store_size decimated samples go out to pI/pQ
+	int i;
+	xshift (a->zshift);
+	for (i = 0; i < a->zoom_stages; i++)
+		xresample (a->zdecim[i]);
+	for (i = 0; i < a->store_size; i++)
+	{
+		pI[i] = (dINREAL)a->zbuff[2 * i + 0];
+		pQ[i] = (dINREAL)a->zbuff[2 * i + 1];
+	}
+}
+
+void retire_plans (DP a, DPLAN p)
+{	// called under PlanSection; the plans are destroyed by the next holder of the planner lock
+	if (p->plan != p->iplan)	a->retired[a->nretired++] = p->plan;
+	if (p->Cplan != p->iCplan)	a->retired[a->nretired++] = p->Cplan;
+	if (!p->borrowed)
+	{
+		a->retired[a->nretired++] = p->iplan;
+		a->retired[a->nretired++] = p->iCplan;
+	}
+	memset (p, 0, sizeof (dplan));
+}
+
+void destroy_retired (DP a)
+{	// called holding the planner lock
+	while (a->nretired)
+		fftw_destroy_plan (a->retired[--a->nretired]);
+}
+
+void __cdecl measure_plans (void *arg)
+{	// replaces estimated plans with FFTW_PATIENT plans, current size first, while the workers keep running
+	DP a = (DP)arg;
+	int i;
+	DPLAN p;
+	fftw_plan plan, Cplan;
+	double *in        = (double *) fftw_malloc (sizeof (double) * a->max_size);
+	fftw_complex *Cin = (fftw_complex *) fftw_malloc (sizeof (fftw_complex) * a->max_size);
+	fftw_complex *out = (fftw_complex *) fftw_malloc (sizeof (fftw_complex) * a->max_size);
+	while (1)
+	{
+		EnterCriticalSection (&a->PlanSection);
+		p = (a->pc && !a->pc->patient) ? a->pc : 0;
+		for (i = 0; !p && (i < dPLAN_CACHE); i++)
+			if (a->pcache[i].size && !a->pcache[i].patient)
+				p = &a->pcache[i];
+		if (!p || a->end_planner)
+		{
+			a->planner = 0;
+			LeaveCriticalSection (&a->PlanSection);
+			break;
+		}
+		p->busy = 1;
+		LeaveCriticalSection (&a->PlanSection);
+		// measuring overwrites the arrays, so plan on scratch copies with the same alignment;
+		// the lock is dropped between the two so that other planners are not held off for both
+		enter_planner ();
+		plan  = fftw_plan_dft_r2c_1d (p->size, in, out, FFTW_PATIENT);
+		leave_planner ();
+		enter_planner ();
+		Cplan = fftw_plan_dft_1d (p->size, Cin, out, FFTW_FORWARD, FFTW_PATIENT);
+		leave_planner ();
+		EnterCriticalSection (&a->PlanSection);
+		InterlockedExchangePointer ((void * volatile *)&p->plan, plan);
+		InterlockedExchangePointer ((void * volatile *)&p->Cplan, Cplan);
+		p->patient = 1;
+		p->busy = 0;
+		if (a->nretired && try_enter_planner ())
+		{
+			destroy_retired (a);
+			leave_planner ();
+		}
+		LeaveCriticalSection (&a->PlanSection);
+	}
+	fftw_free (out);
+	fftw_free (Cin);
+	fftw_free (in);
+	_endthread();
+}
+
+DPLAN get_plans (DP a, int size)
+{	// called with the workers drained; cached sizes cost nothing, new sizes are estimated and measured later
+	int i, k = -1, e = -1, locked;
+	DPLAN p;
+	EnterCriticalSection (&a->PlanSection);
+	a->pcount++;
+	for (i = 0; i < dPLAN_CACHE; i++)
+		if (a->pcache[i].size == size)
+		{
+			p = &a->pcache[i];
+			p->used = a->pcount;
+			a->pc = p;
+			LeaveCriticalSection (&a->PlanSection);
+			return p;
+		}
+	for (i = 0; i < dPLAN_CACHE; i++)		// a free slot, else the least recently used one not being measured
+		if (!a->pcache[i].busy && ((k < 0) || (a->pcache[i].used < a->pcache[k].used)))
+			k = i;
+	for (i = 0; i < dEST_PLANS; i++)
+		if (a->eplan[i] && (size == (1 << i)))
+			e = i;
+	p = &a->pcache[k];
+	// a measurement or a filter design elsewhere may hold the planner lock for a long time; rather than wait
+	// for it, borrow the premade estimate and leave the evicted plans to be destroyed later
+	locked = try_enter_planner ();
+	if (!locked && ((e < 0) || (a->nretired + 4 > dRETIRED_PLANS)))
+	{
+		enter_planner ();
+		locked = 1;
+	}
+	if (locked)
+		destroy_retired (a);
+	if (p->size)
+		retire_plans (a, p);
+	p->size = size;
+	p->used = a->pcount;
+	if (locked)
+	{
+		destroy_retired (a);
+		// WDSPwisdom() covers the power-of-two display sizes, so these rarely fall through to estimates
+		p->iplan  = fftw_plan_dft_r2c_1d (size, a->fft_in[0][0], a->fft_out[0][0], FFTW_PATIENT | FFTW_WISDOM_ONLY);
+		p->iCplan = fftw_plan_dft_1d (size, a->Cfft_in[0][0], a->fft_out[0][0], FFTW_FORWARD, FFTW_PATIENT | FFTW_WISDOM_ONLY);
+		p->patient = p->iplan && p->iCplan;
+		if (!p->patient && (e >= 0))
+		{	// the premade estimates will do until the size is measured
+			if (p->iplan)	fftw_destroy_plan (p->iplan);
+			if (p->iCplan)	fftw_destroy_plan (p->iCplan);
+			p->iplan  = 0;
+			p->iCplan = 0;
+		}
+		if (!p->patient && (e < 0))
+		{
+			if (!p->iplan)
+				p->iplan  = fftw_plan_dft_r2c_1d (size, a->fft_in[0][0], a->fft_out[0][0], FFTW_ESTIMATE);
+			if (!p->iCplan)
+				p->iCplan = fftw_plan_dft_1d (size, a->Cfft_in[0][0], a->fft_out[0][0], FFTW_FORWARD, FFTW_ESTIMATE);
+		}
+		leave_planner ();
+	}
+	if (!p->iplan)
+	{
+		p->iplan  = a->eplan[e];
+		p->iCplan = a->eCplan[e];
+		p->borrowed = 1;
+	}
+	p->plan  = p->iplan;
+	p->Cplan = p->iCplan;
+	a->pc = p;
+	if (!p->patient && !a->planner)
+	{
+		a->planner = 1;
+		_beginthread (measure_plans, 0, (void *)a);
+	}
+	LeaveCriticalSection (&a->PlanSection);
+	return p;
+}
+
 PORT    
 void SetAnalyzer (	int disp,			// display identifier
 					int n_pixout,		// pixel output identifier
@@ -1021,12 +1214,17 @@ void SetAnalyzer (	int disp,			// display identifier
 	int i, j;
 
 	EnterCriticalSection(&a->SetAnalyzerSection);
-	a->end_dispatcher = 1;
-	while (InterlockedAnd(&a->dispatcher, 1))
-		Sleep(1);
-	a->stop = 1;
-	while (_InterlockedAnd(a->pnum_threads, 1023))
-		Sleep(1);
+	if (InterlockedAnd(&a->dispatcher, 1))
+	{
+		a->hold = 1;
+		WaitForSingleObject (a->hHeld, INFINITE);
+	}
+	while (_InterlockedAnd(a->pnum_threads, 1023))		// frames already queued finish with the old size, plans and window
+		Sleep(0);
+	decalc_zoom (a);
+	if ((a->zoom_max > 1) && (typ == 1) && (n_fft == 1) && (n_stch == 1))
+		calc_zoom (a, *flp, &sz, bf_sz, &ovrlp, clp, &fscLin, &fscHin, &max_w);
+	a->store_size = bf_sz / a->zoom;
 	a->num_pixout = n_pixout;
 	a->num_fft = n_fft;
 	a->type = typ;
@@ -1040,16 +1238,7 @@ void SetAnalyzer (	int disp,			// display identifier
 	a->num_stitch = n_stch;
 
 	if (sz != a->size)
-	{
-		for (i = 0; i < a->max_stitch; i++)
-			for (j = 0; j < a->max_num_fft; j++)
-			{
-				if (a->plan[i][j])		fftw_destroy_plan (a->plan[i][j]);
-				if (a->Cplan[i][j])		fftw_destroy_plan (a->Cplan[i][j]);
-				a->plan[i][j] = fftw_plan_dft_r2c_1d(sz, a->fft_in[i][j], a->fft_out[i][j], FFTW_PATIENT);
-				a->Cplan[i][j] = fftw_plan_dft_1d(sz, a->Cfft_in[i][j], a->fft_out[i][j], FFTW_FORWARD, FFTW_PATIENT);
-			}
-	}
+		get_plans (a, sz);
 
 	if ((sz != a->size) || (win_type != a->window_type) || (pi != a->PiAlpha))
 		new_window(disp, win_type, sz, pi);
@@ -1131,8 +1320,11 @@ void SetAnalyzer (	int disp,			// display identifier
 			a->IQout_index[i][j] = 0;
 		}
 
-	a->stop = 0;
-	a->end_dispatcher = 0;
+	if (a->hold)
+	{
+		a->hold = 0;
+		SetEvent (a->hResume);
+	}
 	LeaveCriticalSection(&a->SetAnalyzerSection);
 }
 
@@ -1155,6 +1347,10 @@ void XCreateAnalyzer(	int disp,
 	a->max_stitch = m_stitch;
 	
 	a->pnum_threads = (LONG*) malloc0 (sizeof (LONG));
+	a->zoom_max = 1 << dMAX_ZOOM_STAGES;
+	a->zoom = 1;
+	a->hHeld = CreateEvent (NULL, FALSE, FALSE, NULL);
+	a->hResume = CreateEvent (NULL, FALSE, FALSE, NULL);
 
 	for (i = 0; i < a->max_stitch; i++)
 		for (j = 0; j < a->max_num_fft; j++)
@@ -1165,6 +1361,8 @@ void XCreateAnalyzer(	int disp,
 	InitializeCriticalSectionAndSpinCount(&a->ResampleSection, 0);
 	InitializeCriticalSectionAndSpinCount(&a->SetAnalyzerSection, 0);
 	InitializeCriticalSectionAndSpinCount(&a->StitchSection, 0);
+	InitializeCriticalSectionAndSpinCount(&a->HistorySection, 0);
+	InitializeCriticalSectionAndSpinCount(&a->PlanSection, 0);
 	for (i = 0; i < dMAX_PIXOUTS; i++)
 		InitializeCriticalSectionAndSpinCount(&a->PB_ControlsSection[i], 0);
 	for (i = 0; i < dMAX_STITCH; i++)
@@ -1184,12 +1382,17 @@ void XCreateAnalyzer(	int disp,
 	for (i = 0; i < a->max_stitch; i++)
 		for (j = 0; j < a->max_num_fft; j++)
 		{
-			a->plan[i][j] = 0;
-			a->Cplan[i][j] = 0;
-			a->fft_in[i][j]   = (double*) malloc0 (sizeof(double) * a->max_size);
+			a->fft_in[i][j]   = (double*) fftw_malloc(sizeof(double) * a->max_size);
 			a->Cfft_in[i][j]  = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * a->max_size);
 			a->fft_out[i][j]  = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * a->max_size);
 		}
+	enter_planner ();
+	for (i = 1; (i < dEST_PLANS) && ((1 << i) <= a->max_size); i++)
+	{	// for get_plans() to fall back on while another thread holds the planner lock
+		a->eplan[i]  = fftw_plan_dft_r2c_1d (1 << i, a->fft_in[0][0], a->fft_out[0][0], FFTW_ESTIMATE);
+		a->eCplan[i] = fftw_plan_dft_1d (1 << i, a->Cfft_in[0][0], a->fft_out[0][0], FFTW_FORWARD, FFTW_ESTIMATE);
+	}
+	leave_planner ();
 	a->pre_av_out = (double*) malloc0 (sizeof(double) * a->max_size * a->max_stitch);
 	for (i = 0; i < dMAX_PIXOUTS; i++)
 	{
@@ -1245,6 +1448,36 @@ void DestroyAnalyzer(int disp)
 	while (InterlockedAnd(&a->dispatcher, 1))
 		Sleep(1);
 
+	EnterCriticalSection (&a->PlanSection);
+	a->end_planner = 1;
+	while (a->planner)
+	{
+		LeaveCriticalSection (&a->PlanSection);
+		Sleep(1);
+		EnterCriticalSection (&a->PlanSection);
+	}
+	LeaveCriticalSection (&a->PlanSection);
+	enter_planner ();
+	destroy_retired (a);
+	for (i = 0; i < dPLAN_CACHE; i++)
+		if (a->pcache[i].size)
+		{
+			retire_plans (a, &a->pcache[i]);
+			destroy_retired (a);
+		}
+	for (i = 0; i < dEST_PLANS; i++)
+		if (a->eplan[i])
+		{
+			fftw_destroy_plan (a->eplan[i]);
+			fftw_destroy_plan (a->eCplan[i]);
+		}
+	leave_planner ();
+
+	decalc_zoom (a);
+	if (a->hist)
+		destroy_wfhist (a->hist);
+	if (a->shm)
+		destroy_dshmpub (a->shm);
 	for (i = 0; i < a->max_stitch; i++)
 		for (j = 0; j < a->max_num_fft; j++)
 		{
@@ -1279,10 +1512,8 @@ void DestroyAnalyzer(int disp)
 	for (i = 0; i < a->max_stitch; i++)
 		for (j = 0; j < a->max_num_fft; j++)
 		{
-			fftw_destroy_plan (a->plan[i][j]);
-			fftw_destroy_plan (a->Cplan[i][j]);
 			fftw_free (a->Cfft_in[i][j]);
-			_aligned_free (a->fft_in[i][j]);
+			fftw_free (a->fft_in[i][j]);
 			fftw_free (a->fft_out[i][j]);
 		}
 	
@@ -1298,6 +1529,8 @@ void DestroyAnalyzer(int disp)
 	}
 	for (i = 0; i < dMAX_PIXOUTS; i++)
 		DeleteCriticalSection(&a->PB_ControlsSection[i]);
+	DeleteCriticalSection(&a->PlanSection);
+	DeleteCriticalSection(&a->HistorySection);
 	DeleteCriticalSection(&a->StitchSection);
 	DeleteCriticalSection(&a->SetAnalyzerSection);
 	DeleteCriticalSection(&a->ResampleSection);
@@ -1305,6 +1538,8 @@ void DestroyAnalyzer(int disp)
 	for (i = 0; i < a->max_stitch; i++)
 		for (j = 0; j < a->max_num_fft; j++)
 			CloseHandle(a->hSnapEvent[i][j]);
+	CloseHandle(a->hResume);
+	CloseHandle(a->hHeld);
 
 	_aligned_free ((void *) a->pnum_threads);
 
@@ -1413,16 +1648,34 @@ void OpenBuffer(int disp, int ss, int LO, void **Ipointer, void **Qpointer)
 {
 	DP a = pdisp[disp];
 	EnterCriticalSection(&a->SetAnalyzerSection);
-	*Ipointer = &((a->I_samples[ss][LO])[a->IQin_index[ss][LO]]);
-	*Qpointer = &((a->Q_samples[ss][LO])[a->IQin_index[ss][LO]]);
+	if (a->zoom > 1)
+	{
+		*Ipointer = a->zI;
+		*Qpointer = a->zQ;
+	}
+	else
+	{
+		*Ipointer = &((a->I_samples[ss][LO])[a->IQin_index[ss][LO]]);
+		*Qpointer = &((a->Q_samples[ss][LO])[a->IQin_index[ss][LO]]);
+	}
 	LeaveCriticalSection(&a->SetAnalyzerSection);
 }
 
 PORT   
 void CloseBuffer(int disp, int ss, int LO)
 {
+	int i;
 	DP a = pdisp[disp];
 	EnterCriticalSection(&a->SetAnalyzerSection);
+	if (a->zoom > 1)
+	{
+		for (i = 0; i < a->buff_size; i++)
+		{
+			a->zbuff[2 * i + 0] = (double)a->zI[i];
+			a->zbuff[2 * i + 1] = (double)a->zQ[i];
+		}
+		xzoom (a, &((a->I_samples[ss][LO])[a->IQin_index[ss][LO]]), &((a->Q_samples[ss][LO])[a->IQin_index[ss][LO]]));
+	}
 	EnterCriticalSection(&(a->BufferControlSection[ss][LO]));
 		if (a->have_samples[ss][LO] > a->max_writeahead)
 			{
@@ -1431,10 +1684,10 @@ void CloseBuffer(int disp, int ss, int LO)
 						a->IQout_index[ss][LO] -= a->bsize;
 				a->have_samples[ss][LO] = a->max_writeahead;
 			}
-		if ((a->have_samples[ss][LO] += a->buff_size) >= a->size)
+		if ((a->have_samples[ss][LO] += a->store_size) >= a->size)
 			InterlockedBitTestAndSet(&(a->buff_ready[ss][LO]), 0);
 	LeaveCriticalSection(&(a->BufferControlSection[ss][LO]));
-	if((a->IQin_index[ss][LO] += a->buff_size) >= a->bsize)	//REQUIRES buff_size IS A SUB-MULTIPLE OF SIZE OF INPUT SAMPLE BUFFS!
+	if((a->IQin_index[ss][LO] += a->store_size) >= a->bsize)	//REQUIRES buff_size IS A SUB-MULTIPLE OF SIZE OF INPUT SAMPLE BUFFS!
 		a->IQin_index[ss][LO] = 0;
 
 	if (!InterlockedAnd(&a->dispatcher, 1))
@@ -1450,16 +1703,29 @@ void CloseBuffer(int disp, int ss, int LO)
 PORT
 void Spectrum(int disp, int ss, int LO, dINREAL* pI, dINREAL* pQ)
 {
+	int i, zoom;
 	dINREAL *Ipointer;
 	dINREAL *Qpointer;
 	DP a = pdisp[disp];
 	EnterCriticalSection(&a->SetAnalyzerSection);
 	Ipointer = &((a->I_samples[ss][LO])[a->IQin_index[ss][LO]]);
 	Qpointer = &((a->Q_samples[ss][LO])[a->IQin_index[ss][LO]]);
+	if ((zoom = a->zoom) > 1)
+	{
+		for (i = 0; i < a->buff_size; i++)
+		{
+			a->zbuff[2 * i + 0] = (double)pI[i];
+			a->zbuff[2 * i + 1] = (double)pQ[i];
+		}
+		xzoom (a, Ipointer, Qpointer);
+	}
 	LeaveCriticalSection(&a->SetAnalyzerSection);
 
-	memcpy(Ipointer, pI, a->buff_size * sizeof(dINREAL));
-	memcpy(Qpointer, pQ, a->buff_size * sizeof(dINREAL));
+	if (zoom == 1)
+	{
+		memcpy(Ipointer, pI, a->buff_size * sizeof(dINREAL));
+		memcpy(Qpointer, pQ, a->buff_size * sizeof(dINREAL));
+	}
 
 	EnterCriticalSection(&a->SetAnalyzerSection);
 	EnterCriticalSection(&(a->BufferControlSection[ss][LO]));
@@ -1470,10 +1736,10 @@ void Spectrum(int disp, int ss, int LO, dINREAL* pI, dINREAL* pQ)
 						a->IQout_index[ss][LO] -= a->bsize;
 				a->have_samples[ss][LO] = a->max_writeahead;
 			}
-		if ((a->have_samples[ss][LO] += a->buff_size) >= a->size)
+		if ((a->have_samples[ss][LO] += a->store_size) >= a->size)
 			InterlockedBitTestAndSet(&(a->buff_ready[ss][LO]), 0);
 	LeaveCriticalSection(&(a->BufferControlSection[ss][LO]));
-	if((a->IQin_index[ss][LO] += a->buff_size) >= a->bsize)	//REQUIRES buff_size IS A SUB-MULTIPLE OF SIZE OF INPUT SAMPLE BUFFS!
+	if((a->IQin_index[ss][LO] += a->store_size) >= a->bsize)	//REQUIRES buff_size IS A SUB-MULTIPLE OF SIZE OF INPUT SAMPLE BUFFS!
 		a->IQin_index[ss][LO] = 0;
 
 	if (!InterlockedAnd(&a->dispatcher, 1))
@@ -1491,20 +1757,30 @@ void Spectrum2(int run, int disp, int ss, int LO, dINREAL* pbuff)
 {
 	if (run)
 	{
-		int i;
+		int i, zoom;
 		dINREAL *Ipointer;
 		dINREAL *Qpointer;
 		DP a = pdisp[disp];
 		EnterCriticalSection(&a->SetAnalyzerSection);
 		Ipointer = &((a->I_samples[ss][LO])[a->IQin_index[ss][LO]]);
 		Qpointer = &((a->Q_samples[ss][LO])[a->IQin_index[ss][LO]]);
-		LeaveCriticalSection(&a->SetAnalyzerSection);
-
-		for (i = 0; i < a->buff_size; i++)
+		if ((zoom = a->zoom) > 1)
 		{
-			Ipointer[i] = pbuff[2 * i + 1];
-			Qpointer[i] = pbuff[2 * i + 0];
+			for (i = 0; i < a->buff_size; i++)
+			{
+				a->zbuff[2 * i + 0] = (double)pbuff[2 * i + 1];
+				a->zbuff[2 * i + 1] = (double)pbuff[2 * i + 0];
+			}
+			xzoom (a, Ipointer, Qpointer);
 		}
+		LeaveCriticalSection(&a->SetAnalyzerSection);
+
+		if (zoom == 1)
+			for (i = 0; i < a->buff_size; i++)
+			{
+				Ipointer[i] = pbuff[2 * i + 1];
+				Qpointer[i] = pbuff[2 * i + 0];
+			}
 
 		EnterCriticalSection(&a->SetAnalyzerSection);
 		EnterCriticalSection(&(a->BufferControlSection[ss][LO]));
@@ -1515,10 +1791,10 @@ void Spectrum2(int run, int disp, int ss, int LO, dINREAL* pbuff)
 							a->IQout_index[ss][LO] -= a->bsize;
 					a->have_samples[ss][LO] = a->max_writeahead;
 				}
-			if ((a->have_samples[ss][LO] += a->buff_size) >= a->size)
+			if ((a->have_samples[ss][LO] += a->store_size) >= a->size)
 				InterlockedBitTestAndSet(&(a->buff_ready[ss][LO]), 0);
 		LeaveCriticalSection(&(a->BufferControlSection[ss][LO]));
-		if((a->IQin_index[ss][LO] += a->buff_size) >= a->bsize)	//REQUIRES buff_size IS A SUB-MULTIPLE OF SIZE OF INPUT SAMPLE BUFFS!
+		if((a->IQin_index[ss][LO] += a->store_size) >= a->bsize)	//REQUIRES buff_size IS A SUB-MULTIPLE OF SIZE OF INPUT SAMPLE BUFFS!
 			a->IQin_index[ss][LO] = 0;
 
 		if (!InterlockedAnd(&a->dispatcher, 1))
@@ -1537,20 +1813,30 @@ void Spectrum0(int run, int disp, int ss, int LO, double* pbuff)
 {
 	if (run)
 	{
-		int i;
+		int i, zoom;
 		dINREAL *Ipointer;
 		dINREAL *Qpointer;
 		DP a = pdisp[disp];
 		EnterCriticalSection(&a->SetAnalyzerSection);
 		Ipointer = &((a->I_samples[ss][LO])[a->IQin_index[ss][LO]]);
 		Qpointer = &((a->Q_samples[ss][LO])[a->IQin_index[ss][LO]]);
-		LeaveCriticalSection(&a->SetAnalyzerSection);
-
-		for (i = 0; i < a->buff_size; i++)
+		if ((zoom = a->zoom) > 1)
 		{
-			Ipointer[i] = (dINREAL)pbuff[2 * i + 1];
-			Qpointer[i] = (dINREAL)pbuff[2 * i + 0];
+			for (i = 0; i < a->buff_size; i++)
+			{
+				a->zbuff[2 * i + 0] = (double)pbuff[2 * i + 1];
+				a->zbuff[2 * i + 1] = (double)pbuff[2 * i + 0];
+			}
+			xzoom (a, Ipointer, Qpointer);
 		}
+		LeaveCriticalSection(&a->SetAnalyzerSection);
+
+		if (zoom == 1)
+			for (i = 0; i < a->buff_size; i++)
+			{
+				Ipointer[i] = (dINREAL)pbuff[2 * i + 1];
+				Qpointer[i] = (dINREAL)pbuff[2 * i + 0];
+			}
 
 		EnterCriticalSection(&a->SetAnalyzerSection);
 		EnterCriticalSection(&(a->BufferControlSection[ss][LO]));
@@ -1561,10 +1847,10 @@ void Spectrum0(int run, int disp, int ss, int LO, double* pbuff)
 					 	a->IQout_index[ss][LO] -= a->bsize;
 					a->have_samples[ss][LO] = a->max_writeahead;
 				}
-			if ((a->have_samples[ss][LO] += a->buff_size) >= a->size)
+			if ((a->have_samples[ss][LO] += a->store_size) >= a->size)
 				InterlockedBitTestAndSet(&(a->buff_ready[ss][LO]), 0);
 		LeaveCriticalSection(&(a->BufferControlSection[ss][LO]));
-		if((a->IQin_index[ss][LO] += a->buff_size) >= a->bsize)	//REQUIRES buff_size IS A SUB-MULTIPLE OF SIZE OF INPUT SAMPLE BUFFS!
+		if((a->IQin_index[ss][LO] += a->store_size) >= a->bsize)	//REQUIRES buff_size IS A SUB-MULTIPLE OF SIZE OF INPUT SAMPLE BUFFS!
 			a->IQin_index[ss][LO] = 0;
 
 		if (!InterlockedAnd(&a->dispatcher, 1))
@@ -1662,6 +1948,15 @@ void SetDisplaySampleRate (int disp, int rate)
 	}
 }
 
+PORT
+void SetDisplayMaxZoom (int disp, int max_decim)
+{	// takes effect at the next SetAnalyzer(); 1 keeps every fft at the input rate
+	DP a = pdisp[disp];
+	EnterCriticalSection (&a->SetAnalyzerSection);
+	a->zoom_max = max_decim;
+	LeaveCriticalSection (&a->SetAnalyzerSection);
+}
+
 PORT
 void SetDisplayNormOneHz (int disp, int pixout, int norm)
 {
@@ -28,6 +28,19 @@ warren@wpratt.com
 #define _analyzer_h
 #include "comm.h"
 
+typedef struct _dplan
+{
+	int size;												// fft size, 0 while the slot is free
+	int patient;											// 1 once plan/Cplan are FFTW_PATIENT plans
+	int busy;												// 1 while the planner thread is measuring this size
+	int borrowed;											// 1 when iplan/iCplan are the display's premade estimates, which the slot does not own
+	unsigned long long used;								// SetAnalyzer() count at last use, for replacement
+	fftw_plan plan;											// plans in use, executed on each (ss, LO) buffer through the new-array calls
+	fftw_plan Cplan;
+	fftw_plan iplan;										// plans made by SetAnalyzer(), from wisdom else FFTW_ESTIMATE; kept
+	fftw_plan iCplan;										//		until the slot is reused since a worker may still be executing them
+} dplan, *DPLAN;
+
 typedef struct _dp
 {
 	int max_size;											// maximum fft size to be used
@@ -92,15 +105,24 @@ typedef struct _dp
 	double (*ac1[dMAX_CAL_SETS][dMAX_M]);
 	double (*ac0[dMAX_CAL_SETS][dMAX_M]);
 
-	fftw_plan plan[dMAX_STITCH][dMAX_NUM_FFT];				// fftw plans
-	fftw_plan Cplan[dMAX_STITCH][dMAX_NUM_FFT];
+	dplan pcache[dPLAN_CACHE];								// fftw plans for the most recently used sizes
+	DPLAN pc;												// plans for the current size
+	unsigned long long pcount;								// number of plan lookups, for replacement
+	volatile int planner;									// one while the planner thread is alive
+	int end_planner;										// set to one to end the planner thread after its current size
+	fftw_plan eplan[dEST_PLANS];							// premade FFTW_ESTIMATE plans for power-of-two sizes up to max_size
+	fftw_plan eCplan[dEST_PLANS];
+	fftw_plan retired[dRETIRED_PLANS];						// evicted plans waiting for the planner lock to be destroyed
+	int nretired;
 	double *fft_in[dMAX_STITCH][dMAX_NUM_FFT];				// pointers to fftw real input vectors
 	fftw_complex *Cfft_in[dMAX_STITCH][dMAX_NUM_FFT];		// pointers to fftw complex input vectors
 	fftw_complex *fft_out[dMAX_STITCH][dMAX_NUM_FFT];		// pointers to fftw complex output vectors
 	volatile LONG *pnum_threads;							// pointer to current number of active worker threads
-	int stop;												// when set, fft threads will be returned to the pool
 	int end_dispatcher;										// set this flag to one to destroy the dispatcher thread
 	volatile int dispatcher;								// one if the dispatcher thread is alive & active
+	volatile int hold;										// set by SetAnalyzer() to park the dispatcher while reconfiguring
+	HANDLE hHeld;											// signalled by the dispatcher once it is parked
+	HANDLE hResume;											// signalled by SetAnalyzer() to release the dispatcher
 	int ss;													// sub-span being processed
 	int LO;													// LO (within current sub-span) being processed 
 	int flag;
@@ -127,6 +149,7 @@ typedef struct _dp
 	CRITICAL_SECTION StitchSection;
 	CRITICAL_SECTION EliminateSection[dMAX_STITCH];
 	CRITICAL_SECTION ResampleSection;
+	CRITICAL_SECTION PlanSection;							// guards pcache[] and pc against the planner thread
 
 	int det_type[dMAX_PIXOUTS];								// detector type
 	double inv_coherent_gain;
@@ -135,6 +158,21 @@ typedef struct _dp
 	double norm_oneHz;										// dB factor to normalize to one Hz bandwidth
 	int sample_rate;										// sample rate; used for normalization calculations
 	int normalize[dMAX_PIXOUTS];
+
+	int zoom_max;											// maximum zoom decimation; 1 disables the zoom path
+	int zoom;												// current zoom decimation; 1 when the fft runs at the input rate
+	int zoom_stages;										// number of decimate-by-two stages in use
+	int store_size;											// samples stored to I_samples[][]/Q_samples[][] per buff_size input samples
+	double *zbuff;											// zoom work buffer, buff_size complex samples
+	dINREAL *zI;											// input buffers handed out by OpenBuffer() while zoomed
+	dINREAL *zQ;
+	SHIFT zshift;											// moves the centre of the span to DC
+	RESAMPLE zdecim[dMAX_ZOOM_STAGES];						// decimate-by-two stages
+
+	WFHIST hist;											// waterfall history, null unless enabled
+	volatile long stitch_users;								// stitch() calls that may still be using 'hist' or 'shm'
+	DSHMPUB shm;											// shared-memory publication, null unless enabled
+	CRITICAL_SECTION HistorySection;
 }  dp, *DP;
 
 extern DP pdisp[];
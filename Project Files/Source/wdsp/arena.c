@@ -0,0 +1,94 @@
+/*  arena.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+
+#include "comm.h"
+
+/********************************************************************************************************
+*																										*
+*											Channel Arena												*
+*																										*
+********************************************************************************************************/
+
+// A bump allocator over a single reserved address range.  Pages are committed as the arena grows, so
+// a later, larger allocation never moves what was laid out before it; everything is released at once.
+
+ARENA create_arena (int reserve)
+{	// returns 0 if the address range cannot be reserved
+	ARENA a = (ARENA) malloc0 (sizeof (arena));
+	a->reserve = (reserve + 0xffff) & ~0xffff;
+	if ((a->base = (char *) VirtualAlloc (0, a->reserve, MEM_RESERVE, PAGE_NOACCESS)) == 0)
+	{
+		_aligned_free (a);
+		return 0;
+	}
+	a->commit = 0;
+	a->used = 0;
+	a->peak = 0;
+	return a;
+}
+
+void destroy_arena (ARENA a)
+{
+	if (a == 0) return;
+	VirtualFree (a->base, 0, MEM_RELEASE);
+	_aligned_free (a);
+}
+
+int size_arena (int size)
+{	// bytes an allocation of 'size' occupies in an arena
+	return (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+}
+
+void* alloc_arena (ARENA a, int size)
+{	// zeroed, ARENA_ALIGN aligned; returns 0 if the reservation is exhausted or pages cannot be committed
+	char* p;
+	int n = size_arena (size);
+	if (a == 0 || a->used + n > a->reserve) return 0;
+	if (a->used + n > a->commit)
+	{
+		int c = (a->used + n + 0xfff) & ~0xfff;
+		if (VirtualAlloc (a->base + a->commit, c - a->commit, MEM_COMMIT, PAGE_READWRITE) == 0) return 0;
+		a->commit = c;
+	}
+	p = a->base + a->used;
+	memset (p, 0, n);
+	a->used += n;
+	if (a->used > a->peak) a->peak = a->used;
+	return p;
+}
+
+int mark_arena (ARENA a)
+{
+	if (a == 0) return 0;
+	return a->used;
+}
+
+void rewind_arena (ARENA a, int mark)
+{	// discards everything allocated after 'mark'; committed pages are kept for reuse
+	if (a == 0) return;
+	a->used = mark;
+}
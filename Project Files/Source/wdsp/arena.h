@@ -0,0 +1,55 @@
+/*  arena.h
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+
+#ifndef _arena_h
+#define _arena_h
+
+#define ARENA_ALIGN						64					// alignment of each allocation, one cache line
+#define ARENA_RESERVE					(8 << 20)			// default address space reserved per arena, bytes
+
+typedef struct _arena
+{
+	char* base;									// reserved address range
+	int reserve;								// bytes reserved
+	int commit;									// bytes committed
+	int used;									// bytes handed out
+	int peak;									// high-water mark of 'used'
+} arena, *ARENA;
+
+extern ARENA create_arena (int reserve);
+
+extern void destroy_arena (ARENA a);
+
+extern void* alloc_arena (ARENA a, int size);
+
+extern int mark_arena (ARENA a);
+
+extern void rewind_arena (ARENA a, int mark);
+
+extern int size_arena (int size);
+
+#endif
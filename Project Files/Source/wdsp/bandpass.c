@@ -39,15 +39,19 @@ void calc_bps (BPS a)
 	a->product = (double *)malloc0(2 * a->size * sizeof(complex));
 	impulse = fir_bandpass(a->size + 1, a->f_low, a->f_high, a->samplerate, a->wintype, 1, 1.0 / (double)(2 * a->size));
 	a->mults = fftcv_mults(2 * a->size, impulse);
+	enter_planner ();
 	a->CFor = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->infilt, (fftw_complex *)a->product, FFTW_FORWARD, FFTW_PATIENT);
 	a->CRev = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->product, (fftw_complex *)a->out, FFTW_BACKWARD, FFTW_PATIENT);
+	leave_planner ();
 	_aligned_free(impulse);
 }
 
 void decalc_bps (BPS a)
 {
+	enter_planner ();
 	fftw_destroy_plan(a->CRev);
 	fftw_destroy_plan(a->CFor);
+	leave_planner ();
 	_aligned_free(a->mults);
 	_aligned_free(a->product);
 	_aligned_free(a->infilt);
@@ -361,7 +365,7 @@ void setGain_bandpass (BANDPASS a, double gain, int update)
 	_aligned_free (impulse);
 }
 
-void CalcBandpassFilter (BANDPASS a, double f_low, double f_high, double gain)
+void CalcBandpassFilter (BANDPASS a, double f_low, double f_high, double gain, int update)
 {
 	double* impulse;
 	if ((a->f_low != f_low) || (a->f_high != f_high) || (a->gain != gain))
@@ -370,7 +374,7 @@ void CalcBandpassFilter (BANDPASS a, double f_low, double f_high, double gain)
 		a->f_high = f_high;
 		a->gain = gain;
 		impulse = fir_bandpass (a->nc, a->f_low, a->f_high, a->samplerate, a->wintype, 1, a->gain / (double)(2 * a->size));
-		setImpulse_fircore (a->p, impulse, 1);
+		setImpulse_fircore (a->p, impulse, update);
 		_aligned_free (impulse);
 	}
 }
@@ -396,10 +400,13 @@ void SetRXABandpassFreqs (int channel, double f_low, double f_high)
 	BANDPASS a = rxa[channel].bp1.p;
 	if ((f_low != a->f_low) || (f_high != a->f_high))
 	{
-		impulse = fir_bandpass (a->nc, f_low, f_high, a->samplerate, 
-			a->wintype, 1, a->gain / (double)(2 * a->size));
-		setImpulse_fircore (a->p, impulse, 0);
-		_aligned_free (impulse);
+		if (!DeferChannelUpdate (channel, RXA_UPD_BP1))
+		{
+			impulse = fir_bandpass (a->nc, f_low, f_high, a->samplerate, 
+				a->wintype, 1, a->gain / (double)(2 * a->size));
+			setImpulse_fircore (a->p, impulse, 0);
+			_aligned_free (impulse);
+		}
 		EnterCriticalSection (&ch[channel].csDSP);
 		a->f_low = f_low;
 		a->f_high = f_high;
@@ -415,10 +422,13 @@ void SetRXABandpassWindow (int channel, int wintype)
 	BANDPASS a = rxa[channel].bp1.p;
 	if ((a->wintype != wintype))
 	{
-		impulse = fir_bandpass (a->nc, a->f_low, a->f_high, a->samplerate, 
-			wintype, 1, a->gain / (double)(2 * a->size));
-		setImpulse_fircore (a->p, impulse, 0);
-		_aligned_free (impulse);
+		if (!DeferChannelUpdate (channel, RXA_UPD_BP1))
+		{
+			impulse = fir_bandpass (a->nc, a->f_low, a->f_high, a->samplerate, 
+				wintype, 1, a->gain / (double)(2 * a->size));
+			setImpulse_fircore (a->p, impulse, 0);
+			_aligned_free (impulse);
+		}
 		EnterCriticalSection (&ch[channel].csDSP);
 		a->wintype = wintype;
 		setUpdate_fircore (a->p);
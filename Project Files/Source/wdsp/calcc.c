@@ -55,6 +55,8 @@ void size_calcc (CALCC a)
 	a->txs = (double *) malloc0 (a->nsamps * sizeof (complex));
 
 	a->ccbld = create_builder(a->nsamps + a->npsamps, a->ints);
+	for (i = 0; i < 2; i++)
+		a->fit.job[i].bld = create_builder(a->nsamps + a->npsamps, a->ints);
 
 	a->ctrl.cpi = (int *) malloc0 (a->ints * sizeof (int));
 	a->ctrl.sindex = (int *) malloc0 (a->ints * sizeof (int));
@@ -97,6 +99,8 @@ void desize_calcc (CALCC a)
 	_aligned_free (a->ctrl.sbase);
 	_aligned_free (a->ctrl.sindex);
 	_aligned_free (a->ctrl.cpi);
+	destroy_builder(a->fit.job[1].bld);
+	destroy_builder(a->fit.job[0].bld);
 	destroy_builder(a->ccbld);
 	_aligned_free (a->rxs);
 	_aligned_free (a->txs);
@@ -120,6 +124,7 @@ CALCC create_calcc (int channel, int runcal, int size, int rate, int ints, int s
 	double moxdelay, double loopdelay, double ptol, int mox, int solidmox, int pin, int map, int stbl,
 	int npsamps, double alpha)
 {
+	int i;
 	CALCC a = (CALCC) malloc0 (sizeof (calcc));
 	a->channel = channel;
 	a->runcal = runcal;
@@ -177,6 +182,9 @@ CALCC create_calcc (int channel, int runcal, int size, int rate, int ints, int s
 		0.0);										// delay
 	
 	InitializeCriticalSectionAndSpinCount (&a->disp.cs_disp, 2500);
+	InitializeCriticalSectionAndSpinCount (&a->timing.cs_timing, 2500);
+	QueryPerformanceFrequency (&a->timing.freq);
+	a->fit.parallel = 1;
 	a->util.ints = a->ints;
 	a->util.channel = a->channel;
 
@@ -198,12 +206,21 @@ CALCC create_calcc (int channel, int runcal, int size, int rate, int ints, int s
 	InterlockedBitTestAndReset(&a->turnoff_bypass, 0);
 	a->Sem_TurnOff = CreateSemaphore(0, 0, 1, 0);
 	_beginthread(doPSTurnoff, 0, (void*)a);
+	// spline fit workers
+	for (i = 0; i < 2; i++)
+	{
+		InterlockedBitTestAndReset(&a->fit.job[i].bypass, 0);
+		a->fit.job[i].Sem_Go = CreateSemaphore(0, 0, 1, 0);
+		a->fit.job[i].Sem_Done = CreateSemaphore(0, 0, 1, 0);
+		_beginthread(doPSFit, 0, (void*)&a->fit.job[i]);
+	}
 
 	return a;
 }
 
 void destroy_calcc (CALCC a)
 {
+	int i;
 	// correction save and restore threads
 	InterlockedBitTestAndReset(&txa[a->channel].iqc.p1->busy, 0);
 	Sleep(10);
@@ -223,10 +240,20 @@ void destroy_calcc (CALCC a)
 	ReleaseSemaphore(a->Sem_TurnOff, 1, 0);
 	while (InterlockedAnd(&a->turnoff_bypass, 0xffffffff)) Sleep(1);
 	CloseHandle(a->Sem_TurnOff);
+	// spline fit workers
+	for (i = 0; i < 2; i++)
+	{
+		InterlockedBitTestAndSet(&a->fit.job[i].bypass, 0);
+		ReleaseSemaphore(a->fit.job[i].Sem_Go, 1, 0);
+		while (InterlockedAnd(&a->fit.job[i].bypass, 0xffffffff)) Sleep(1);
+		CloseHandle(a->fit.job[i].Sem_Done);
+		CloseHandle(a->fit.job[i].Sem_Go);
+	}
 
 	_aligned_free (a->temptx);																						// remove later
 	_aligned_free (a->temprx);																						// remove later
 	desize_calcc (a);
+	DeleteCriticalSection (&a->timing.cs_timing);
 	DeleteCriticalSection (&a->disp.cs_disp);
 	destroy_delay (a->txdelay);
 	destroy_delay (a->rxdelay);
@@ -321,15 +348,76 @@ void rxscheck (int rints, double* tvec, double* coef, int* info)
 	if (out < 0.00) *info |= 0x0020;
 }
 
+double calcc_ms (CALCC a, LARGE_INTEGER* t0)
+{	// milliseconds since t0; t0 is advanced to now
+	LARGE_INTEGER t1;
+	double ms;
+	QueryPerformanceCounter (&t1);
+	ms = 1000.0 * (double)(t1.QuadPart - t0->QuadPart) / (double)a->timing.freq.QuadPart;
+	*t0 = t1;
+	return ms;
+}
+
+void __cdecl doPSFit (void *arg)
+{
+	struct _fitjob* j = (struct _fitjob*)arg;
+	while (!InterlockedAnd(&j->bypass, 0xffffffff))
+	{
+		WaitForSingleObject(j->Sem_Go, INFINITE);
+		if (!InterlockedAnd(&j->bypass, 0xffffffff))
+		{
+			xbuilder(j->bld, j->points, j->x, j->y, j->ints, j->t, j->info, j->c, j->ptol);
+			ReleaseSemaphore(j->Sem_Done, 1, 0);
+		}
+	}
+	InterlockedBitTestAndReset(&j->bypass, 0);
+}
+
+void post_fit (struct _fitjob* j, int points, double* x, double* y, int ints, double* t, int* info, double* c, double ptol)
+{
+	j->points = points;
+	j->x = x;
+	j->y = y;
+	j->ints = ints;
+	j->t = t;
+	j->info = info;
+	j->c = c;
+	j->ptol = ptol;
+	ReleaseSemaphore(j->Sem_Go, 1, 0);
+}
+
+void calc_fits (CALCC a, int points)
+{	// the three fits share x but are otherwise independent; cc & cs go to the fit workers
+	if (_InterlockedAnd (&a->fit.parallel, 1))
+	{
+		post_fit(&a->fit.job[0], points, a->x, a->yc, a->ints, a->t, &(a->binfo[2]), a->cc, a->ptol);
+		post_fit(&a->fit.job[1], points, a->x, a->ys, a->ints, a->t, &(a->binfo[3]), a->cs, a->ptol);
+		xbuilder(a->ccbld, points, a->x, a->ym, a->ints, a->t, &(a->binfo[1]), a->cm, a->ptol);
+		WaitForSingleObject(a->fit.job[0].Sem_Done, INFINITE);
+		WaitForSingleObject(a->fit.job[1].Sem_Done, INFINITE);
+	}
+	else
+	{
+		xbuilder(a->ccbld, points, a->x, a->ym, a->ints, a->t, &(a->binfo[1]), a->cm, a->ptol);
+		xbuilder(a->ccbld, points, a->x, a->yc, a->ints, a->t, &(a->binfo[2]), a->cc, a->ptol);
+		xbuilder(a->ccbld, points, a->x, a->ys, a->ints, a->t, &(a->binfo[3]), a->cs, a->ptol);
+	}
+}
+
 void calc (CALCC a)
 {
 	int i;
 	double norm;
+	double tm[8] = { 0.0 };
+	LARGE_INTEGER t0, tstart;
+	QueryPerformanceCounter (&t0);
+	tstart = t0;
 	for (i = 0; i < a->nsamps; i++)
 	{
 		a->env_TX[i] = sqrt (a->txs[2 * i + 0] * a->txs[2 * i + 0] + a->txs[2 * i + 1] * a->txs[2 * i + 1]);
 		a->env_RX[i] = sqrt (a->rxs[2 * i + 0] * a->rxs[2 * i + 0] + a->rxs[2 * i + 1] * a->rxs[2 * i + 1]);
 	}
+	tm[1] = calcc_ms (a, &t0);
 	{
 		int rints, ix;
 		double dx;
@@ -356,6 +444,7 @@ void calc (CALCC a)
 		else
 			a->rx_scale = rx_scale;
 	}
+	tm[2] = calcc_ms (a, &t0);
 
 	a->binfo[4] = (int)(256.0 * (a->hw_scale / a->rx_scale));
 	a->binfo[5]++;
@@ -429,16 +518,11 @@ void calc (CALCC a)
 			a->yc[i] = cval;
 			a->ys[i] = sval;
 		}
-		xbuilder(a->ccbld, a->tsamps, a->x, a->ym, a->ints, a->t, &(a->binfo[1]), a->cm, a->ptol);
-		xbuilder(a->ccbld, a->tsamps, a->x, a->yc, a->ints, a->t, &(a->binfo[2]), a->cc, a->ptol);
-		xbuilder(a->ccbld, a->tsamps, a->x, a->ys, a->ints, a->t, &(a->binfo[3]), a->cs, a->ptol);
+		calc_fits (a, a->tsamps);
 	}
 	else
-	{
-		xbuilder(a->ccbld, a->nsamps, a->x, a->ym, a->ints, a->t, &(a->binfo[1]), a->cm, a->ptol);
-		xbuilder(a->ccbld, a->nsamps, a->x, a->yc, a->ints, a->t, &(a->binfo[2]), a->cc, a->ptol);
-		xbuilder(a->ccbld, a->nsamps, a->x, a->ys, a->ints, a->t, &(a->binfo[3]), a->cs, a->ptol);
-	}
+		calc_fits (a, a->nsamps);
+	tm[3] = calcc_ms (a, &t0);
 
 	if (a->pin)	// tune
 	{
@@ -459,6 +543,7 @@ void calc (CALCC a)
 		a->tmap[a->ints] = 1.0;
 		a->convex = ((a->tmap[a->ints] - a->tmap[a->ints - 1]) > (a->t[a->ints] - a->t[a->ints - 1]));
 	}
+	tm[4] = calcc_ms (a, &t0);
 
 	EnterCriticalSection (&a->disp.cs_disp);
 	memcpy(a->disp.x, a->x,  a->nsamps * sizeof (double));
@@ -479,6 +564,13 @@ void calc (CALCC a)
 	}
 	LeaveCriticalSection (&a->disp.cs_disp);
 cleanup:
+	tm[6] = calcc_ms (a, &tstart);
+	EnterCriticalSection (&a->timing.cs_timing);
+	for (i = 1; i <= 4; i++)
+		a->timing.t[i] = tm[i];
+	a->timing.t[6] = tm[6];
+	a->timing.t[7] += 1.0;
+	LeaveCriticalSection (&a->timing.cs_timing);
 	return;
 }
 
@@ -493,12 +585,19 @@ void __cdecl doPSCalcCorrection (void *arg)
 			calc(a);
 			if (a->scOK)
 			{
+				LARGE_INTEGER t0;
+				double tapply;
+				QueryPerformanceCounter (&t0);
 				EnterCriticalSection (&a->ctrl.cs_SafeToEnd);
 				if (!InterlockedBitTestAndSet(&a->ctrl.running, 0))
 					SetTXAiqcStart(a->channel, a->cm, a->cc, a->cs);
 				else
 					SetTXAiqcSwap(a->channel, a->cm, a->cc, a->cs);
 				LeaveCriticalSection(&a->ctrl.cs_SafeToEnd);
+				tapply = calcc_ms (a, &t0);
+				EnterCriticalSection (&a->timing.cs_timing);
+				a->timing.t[5] = tapply;
+				LeaveCriticalSection (&a->timing.cs_timing);
 			}
 			InterlockedBitTestAndSet(&a->ctrl.calcdone, 0);
 		}
@@ -683,6 +782,7 @@ void pscc (int channel, int size, double* tx, double* rx)
 				{
 					a->ctrl.state = LCOLLECT;
 					SetTXAiqcDogCount (channel, a->info[13] = 0);
+					QueryPerformanceCounter (&a->timing.collect_start);
 				}
 				else
 					a->ctrl.state = LWAIT;
@@ -734,7 +834,13 @@ void pscc (int channel, int size, double* tx, double* rx)
 				else if (!InterlockedAnd (&a->mox, 1) || !InterlockedAnd (&a->solidmox, 1))
 					a->ctrl.state = LWAIT;
 				else if (a->ctrl.full_ints == a->ints)
+				{
+					double tcollect = calcc_ms (a, &a->timing.collect_start);
+					EnterCriticalSection (&a->timing.cs_timing);
+					a->timing.t[0] = tcollect;
+					LeaveCriticalSection (&a->timing.cs_timing);
 					a->ctrl.state = MOXCHECK;
+				}
 				else if (a->info[13] >= 6)
 					a->ctrl.state = LRESET;
 				else if (a->ctrl.count >= 4 * a->rate)
@@ -1079,6 +1185,25 @@ void SetPSFeedbackRate (int channel, int rate)
 	LeaveCriticalSection (&txa[channel].calcc.cs_update);
 }
 
+PORT
+void SetPSParallelFit (int channel, int parallel)
+{
+	CALCC a = txa[channel].calcc.p;
+	if (parallel)
+		InterlockedBitTestAndSet (&a->fit.parallel, 0);
+	else
+		InterlockedBitTestAndReset (&a->fit.parallel, 0);
+}
+
+PORT
+void GetPSTiming (int channel, double* timing)
+{
+	CALCC a = txa[channel].calcc.p;
+	EnterCriticalSection (&a->timing.cs_timing);
+	memcpy (timing, a->timing.t, 8 * sizeof (double));
+	LeaveCriticalSection (&a->timing.cs_timing);
+}
+
 PORT
 void SetPSPinMode (int channel, int pin)
 {
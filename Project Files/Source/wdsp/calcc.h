@@ -128,6 +128,32 @@ typedef struct _calcc
 		double* pc;
 		double* ps;
 	} util;
+	struct _fit
+	{
+		volatile long parallel;
+		struct _fitjob
+		{
+			BLDR bld;
+			int points;
+			double* x;
+			double* y;
+			int ints;
+			double* t;
+			int* info;
+			double* c;
+			double ptol;
+			volatile long bypass;
+			HANDLE Sem_Go;
+			HANDLE Sem_Done;
+		} job[2];
+	} fit;
+	struct _timing
+	{
+		LARGE_INTEGER freq;
+		LARGE_INTEGER collect_start;
+		double t[8];
+		CRITICAL_SECTION cs_timing;
+	} timing;
 	double* temptx;				//////////////////////////////////////////////////// temporary tx complex buffer - remove with new callback3port()
 	double* temprx;				//////////////////////////////////////////////////// temporary rx complex buffer - remove with new callback3port()
 } calcc, *CALCC;
@@ -150,6 +176,8 @@ extern void __cdecl doPSCalcCorrection(void* arg);
 
 extern void __cdecl doPSTurnoff(void* arg);
 
+extern void __cdecl doPSFit(void* arg);
+
 #endif
 
 // 'info' assignments:
@@ -164,4 +192,14 @@ extern void __cdecl doPSTurnoff(void* arg);
 //
 //		13 - dogcount
 //		14 - indicates iqc_Run = 1
-//		15 - control state
\ No newline at end of file
+//		15 - control state
+
+// 'timing' assignments (milliseconds, most recent calibration pass):
+//		 0 - sample collection, LSETUP to all intervals full
+//		 1 - TX & RX envelope computation
+//		 2 - rx_scale fit
+//		 3 - cm, cc, cs fits
+//		 4 - scheck() and map calculation
+//		 5 - SetTXAiqcStart() or SetTXAiqcSwap()
+//		 6 - total time in calc()
+//		 7 - count of calibration passes timed
\ No newline at end of file
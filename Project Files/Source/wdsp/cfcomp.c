@@ -141,49 +141,20 @@ void calc_comp (CFCOMP a)
 
 void calc_cfcomp(CFCOMP a)
 {
-	int i;
 	a->incr = a->fsize / a->ovrlp;
-	if (a->fsize > a->bsize)
-		a->iasize = a->fsize;
-	else
-		a->iasize = a->bsize + a->fsize - a->incr;
-	a->iainidx = 0;
-	a->iaoutidx = 0;
-	if (a->fsize > a->bsize)
-	{
-		if (a->bsize > a->incr)  a->oasize = a->bsize;
-		else					 a->oasize = a->incr;
-		a->oainidx = (a->fsize - a->bsize - a->incr) % a->oasize;
-	}
-	else
-	{
-		a->oasize = a->bsize;
-		a->oainidx = a->fsize - a->incr;
-	}
-	a->init_oainidx = a->oainidx;
-	a->oaoutidx = 0;
 	a->msize = a->fsize / 2 + 1;
 	a->window    = (double *)malloc0 (a->fsize  * sizeof(double));
-	a->inaccum   = (double *)malloc0 (a->iasize * sizeof(double));
-	a->forfftin  = (double *)malloc0 (a->fsize  * sizeof(double));
-	a->forfftout = (double *)malloc0 (a->msize  * sizeof(complex));
 	a->cmask     = (double *)malloc0 (a->msize  * sizeof(double));
 	a->mask      = (double *)malloc0 (a->msize  * sizeof(double));
 	a->cfc_gain  = (double *)malloc0 (a->msize  * sizeof(double));
-	a->revfftin  = (double *)malloc0 (a->msize  * sizeof(complex));
-	a->revfftout = (double *)malloc0 (a->fsize  * sizeof(double));
-	a->save      = (double **)malloc0(a->ovrlp  * sizeof(double *));
-	for (i = 0; i < a->ovrlp; i++)
-		a->save[i] = (double *)malloc0(a->fsize * sizeof(double));
-	a->outaccum = (double *)malloc0(a->oasize * sizeof(double));
-	a->nsamps = 0;
-	a->saveidx = 0;
-	a->Rfor = fftw_plan_dft_r2c_1d(a->fsize, a->forfftin, (fftw_complex *)a->forfftout, FFTW_ESTIMATE);
-	a->Rrev = fftw_plan_dft_c2r_1d(a->fsize, (fftw_complex *)a->revfftin, a->revfftout, FFTW_ESTIMATE);
+	a->stft = create_stft (a->bsize, a->in, a->out, a->fsize, a->ovrlp, frame_cfcomp, (void *)a);
+	a->forfftout = a->stft->forfftout;
+	a->revfftin  = a->stft->revfftin;
 	calc_cfcwindow(a);
 
 	a->pregain  = (2.0 * a->winfudge) / (double)a->fsize;
 	a->postgain = 0.5 / ((double)a->ovrlp * a->winfudge);
+	setWindow_stft (a->stft, a->window, a->pregain, a->postgain);
 
 	a->fp = (double *) malloc0 ((a->nfreqs + 2) * sizeof (double));
 	a->gp = (double *) malloc0 ((a->nfreqs + 2) * sizeof (double));
@@ -203,7 +174,6 @@ void calc_cfcomp(CFCOMP a)
 
 void decalc_cfcomp(CFCOMP a)
 {
-	int i;
 	_aligned_free (a->cfc_gain_copy);
 	_aligned_free (a->delta_copy);
 	_aligned_free (a->delta);
@@ -213,20 +183,10 @@ void decalc_cfcomp(CFCOMP a)
 	_aligned_free (a->gp);
 	_aligned_free (a->fp);
 
-	fftw_destroy_plan(a->Rrev);
-	fftw_destroy_plan(a->Rfor);
-	_aligned_free(a->outaccum);
-	for (i = 0; i < a->ovrlp; i++)
-		_aligned_free(a->save[i]);
-	_aligned_free(a->save);
-	_aligned_free(a->revfftout);
-	_aligned_free(a->revfftin);
+	destroy_stft (a->stft);
 	_aligned_free(a->cfc_gain);
 	_aligned_free(a->mask);
 	_aligned_free(a->cmask);
-	_aligned_free(a->forfftout);
-	_aligned_free(a->forfftin);
-	_aligned_free(a->inaccum);
 	_aligned_free(a->window);
 }
 
@@ -257,36 +217,72 @@ CFCOMP create_cfcomp (int run, int position, int peq_run, int size, double* in,
 	memcpy (a->F, F, a->nfreqs * sizeof (double));
 	memcpy (a->G, G, a->nfreqs * sizeof (double));
 	memcpy (a->E, E, a->nfreqs * sizeof (double));
-	calc_cfcomp (a);
+	if (a->run) materialize_cfcomp (a);
 	return a;
 }
 
 void flush_cfcomp (CFCOMP a)
 {
-	int i;
-	memset (a->inaccum, 0, a->iasize * sizeof (double));
-	for (i = 0; i < a->ovrlp; i++)
-		memset (a->save[i], 0, a->fsize * sizeof (double));
-	memset (a->outaccum, 0, a->oasize * sizeof (double));
-	a->nsamps   = 0;
-	a->iainidx  = 0;
-	a->iaoutidx = 0;
-	a->oainidx  = a->init_oainidx;
-	a->oaoutidx = 0;
-	a->saveidx  = 0;
+	if (!a->live) return;
+	flush_stft (a->stft);
 	a->gain = 0.0;
 	memset(a->delta, 0, a->msize * sizeof(double));
 }
 
 void destroy_cfcomp (CFCOMP a)
 {
-	decalc_cfcomp (a);
+	release_cfcomp (a);
 	_aligned_free (a->E);
 	_aligned_free (a->G);
 	_aligned_free (a->F);
 	_aligned_free (a);
 }
 
+void materialize_cfcomp (CFCOMP a)
+{	// allocates the internals of a block that was created, or later released, while not running
+	if (!a->live)
+	{
+		calc_cfcomp (a);
+		a->mask_ready = 0;
+		a->live = 1;
+	}
+}
+
+void release_cfcomp (CFCOMP a)
+{
+	if (a->live)
+	{
+		a->live = 0;
+		a->mask_ready = 0;
+		decalc_cfcomp (a);
+	}
+}
+
+void stage_cfcomp (CFCOMP a, CRITICAL_SECTION* cs)
+{	// materializes 'a' without holding 'cs' across the allocations and fft planning:  the internals are
+	// built in a private copy, then adopted under 'cs' only if nothing changed the block in the meantime
+	CFCOMP s = (CFCOMP) malloc0 (sizeof (cfcomp));
+	CFCOMP b = (CFCOMP) malloc0 (sizeof (cfcomp));
+	EnterCriticalSection (cs);
+	while (!a->live)
+	{
+		memcpy (s, a, sizeof (cfcomp));
+		memcpy (b, a, sizeof (cfcomp));
+		LeaveCriticalSection (cs);
+		materialize_cfcomp (b);
+		b->stft->ptr = (void *)a;						// frame_cfcomp must see the adopted block
+		QueryPerformanceCounter (&b->toff);				// the idle-release timer starts now
+		EnterCriticalSection (cs);
+		if (memcmp (a, s, sizeof (cfcomp)) == 0)
+			memcpy (a, b, sizeof (cfcomp));
+		else
+			release_cfcomp (b);
+	}
+	LeaveCriticalSection (cs);
+	_aligned_free (b);
+	_aligned_free (s);
+}
+
 
 void calc_mask (CFCOMP a)
 {
@@ -331,55 +327,22 @@ void calc_mask (CFCOMP a)
 	a->mask_ready = 1;
 }
 
-void xcfcomp (CFCOMP a, int pos)
+void frame_cfcomp (void* ptr)
 {
-	if (a->run && pos == a->position)
+	CFCOMP a = (CFCOMP)ptr;
+	int i;
+	calc_mask(a);
+	for (i = 0; i < a->msize; i++)
 	{
-		int i, j, k, sbuff, sbegin;
-		for (i = 0; i < 2 * a->bsize; i += 2)
-		{
-			a->inaccum[a->iainidx] = a->in[i];
-			a->iainidx = (a->iainidx + 1) % a->iasize;
-		}
-		a->nsamps += a->bsize;
-		while (a->nsamps >= a->fsize)
-		{
-			for (i = 0, j = a->iaoutidx; i < a->fsize; i++, j = (j + 1) % a->iasize)
-				a->forfftin[i] = a->pregain * a->window[i] * a->inaccum[j];
-			a->iaoutidx = (a->iaoutidx + a->incr) % a->iasize;
-			a->nsamps -= a->incr;
-			fftw_execute (a->Rfor);
-			calc_mask(a);
-			for (i = 0; i < a->msize; i++)
-			{
-				a->revfftin[2 * i + 0] = a->mask[i] * a->forfftout[2 * i + 0];
-				a->revfftin[2 * i + 1] = a->mask[i] * a->forfftout[2 * i + 1];
-			}
-			fftw_execute (a->Rrev);
-			for (i = 0; i < a->fsize; i++)
-				a->save[a->saveidx][i] = a->postgain * a->window[i] * a->revfftout[i];
-			for (i = a->ovrlp; i > 0; i--)
-			{
-				sbuff = (a->saveidx + i) % a->ovrlp;
-				sbegin = a->incr * (a->ovrlp - i);
-				for (j = sbegin, k = a->oainidx; j < a->incr + sbegin; j++, k = (k + 1) % a->oasize)
-				{
-					if ( i == a->ovrlp)
-						a->outaccum[k]  = a->save[sbuff][j];
-					else
-						a->outaccum[k] += a->save[sbuff][j];
-				}
-			}
-			a->saveidx = (a->saveidx + 1) % a->ovrlp;
-			a->oainidx = (a->oainidx + a->incr) % a->oasize;
-		}
-		for (i = 0; i < a->bsize; i++)
-		{
-			a->out[2 * i + 0] = a->outaccum[a->oaoutidx];
-			a->out[2 * i + 1] = 0.0;
-			a->oaoutidx = (a->oaoutidx + 1) % a->oasize;
-		}
+		a->revfftin[2 * i + 0] = a->mask[i] * a->forfftout[2 * i + 0];
+		a->revfftin[2 * i + 1] = a->mask[i] * a->forfftout[2 * i + 1];
 	}
+}
+
+void xcfcomp (CFCOMP a, int pos)
+{
+	if (a->run && pos == a->position)
+		xstft (a->stft);
 	else if (a->out != a->in)
 		memcpy (a->out, a->in, a->bsize * sizeof (complex));
 }
@@ -388,20 +351,22 @@ void setBuffers_cfcomp (CFCOMP a, double* in, double* out)
 {
 	a->in = in;
 	a->out = out;
+	if (a->live)
+		setBuffers_stft (a->stft, a->in, a->out);
 }
 
 void setSamplerate_cfcomp (CFCOMP a, int rate)
 {
-	decalc_cfcomp (a);
+	if (a->live) decalc_cfcomp (a);
 	a->rate = rate;
-	calc_cfcomp (a);
+	if (a->live) calc_cfcomp (a);
 }
 
 void setSize_cfcomp (CFCOMP a, int size)
 {
-	decalc_cfcomp (a);
+	if (a->live) decalc_cfcomp (a);
 	a->bsize = size;
-	calc_cfcomp (a);
+	if (a->live) calc_cfcomp (a);
 }
 
 /********************************************************************************************************
@@ -416,7 +381,10 @@ void SetTXACFCOMPRun (int channel, int run)
 	CFCOMP a = txa[channel].cfcomp.p;
 	if (a->run != run)
 	{
+		if (run) stage_cfcomp (a, &ch[channel].csDSP);
 		EnterCriticalSection (&ch[channel].csDSP);
+		if (run) materialize_cfcomp (a);		// no-op unless released since staging
+		else     QueryPerformanceCounter (&a->toff);
 		a->run = run;
 		LeaveCriticalSection (&ch[channel].csDSP);
 	}
@@ -449,13 +417,16 @@ void SetTXACFCOMPprofile (int channel, int nfreqs, double* F, double* G, double
 	memcpy (a->F, F, a->nfreqs * sizeof (double));
 	memcpy (a->G, G, a->nfreqs * sizeof (double));
 	memcpy (a->E, E, a->nfreqs * sizeof (double));
-	_aligned_free (a->ep);
-	_aligned_free (a->gp);
-	_aligned_free (a->fp);
-	a->fp = (double *) malloc0 ((a->nfreqs + 2) * sizeof (double));
-	a->gp = (double *) malloc0 ((a->nfreqs + 2) * sizeof (double));
-	a->ep = (double *) malloc0 ((a->nfreqs + 2) * sizeof (double));
-	calc_comp(a);
+	if (a->live)
+	{	// otherwise the profile is applied when the block is materialized
+		_aligned_free (a->ep);
+		_aligned_free (a->gp);
+		_aligned_free (a->fp);
+		a->fp = (double *) malloc0 ((a->nfreqs + 2) * sizeof (double));
+		a->gp = (double *) malloc0 ((a->nfreqs + 2) * sizeof (double));
+		a->ep = (double *) malloc0 ((a->nfreqs + 2) * sizeof (double));
+		calc_comp(a);
+	}
 	LeaveCriticalSection (&ch[channel].csDSP);
 }
 
@@ -468,9 +439,12 @@ void SetTXACFCOMPPrecomp (int channel, double precomp)
 		EnterCriticalSection (&ch[channel].csDSP);
 		a->precomp = precomp;
 		a->precomplin = pow (10.0, 0.05 * a->precomp);
-		for (int i = 0; i < a->msize; i++)
+		if (a->live)
 		{
-			a->cfc_gain[i] = a->precomplin * a->comp[i];
+			for (int i = 0; i < a->msize; i++)
+			{
+				a->cfc_gain[i] = a->precomplin * a->comp[i];
+			}
 		}
 		LeaveCriticalSection (&ch[channel].csDSP);
 	}
@@ -504,7 +478,7 @@ void GetTXACFCOMPDisplayCompression (int channel, double* comp_values, int* read
 	int i;
 	CFCOMP a = txa[channel].cfcomp.p;
 	EnterCriticalSection(&ch[channel].csDSP);
-	if (*ready = a->mask_ready)
+	if (*ready = a->live && a->mask_ready)
 	{
 		memcpy(a->delta_copy, a->delta, a->msize * sizeof(double));
 		memcpy(a->cfc_gain_copy, a->cfc_gain, a->msize * sizeof(double));
@@ -30,6 +30,8 @@ warren@wpratt.com
 typedef struct _cfcomp
 {
 	int run;
+	int live;					// internals are allocated; only while live may 'run' be set
+	LARGE_INTEGER toff;			// time at which 'run' was last cleared
 	int position;
 	int bsize;
 	double* in;
@@ -38,9 +40,7 @@ typedef struct _cfcomp
 	int ovrlp;
 	int incr;
 	double* window;
-	int iasize;
-	double* inaccum;
-	double* forfftin;
+	STFT stft;
 	double* forfftout;
 	int msize;
 	double* cmask;
@@ -48,23 +48,10 @@ typedef struct _cfcomp
 	int mask_ready;
 	double* cfc_gain;
 	double* revfftin;
-	double* revfftout;
-	double** save;
-	int oasize;
-	double* outaccum;
 	double rate;
 	int wintype;
 	double pregain;
 	double postgain;
-	int nsamps;
-	int iainidx;
-	int iaoutidx;
-	int init_oainidx;
-	int oainidx;
-	int oaoutidx;
-	int saveidx;
-	fftw_plan Rfor;
-	fftw_plan Rrev;
 
 	int comp_method;
 	int nfreqs;
@@ -101,6 +88,14 @@ extern void destroy_cfcomp (CFCOMP a);
 
 extern void flush_cfcomp (CFCOMP a);
 
+extern void materialize_cfcomp (CFCOMP a);
+
+extern void release_cfcomp (CFCOMP a);
+
+extern void stage_cfcomp (CFCOMP a, CRITICAL_SECTION* cs);
+
+extern void frame_cfcomp (void* ptr);
+
 extern void xcfcomp (CFCOMP a, int pos);
 
 extern void setBuffers_cfcomp (CFCOMP a, double* in, double* out);
@@ -60,7 +60,8 @@ void pre_main_build (int channel)
 void post_main_build (int channel)
 {
 	InterlockedBitTestAndSet (&ch[channel].run, 0);
-	start_thread (channel);
+	if (!attach_sched (channel))
+		start_thread (channel);
 	if (ch[channel].state == 1)
 	 	InterlockedBitTestAndSet (&ch[channel].exchange, 0);
 }
@@ -88,6 +89,11 @@ void OpenChannel (int channel, int in_size, int dsp_size, int input_samplerate,
 	ch[channel].tdelaydown = tdelaydown;
 	ch[channel].tslewdown = tslewdown;
 	ch[channel].bfo = bfo;
+	InitializeCriticalSectionAndSpinCount ( &ch[channel].csUPD, 2500 );	// outlives every rebuild of the channel
+	ch[channel].upd_owner = 0;
+	ch[channel].upd_depth = 0;
+	ch[channel].upd_dirty = 0;
+	ch[channel].upd_rebuild = 0;
 	InterlockedBitTestAndReset (&ch[channel].exchange, 0);
 	build_channel (channel);
 	if (ch[channel].state)
@@ -107,6 +113,7 @@ void pre_main_destroy (int channel)
 	InterlockedBitTestAndReset (&ch[channel].run, 0);
 	InterlockedBitTestAndSet (&ch[channel].iob.pc->exec_bypass, 0);
 	ReleaseSemaphore (a->Sem_BuffReady, 1, 0);
+	detach_sched (channel);
 	Sleep (25);
 }
 
@@ -117,14 +124,20 @@ void post_main_destroy (int channel)
 	DeleteCriticalSection ( &ch[channel].csDSP );
 }
 
-PORT
-void CloseChannel (int channel)
+void destroy_channel (int channel)
 {
 	pre_main_destroy (channel);
 	destroy_main (channel);
 	post_main_destroy (channel);
 }
 
+PORT
+void CloseChannel (int channel)
+{
+	destroy_channel (channel);
+	DeleteCriticalSection ( &ch[channel].csUPD );
+}
+
 void flushChannel (void* p)
 {
 	int channel = (int)(uintptr_t)p;
@@ -147,6 +160,21 @@ void flushChannel (void* p)
 	InterlockedBitTestAndReset(&a->flush_bypass, 0);
 }
 
+struct _chnext* defer_rebuild (int channel)
+{	// called holding csUPD with a batch open, hence by its owner:  the rebuild is left to the commit
+	ch[channel].upd_rebuild = 1;
+	return &ch[channel].upd_next;
+}
+
+void apply_rebuild (int channel)
+{	// called by the commit, holding csUPD with the batch closed, so the setters act immediately
+	struct _chnext n = ch[channel].upd_next;
+	SetType (channel, n.type);
+	SetInputBuffsize (channel, n.in_size);
+	SetDSPBuffsize (channel, n.dsp_size);
+	SetAllRates (channel, n.in_rate, n.dsp_rate, n.out_rate);
+}
+
 /********************************************************************************************************
 *																										*
 *										Channel Properties												*
@@ -156,18 +184,25 @@ void flushChannel (void* p)
 PORT
 void SetType (int channel, int type)
 {	// no need to rebuild buffers; but we did anyway
-	if (type != ch[channel].type)
+	EnterCriticalSection (&ch[channel].csUPD);			// waits for a batch open on another thread
+	if (ch[channel].upd_depth)
+		defer_rebuild (channel)->type = type;
+	else if (type != ch[channel].type)
 	{
-		CloseChannel (channel);
+		destroy_channel (channel);
 		ch[channel].type = type;
 		build_channel (channel);
 	}
+	LeaveCriticalSection (&ch[channel].csUPD);
 }
 
 PORT
 void SetInputBuffsize (int channel, int in_size)
 {	// we do not rebuild main here since it didn't change
-	if (in_size != ch[channel].in_size)
+	EnterCriticalSection (&ch[channel].csUPD);			// waits for a batch open on another thread
+	if (ch[channel].upd_depth)
+		defer_rebuild (channel)->in_size = in_size;
+	else if (in_size != ch[channel].in_size)
 	{
 		pre_main_destroy (channel);
 		post_main_destroy (channel);
@@ -175,12 +210,16 @@ void SetInputBuffsize (int channel, int in_size)
 		pre_main_build (channel);
 		post_main_build (channel);
 	}
+	LeaveCriticalSection (&ch[channel].csUPD);
 }
 
 PORT
 void SetDSPBuffsize (int channel, int dsp_size)
 {
-	if (dsp_size != ch[channel].dsp_size)
+	EnterCriticalSection (&ch[channel].csUPD);			// waits for a batch open on another thread
+	if (ch[channel].upd_depth)
+		defer_rebuild (channel)->dsp_size = dsp_size;
+	else if (dsp_size != ch[channel].dsp_size)
 	{
 		int oldstate = SetChannelState (channel, 0, 1);
 		pre_main_destroy (channel);
@@ -191,12 +230,16 @@ void SetDSPBuffsize (int channel, int dsp_size)
 		post_main_build (channel);
 		SetChannelState (channel, oldstate, 0);
 	}
+	LeaveCriticalSection (&ch[channel].csUPD);
 }
 
 PORT
 void SetInputSamplerate (int channel, int in_rate)
 {	// no re-build of main required
-	if (in_rate != ch[channel].in_rate)
+	EnterCriticalSection (&ch[channel].csUPD);			// waits for a batch open on another thread
+	if (ch[channel].upd_depth)
+		defer_rebuild (channel)->in_rate = in_rate;
+	else if (in_rate != ch[channel].in_rate)
 	{
 		pre_main_destroy (channel);
 		post_main_destroy (channel);
@@ -205,12 +248,16 @@ void SetInputSamplerate (int channel, int in_rate)
 		setInputSamplerate_main (channel);
 		post_main_build (channel);
 	}
+	LeaveCriticalSection (&ch[channel].csUPD);
 }
 
 PORT
 void SetDSPSamplerate (int channel, int dsp_rate)
 {
-	if (dsp_rate != ch[channel].dsp_rate)
+	EnterCriticalSection (&ch[channel].csUPD);			// waits for a batch open on another thread
+	if (ch[channel].upd_depth)
+		defer_rebuild (channel)->dsp_rate = dsp_rate;
+	else if (dsp_rate != ch[channel].dsp_rate)
 	{
 		int oldstate = SetChannelState (channel, 0, 1);
 		pre_main_destroy (channel);
@@ -221,12 +268,16 @@ void SetDSPSamplerate (int channel, int dsp_rate)
 		post_main_build (channel);
 		SetChannelState (channel, oldstate, 0);
 	}
+	LeaveCriticalSection (&ch[channel].csUPD);
 }
 
 PORT
 void SetOutputSamplerate (int channel, int out_rate)
 {	// no re-build of main required
-	if (out_rate != ch[channel].out_rate)
+	EnterCriticalSection (&ch[channel].csUPD);			// waits for a batch open on another thread
+	if (ch[channel].upd_depth)
+		defer_rebuild (channel)->out_rate = out_rate;
+	else if (out_rate != ch[channel].out_rate)
 	{
 		pre_main_destroy (channel);
 		post_main_destroy (channel);
@@ -235,12 +286,21 @@ void SetOutputSamplerate (int channel, int out_rate)
 		setOutputSamplerate_main (channel);
 		post_main_build (channel);
 	}
+	LeaveCriticalSection (&ch[channel].csUPD);
 }
 
 PORT
 void SetAllRates (int channel, int in_rate, int dsp_rate, int out_rate)
 {
-	if ((in_rate != ch[channel].in_rate) || (dsp_rate != ch[channel].dsp_rate) || (out_rate != ch[channel].out_rate))
+	EnterCriticalSection (&ch[channel].csUPD);			// waits for a batch open on another thread
+	if (ch[channel].upd_depth)
+	{
+		struct _chnext* n = defer_rebuild (channel);
+		n->in_rate  = in_rate;
+		n->dsp_rate = dsp_rate;
+		n->out_rate = out_rate;
+	}
+	else if ((in_rate != ch[channel].in_rate) || (dsp_rate != ch[channel].dsp_rate) || (out_rate != ch[channel].out_rate))
 	{
 		pre_main_destroy (channel);
 		post_main_destroy (channel);
@@ -253,6 +313,7 @@ void SetAllRates (int channel, int in_rate, int dsp_rate, int out_rate)
 		setOutputSamplerate_main (channel);
 		post_main_build (channel);
 	}
+	LeaveCriticalSection (&ch[channel].csUPD);
 }
 
 PORT
@@ -342,4 +403,67 @@ void SetChannelTSlewDown (int channel, double time)
 	destroy_slews (a);
 	create_slews (a);
 	LeaveCriticalSection (&ch[channel].csEXCH);
-}
\ No newline at end of file
+}
+
+/********************************************************************************************************
+*																										*
+*											Parameter Batches											*
+*																										*
+********************************************************************************************************/
+
+// A host changing mode or band brackets its Set...() calls with BeginChannelUpdate() and
+// CommitChannelUpdate().  Inside the bracket, setters that would design a FIR filter only record their
+// parameters; at commit each affected filter is designed once, from this thread while the channel keeps
+// running on its old masks, and all of the new masks are switched in together at one block boundary.
+// The batch belongs to the thread that opened it; setters called from other threads act immediately,
+// except the rebuilding ones (buffer sizes, rates, type), which wait for the commit.  Those called by the
+// owner inside the batch are recorded and applied at commit, before the filter designs.
+
+PORT
+void BeginChannelUpdate (int channel)
+{
+	EnterCriticalSection (&ch[channel].csUPD);
+	ch[channel].upd_owner = GetCurrentThreadId ();
+	if (ch[channel].upd_depth++ == 0)
+	{	// rebuild setters called inside the batch edit this copy
+		ch[channel].upd_next.type     = ch[channel].type;
+		ch[channel].upd_next.in_size  = ch[channel].in_size;
+		ch[channel].upd_next.dsp_size = ch[channel].dsp_size;
+		ch[channel].upd_next.in_rate  = ch[channel].in_rate;
+		ch[channel].upd_next.dsp_rate = ch[channel].dsp_rate;
+		ch[channel].upd_next.out_rate = ch[channel].out_rate;
+	}
+}
+
+PORT
+void CommitChannelUpdate (int channel)
+{
+	int dirty;
+	if (--ch[channel].upd_depth == 0)
+	{
+		ch[channel].upd_owner = 0;
+		if (ch[channel].upd_rebuild)
+		{	// buffer size, rate and type changes first; they leave the filters designed for the new values
+			ch[channel].upd_rebuild = 0;
+			apply_rebuild (channel);
+		}
+		if ((dirty = ch[channel].upd_dirty) != 0)
+		{
+			ch[channel].upd_dirty = 0;
+			designBatch_main (channel, dirty);			// new masks, off the dsp thread
+			EnterCriticalSection (&ch[channel].csDSP);
+			applyBatch_main (channel, dirty);			// switch them all at the same block boundary
+			LeaveCriticalSection (&ch[channel].csDSP);
+		}
+	}
+	LeaveCriticalSection (&ch[channel].csUPD);
+}
+
+int DeferChannelUpdate (int channel, int flags)
+{	// returns 1 if the calling thread has a batch open; the filter design marked by 'flags' is then left to the commit.
+	//	Never blocks, so it may be called with csDSP held.
+	if (ch[channel].upd_owner != GetCurrentThreadId ())
+		return 0;
+	ch[channel].upd_dirty |= flags;
+	return 1;
+}
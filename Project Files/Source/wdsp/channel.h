@@ -43,6 +43,20 @@ struct _ch
 	int out_size;				// output buffsize (complex samples) in a fexchange() operation
 	CRITICAL_SECTION csDSP;		// used to block dsp while parameters are updated or buffers flushed
 	CRITICAL_SECTION csEXCH;	// used to block fexchange() while parameters are updated or buffers flushed
+	CRITICAL_SECTION csUPD;		// held by the thread that has a parameter batch open
+	volatile DWORD upd_owner;	// thread id of that thread
+	int upd_depth;				// BeginChannelUpdate() nesting count
+	int upd_dirty;				// filters whose design is deferred to CommitChannelUpdate()
+	int upd_rebuild;			// a buffer size, rate or type change is deferred to CommitChannelUpdate()
+	struct _chnext				// the values it will apply
+	{
+		int type;
+		int in_size;
+		int dsp_size;
+		int in_rate;
+		int dsp_rate;
+		int out_rate;
+	} upd_next;
 	int state;					// 0 for channel OFF; 1 for channel ON
 	double tdelayup;
 	double tslewup;
@@ -59,6 +73,8 @@ struct _ch
 
 extern struct _ch ch[];
 
+extern void start_thread (int channel);
+
 PORT void OpenChannel (int channel, int in_size, int dsp_size, int input_samplerate, int dsp_rate, int output_samplerate, int type, int state, double tdelayup, double tslewup, double tdelaydown, double tslewdown, int bfo);
 
 PORT void CloseChannel (int channel);
@@ -81,4 +97,10 @@ PORT void SetAllRates (int channel, int in_rate, int dsp_rate, int out_rate);
 
 PORT int SetChannelState (int channel, int state, int dmode);
 
+PORT void BeginChannelUpdate (int channel);
+
+PORT void CommitChannelUpdate (int channel);
+
+extern int DeferChannelUpdate (int channel, int flags);
+
 #endif
\ No newline at end of file
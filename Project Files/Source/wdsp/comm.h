@@ -32,6 +32,8 @@ warren@wpratt.com
 #include <time.h>
 #include <avrt.h>
 #include "fftw3.h"
+#include "stft.h"
+#include "probe.h"
 
 #include "amd.h"
 #include "ammod.h"
@@ -39,6 +41,7 @@ warren@wpratt.com
 #include "analyzer.h"
 #include "anf.h"
 #include "anr.h"
+#include "arena.h"
 #include "bandpass.h"
 #include "calcc.h"
 #include "cblock.h"
@@ -49,6 +52,7 @@ warren@wpratt.com
 #include "delay.h"
 #include "dexp.h"
 #include "div.h"
+#include "dshmpub.h"
 #include "eer.h"
 #include "emnr.h"
 #include "emph.h"
@@ -77,6 +81,7 @@ warren@wpratt.com
 #include "resample.h"
 #include "rmatch.h"
 #include "RXA.h"
+#include "sched.h"
 #include "sender.h"
 #include "shift.h"
 #include "siphon.h"
@@ -88,6 +93,7 @@ warren@wpratt.com
 #include "utilities.h"
 #include "varsamp.h"
 #include "wcpAGC.h"
+#include "wfhist.h"
 
 // manage differences among consoles
 #define _Thetis
@@ -116,6 +122,11 @@ warren@wpratt.com
 #define dMAX_N							100					// maximum number of frequencies at which to calibrate
 #define dMAX_CAL_SETS					2					// maximum number of calibration data sets
 #define dMAX_PIXOUTS					4					// maximum number of det/avg/outputs per display instance
+#define dMAX_ZOOM_STAGES				8					// maximum number of decimate-by-two stages ahead of a zoomed fft
+#define dZOOM_SPAN						0.8					// fraction of a zoomed fft that may carry the requested span
+#define dPLAN_CACHE						8					// number of fft sizes whose plans each display keeps
+#define dEST_PLANS						24					// power-of-two fft sizes, 2^0 through 2^23, that may have premade estimates
+#define dRETIRED_PLANS					16					// evicted plans a display may hold until the planner lock is free
 
 // wisdom definitions
 #define MAX_WISDOM_SIZE_DISPLAY			262144
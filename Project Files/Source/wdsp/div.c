@@ -64,6 +64,16 @@ void flush_div (MDIV a)
 
 }
 
+void load_rotate_div (MDIV a, int nr, __m128d* rI, __m128d* rQ)
+{	// per-receiver rotation as (Ir, Ir) and (-Qr, Qr), so that one multiply-add rotates a complex sample
+	int i;
+	for (i = 0; i < nr; i++)
+	{
+		rI[i] = _mm_set1_pd (a->Irotate[i]);
+		rQ[i] = _mm_set_pd (a->Qrotate[i], -a->Qrotate[i]);
+	}
+}
+
 void xdiv (MDIV a)
 {
 	if (a->run)
@@ -77,16 +87,19 @@ void xdiv (MDIV a)
 		else
 		{
 			int i, j;
-			double I, Q;
-			memset (a->out, 0, a->size * sizeof (complex));
-			for (i = 0; i < a->nr; i++)
-				for (j = 0; j < a->size; j++)
+			__m128d rI[MAX_NR], rQ[MAX_NR], x, acc;
+			load_rotate_div (a, a->nr, rI, rQ);
+			for (j = 0; j < a->size; j++)
+			{
+				acc = _mm_setzero_pd ();
+				for (i = 0; i < a->nr; i++)
 				{
-					I = a->in[i][2 * j + 0];
-					Q = a->in[i][2 * j + 1];
-					a->out[2 * j + 0] += a->Irotate[i] * I - a->Qrotate[i] * Q;
-					a->out[2 * j + 1] += a->Irotate[i] * Q + a->Qrotate[i] * I;
+					x = _mm_loadu_pd (&a->in[i][2 * j]);
+					acc = _mm_add_pd (acc, _mm_add_pd (_mm_mul_pd (rI[i], x), 
+						_mm_mul_pd (rQ[i], _mm_shuffle_pd (x, x, 1))));
 				}
+				_mm_storeu_pd (&a->out[2 * j], acc);
+			}
 		}
 		LeaveCriticalSection (&a->cs_update);
 	}
@@ -94,6 +107,38 @@ void xdiv (MDIV a)
 		memcpy (a->out, a->in[0], a->size * sizeof (complex));
 }
 
+void xdivIL (MDIV a, int nstreams, double* data)
+{	// fused de-interleave / rotate / accumulate:  sample j of stream i is at data[2 * (nstreams * j + i)]
+	int i, j, nr, stream;
+	__m128d rI[MAX_NR], rQ[MAX_NR], x, acc;
+	double* p;
+	EnterCriticalSection (&a->cs_update);
+	nr = a->nr < nstreams ? a->nr : nstreams;
+	if (a->run && a->output == a->nr)
+	{
+		load_rotate_div (a, nr, rI, rQ);
+		for (j = 0, p = data; j < a->size; j++, p += 2 * nstreams)
+		{
+			acc = _mm_setzero_pd ();
+			for (i = 0; i < nr; i++)
+			{
+				x = _mm_loadu_pd (&p[2 * i]);
+				acc = _mm_add_pd (acc, _mm_add_pd (_mm_mul_pd (rI[i], x), 
+					_mm_mul_pd (rQ[i], _mm_shuffle_pd (x, x, 1))));
+			}
+			_mm_storeu_pd (&a->out[2 * j], acc);
+		}
+	}
+	else
+	{
+		stream = a->run ? a->output : 0;
+		if (stream >= nstreams) stream = 0;
+		for (j = 0, p = data + 2 * stream; j < a->size; j++, p += 2 * nstreams)
+			_mm_storeu_pd (&a->out[2 * j], _mm_loadu_pd (p));
+	}
+	LeaveCriticalSection (&a->cs_update);
+}
+
 
 /********************************************************************************************************
 *																										*
@@ -101,7 +146,7 @@ void xdiv (MDIV a)
 *																										*
 ********************************************************************************************************/
 
-#define MAX_EXT_DIVS	(2)							// maximum number of DIVs called from outside wdsp
+#define MAX_EXT_DIVS	(4)							// maximum number of DIVs called from outside wdsp
 __declspec (align (16)) MDIV pdiv[MAX_EXT_DIVS];	// array of pointers for DIVs used EXTERNAL to wdsp
 
 PORT
@@ -133,6 +178,17 @@ void xdivEXT (int id, int nsamples, double **in, double *out)
 	xdiv (a);
 }
 
+// 'data' holds 'nstreams' interleaved complex streams, as received from the radio;
+//	combines directly from the interleaved payload without a separate de-interleave pass
+PORT
+void xdivEXTIL (int id, int nsamples, int nstreams, double *data, double *out)
+{
+	MDIV a = pdiv[id];
+	a->size = nsamples;
+	a->out = out;
+	xdivIL (a, nstreams, data);
+}
+
 // 0 - does nothing; 1 - operates
 PORT
 void SetEXTDIVRun (int id, int run)
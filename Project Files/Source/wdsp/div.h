@@ -47,8 +47,12 @@ extern void destroy_div (MDIV pdiv);
 
 extern void xdiv (MDIV pdiv);
 
+extern void xdivIL (MDIV pdiv, int nstreams, double* data);
+
 extern __declspec(dllexport) void xdivEXT (int id, int nsamples, double **in, double *out);
 
+extern __declspec(dllexport) void xdivEXTIL (int id, int nsamples, int nstreams, double *data, double *out);
+
 extern __declspec(dllexport) void create_divEXT (int id, int run, int nr, int size);
 
 extern __declspec(dllexport) void destroy_divEXT (int id);
@@ -0,0 +1,124 @@
+/*  dshm.h
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+// Layout of the shared-memory publications and the reader library (dshmread.c).  Nothing here depends on
+// the rest of wdsp, so other programs may build dshmread.c with this header to read the publications.
+
+#ifndef _dshm_h
+#define _dshm_h
+#include <Windows.h>
+
+#define DSHM_MAGIC						0x4D485344			// 'DSHM'
+#define DSHM_VERSION					1
+#define DSHM_SLOTS						4					// pixel frames held per display
+#define DSHM_MAX_READERS				16					// readers that can be woken per display
+#define DSHM_CHANNELS					32					// channels in the meter publication
+#define DSHM_MAX_METERS					24					// meter values per channel
+#define DSHM_DISPLAY_NAME				"Local\\wdsp_display_%d"
+#define DSHM_EVENT_NAME					"Local\\wdsp_display_%d_%08lx"
+#define DSHM_METERS_NAME				"Local\\wdsp_meters"
+
+typedef struct _dshm_frame
+{
+	volatile long seq;							// odd while the slot is being written
+	int num_pixels;
+	long serial;								// frame number, from 0
+	long long qpc;								// QueryPerformanceCounter() when published
+	double f_min;								// frequency at the first pixel
+	double f_max;								// frequency at the last pixel
+} dshm_frame;
+
+typedef struct _dshm_display
+{	// followed, at offset 'data', by DSHM_SLOTS rows of 'max_pixels' floats
+	long magic;
+	long version;
+	long bytes;									// size of the mapping
+	long data;									// offset of the pixel rows
+	int max_pixels;
+	int pixout;									// analyzer pixel output being published
+	volatile long closed;						// set when the publisher stops; readers should reopen
+	volatile long frames;						// frames published; the newest is in slot (frames - 1) % DSHM_SLOTS
+	volatile long gen;							// source of reader event ids
+	volatile long readers[DSHM_MAX_READERS];	// event id of each attached reader, 0 if free
+	dshm_frame frame[DSHM_SLOTS];
+} dshm_display;
+
+typedef struct _dshm_meter
+{
+	volatile long seq;							// odd while the block is being written
+	int type;									// channel type:  0 - RXA; 1 - TXA; -1 - not published
+	int n;										// number of values, indexed by the RXA or TXA meter type
+	long count;									// number of snapshots published
+	long long qpc;								// QueryPerformanceCounter() when published
+	double val[DSHM_MAX_METERS];
+} dshm_meter;
+
+typedef struct _dshm_meters
+{
+	long magic;
+	long version;
+	long bytes;
+	volatile long closed;
+	dshm_meter ch[DSHM_CHANNELS];
+} dshm_meters;
+
+// Reader library
+
+typedef struct _dshm_reader
+{
+	HANDLE hmap;
+	dshm_display* d;
+	const float* pix;
+	HANDLE hev;									// set by the publisher after each frame
+	int slot;									// index in d->readers[], -1 if the reader is not woken
+	long last;									// serial of the last frame read, -1 for none
+} dshm_reader, *DSHM_READER;
+
+typedef struct _dshm_meter_reader
+{
+	HANDLE hmap;
+	dshm_meters* m;
+} dshm_meter_reader, *DSHM_METER_READER;
+
+extern DSHM_READER dshm_open_display (int disp);
+
+extern void dshm_close_display (DSHM_READER r);
+
+extern int dshm_wait_frame (DSHM_READER r, DWORD timeout);
+
+extern int dshm_read_frame (DSHM_READER r, float* pix, int max_pixels, dshm_frame* hdr);
+
+extern const float* dshm_acquire_frame (DSHM_READER r, dshm_frame* hdr);
+
+extern int dshm_release_frame (DSHM_READER r, const dshm_frame* hdr);
+
+extern DSHM_METER_READER dshm_open_meters (void);
+
+extern void dshm_close_meters (DSHM_METER_READER r);
+
+extern int dshm_read_meters (DSHM_METER_READER r, int channel, double* vals, int max_vals, long long* qpc, long* count);
+
+#endif
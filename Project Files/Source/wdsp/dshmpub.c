@@ -0,0 +1,243 @@
+/*  dshmpub.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+#include "comm.h"
+
+/********************************************************************************************************
+*																										*
+*									Shared-Memory Publication											*
+*																										*
+********************************************************************************************************/
+
+// Publishes each pixel frame of a display, and the meter values of every channel, in named shared memory
+// so any number of local readers can take them without calling GetPixels() or the meter getters.  The
+// layout and the reader library are in dshm.h and dshmread.c.
+
+void* create_dshm_map (const char* name, long bytes, HANDLE* hmap, int* existed)
+{
+	void* p = 0;
+	if ((*hmap = CreateFileMappingA (INVALID_HANDLE_VALUE, 0, PAGE_READWRITE, 0, bytes, name)) != 0)
+	{
+		*existed = GetLastError () == ERROR_ALREADY_EXISTS;
+		if ((p = MapViewOfFile (*hmap, FILE_MAP_ALL_ACCESS, 0, 0, 0)) == 0)
+			CloseHandle (*hmap);
+	}
+	return p;
+}
+
+DSHMPUB create_dshmpub (int disp, int pixout, int max_pixels)
+{	// reuses the mapping if readers are still holding it from an earlier publication, so they keep working
+	DSHMPUB a = (DSHMPUB) malloc0 (sizeof (dshmpub));
+	char name[64];
+	int existed;
+	long data = (sizeof (dshm_display) + 63) & ~63;
+	long bytes = data + DSHM_SLOTS * max_pixels * sizeof (float);
+	a->disp = disp;
+	sprintf_s (name, sizeof (name), DSHM_DISPLAY_NAME, disp);
+	if ((a->d = (dshm_display *) create_dshm_map (name, bytes, &a->hmap, &existed)) == 0)
+	{
+		_aligned_free (a);
+		return 0;
+	}
+	if (existed && a->d->magic == DSHM_MAGIC && a->d->version == DSHM_VERSION)
+	{
+		if (a->d->bytes < bytes)
+			max_pixels = (a->d->bytes - a->d->data) / (DSHM_SLOTS * sizeof (float));
+	}
+	else
+	{
+		memset (a->d, 0, sizeof (dshm_display));
+		a->d->bytes = bytes;
+		a->d->data = data;
+	}
+	a->max_pixels = max_pixels;
+	a->pix = (float *)((char *)a->d + a->d->data);
+	a->d->max_pixels = max_pixels;
+	a->d->pixout = pixout;
+	a->d->closed = 0;
+	a->d->version = DSHM_VERSION;
+	MemoryBarrier ();
+	a->d->magic = DSHM_MAGIC;
+	return a;
+}
+
+void destroy_dshmpub (DSHMPUB a)
+{
+	int i;
+	InterlockedExchange (&a->d->closed, 1);
+	for (i = 0; i < DSHM_MAX_READERS; i++)
+		if (a->hev[i]) CloseHandle (a->hev[i]);
+	UnmapViewOfFile (a->d);
+	CloseHandle (a->hmap);
+	_aligned_free (a);
+}
+
+void xdshmpub (DSHMPUB a, int n, double f_min, double f_max, dOUTREAL* pixels)
+{
+	if (!InterlockedExchange (&a->busy, 1))
+	{
+		int i;
+		char name[64];
+		long id;
+		LARGE_INTEGER now;
+		long f = a->d->frames;
+		dshm_frame* fr = &a->d->frame[f % DSHM_SLOTS];
+		float* p = a->pix + (f % DSHM_SLOTS) * a->max_pixels;
+		if (n > a->max_pixels) n = a->max_pixels;
+		QueryPerformanceCounter (&now);
+		InterlockedIncrement (&fr->seq);
+		fr->num_pixels = n;
+		fr->serial = f;
+		fr->qpc = now.QuadPart;
+		fr->f_min = f_min;
+		fr->f_max = f_max;
+		for (i = 0; i < n; i++)
+			p[i] = (float)pixels[i];
+		InterlockedIncrement (&fr->seq);
+		InterlockedExchange (&a->d->frames, f + 1);
+		for (i = 0; i < DSHM_MAX_READERS; i++)
+		{	// wake the attached readers, opening the event of any that attached since the last frame
+			if ((id = a->d->readers[i]) != a->id[i])
+			{
+				if (a->hev[i]) CloseHandle (a->hev[i]);
+				a->hev[i] = 0;
+				if ((a->id[i] = id) != 0)
+				{
+					sprintf_s (name, sizeof (name), DSHM_EVENT_NAME, a->disp, id);
+					a->hev[i] = OpenEventA (EVENT_MODIFY_STATE, FALSE, name);
+				}
+			}
+			if (a->hev[i]) SetEvent (a->hev[i]);
+		}
+		InterlockedExchange (&a->busy, 0);
+	}
+}
+
+/********************************************************************************************************
+*																										*
+*											Meters														*
+*																										*
+********************************************************************************************************/
+
+HANDLE hmtrshm;
+dshm_meters* volatile pmtrshm;
+volatile long mtrshm_users[DSHM_CHANNELS];		// per channel, 1 while its dsp thread may be using 'pmtrshm'
+
+void xdshm_meters (int channel)
+{	// called by the channel's dsp thread after each buffer, so its meter values are settled
+	dshm_meters* m;
+	InterlockedIncrement (&mtrshm_users[channel]);
+	if (m = pmtrshm)
+	{
+		dshm_meter* b = &m->ch[channel];
+		LARGE_INTEGER now;
+		double* v;
+		int n;
+		switch (ch[channel].type)
+		{
+		case 0:
+			v = rxa[channel].meter;
+			n = RXA_METERTYPE_LAST;
+			break;
+		case 1:
+			v = txa[channel].meter;
+			n = TXA_METERTYPE_LAST;
+			break;
+		default:
+			v = 0;
+			n = 0;
+			break;
+		}
+		if (n > DSHM_MAX_METERS) n = DSHM_MAX_METERS;
+		if (n > 0)
+		{
+			QueryPerformanceCounter (&now);
+			InterlockedIncrement (&b->seq);
+			b->type = ch[channel].type;
+			b->n = n;
+			b->count++;
+			b->qpc = now.QuadPart;
+			memcpy (b->val, v, n * sizeof (double));
+			InterlockedIncrement (&b->seq);
+		}
+	}
+	InterlockedDecrement (&mtrshm_users[channel]);
+}
+
+/********************************************************************************************************
+*																										*
+*											Properties													*
+*																										*
+********************************************************************************************************/
+
+PORT
+void SetDisplayShm (int disp, int pixout, int run, int max_pixels)
+{	// run = 1 publishes the frames of 'pixout' as "Local\wdsp_display_<disp>"; run = 0 stops publishing
+	DP a = pdisp[disp];
+	DSHMPUB old;
+	EnterCriticalSection (&a->SetAnalyzerSection);
+	old = (DSHMPUB)InterlockedExchangePointer ((void* volatile*)&a->shm, run ? create_dshmpub (disp, pixout, max_pixels) : 0);
+	if (old)
+	{	// a stitch that captured 'old' before the exchange is still counted in stitch_users
+		while (_InterlockedAnd (&a->stitch_users, 0xffffffff)) Sleep (0);
+		destroy_dshmpub (old);
+	}
+	LeaveCriticalSection (&a->SetAnalyzerSection);
+}
+
+PORT
+void SetMeterShm (int run)
+{	// run = 1 publishes the meter values of every channel as "Local\wdsp_meters"; run = 0 stops publishing
+	dshm_meters* m;
+	int i, existed;
+	if (run && !pmtrshm)
+	{
+		if ((m = (dshm_meters *) create_dshm_map (DSHM_METERS_NAME, sizeof (dshm_meters), &hmtrshm, &existed)) != 0)
+		{
+			if (!existed || m->magic != DSHM_MAGIC || m->version != DSHM_VERSION)
+			{
+				memset (m, 0, sizeof (dshm_meters));
+				m->bytes = sizeof (dshm_meters);
+				for (i = 0; i < DSHM_CHANNELS; i++)
+					m->ch[i].type = -1;
+			}
+			m->closed = 0;
+			m->version = DSHM_VERSION;
+			MemoryBarrier ();
+			m->magic = DSHM_MAGIC;
+			InterlockedExchangePointer ((void* volatile*)&pmtrshm, m);
+		}
+	}
+	else if (!run && pmtrshm)
+	{
+		m = (dshm_meters *)InterlockedExchangePointer ((void* volatile*)&pmtrshm, 0);
+		for (i = 0; i < DSHM_CHANNELS; i++)						// wait out any snapshot that captured 'm'
+			while (_InterlockedAnd (&mtrshm_users[i], 0xffffffff)) Sleep (0);
+		InterlockedExchange (&m->closed, 1);
+		UnmapViewOfFile (m);
+		CloseHandle (hmtrshm);
+	}
+}
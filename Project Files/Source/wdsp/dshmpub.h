@@ -0,0 +1,58 @@
+/*  dshmpub.h
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+#ifndef _dshmpub_h
+#define _dshmpub_h
+#include "comm.h"
+#include "dshm.h"
+
+typedef struct _dshmpub
+{
+	int disp;
+	int max_pixels;
+	HANDLE hmap;
+	dshm_display* d;
+	float* pix;									// DSHM_SLOTS rows of max_pixels
+	volatile long busy;							// a frame is being published
+	long id[DSHM_MAX_READERS];					// reader event ids that hev[] was opened for
+	HANDLE hev[DSHM_MAX_READERS];
+} dshmpub, *DSHMPUB;
+
+extern DSHMPUB create_dshmpub (int disp, int pixout, int max_pixels);
+
+extern void destroy_dshmpub (DSHMPUB a);
+
+extern void xdshmpub (DSHMPUB a, int n, double f_min, double f_max, dOUTREAL* pixels);
+
+extern void xdshm_meters (int channel);
+
+// Properties
+
+extern __declspec (dllexport) void SetDisplayShm (int disp, int pixout, int run, int max_pixels);
+
+extern __declspec (dllexport) void SetMeterShm (int run);
+
+#endif
@@ -0,0 +1,209 @@
+/*  dshmread.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dshm.h"
+
+/********************************************************************************************************
+*																										*
+*									Shared-Memory Reader Library										*
+*																										*
+********************************************************************************************************/
+
+// Readers of the display and meter publications written by dshmpub.c.  Each display mapping holds the
+// last DSHM_SLOTS pixel frames, each guarded by a sequence count; a reader copies the newest frame, or
+// uses it in place and checks afterwards that it was not overwritten.  A reader that gets one of the
+// DSHM_MAX_READERS wake-up slots is signalled through its own event after every frame; others poll.
+
+void* dshm_map (const char* name, HANDLE* hmap)
+{
+	void* p = 0;
+	if ((*hmap = OpenFileMappingA (FILE_MAP_ALL_ACCESS, FALSE, name)) != 0)
+		if ((p = MapViewOfFile (*hmap, FILE_MAP_ALL_ACCESS, 0, 0, 0)) == 0)
+			CloseHandle (*hmap);
+	return p;
+}
+
+DSHM_READER dshm_open_display (int disp)
+{	// returns 0 if the display is not being published
+	char name[64];
+	long id;
+	int i;
+	DSHM_READER r = (DSHM_READER) calloc (1, sizeof (dshm_reader));
+	sprintf (name, DSHM_DISPLAY_NAME, disp);
+	if ((r->d = (dshm_display *) dshm_map (name, &r->hmap)) == 0)
+	{
+		free (r);
+		return 0;
+	}
+	if (r->d->magic != DSHM_MAGIC || r->d->version != DSHM_VERSION)
+	{
+		UnmapViewOfFile (r->d);
+		CloseHandle (r->hmap);
+		free (r);
+		return 0;
+	}
+	r->pix = (const float *)((const char *)r->d + r->d->data);
+	r->slot = -1;
+	r->last = -1;
+	id = InterlockedIncrement (&r->d->gen);
+	sprintf (name, DSHM_EVENT_NAME, disp, id);
+	if ((r->hev = CreateEventA (0, FALSE, FALSE, name)) != 0)
+		for (i = 0; i < DSHM_MAX_READERS; i++)
+			if (InterlockedCompareExchange (&r->d->readers[i], id, 0) == 0)
+			{
+				r->slot = i;
+				break;
+			}
+	return r;
+}
+
+void dshm_close_display (DSHM_READER r)
+{
+	if (r->slot >= 0)
+		InterlockedExchange (&r->d->readers[r->slot], 0);
+	if (r->hev)
+		CloseHandle (r->hev);
+	UnmapViewOfFile (r->d);
+	CloseHandle (r->hmap);
+	free (r);
+}
+
+int dshm_wait_frame (DSHM_READER r, DWORD timeout)
+{	// 1 if a frame newer than the last one read is available, 0 on timeout, -1 if the publisher stopped
+	DWORD t0 = GetTickCount ();
+	DWORD elapsed;
+	for (;;)
+	{
+		if (r->d->closed) return -1;
+		if (r->d->frames - 1 > r->last) return 1;
+		elapsed = GetTickCount () - t0;
+		if (timeout != INFINITE && elapsed >= timeout) return 0;
+		if (r->slot >= 0)
+			WaitForSingleObject (r->hev, timeout == INFINITE ? INFINITE : timeout - elapsed);
+		else
+			Sleep (1);
+	}
+}
+
+int dshm_read_frame (DSHM_READER r, float* pix, int max_pixels, dshm_frame* hdr)
+{	// copies the newest frame; returns the number of pixels copied, 0 if nothing has been published
+	long f, seq;
+	int slot, n;
+	dshm_frame* fr;
+	do
+	{
+		if ((f = r->d->frames) == 0) return 0;
+		slot = (f - 1) % DSHM_SLOTS;
+		fr = &r->d->frame[slot];
+		seq = fr->seq;
+		MemoryBarrier ();
+		*hdr = *fr;
+		n = hdr->num_pixels < max_pixels ? hdr->num_pixels : max_pixels;
+		memcpy (pix, r->pix + slot * r->d->max_pixels, n * sizeof (float));
+		MemoryBarrier ();
+	} while ((seq & 1) || fr->seq != seq);
+	hdr->seq = seq;
+	r->last = hdr->serial;
+	return n;
+}
+
+const float* dshm_acquire_frame (DSHM_READER r, dshm_frame* hdr)
+{	// zero-copy access to the newest frame; the pixels may only be trusted if dshm_release_frame() returns 1
+	long f, seq;
+	int slot;
+	dshm_frame* fr;
+	do
+	{
+		if ((f = r->d->frames) == 0) return 0;
+		slot = (f - 1) % DSHM_SLOTS;
+		fr = &r->d->frame[slot];
+		seq = fr->seq;
+		MemoryBarrier ();
+		*hdr = *fr;
+		MemoryBarrier ();
+	} while ((seq & 1) || fr->seq != seq);
+	hdr->seq = seq;
+	r->last = hdr->serial;
+	return r->pix + slot * r->d->max_pixels;
+}
+
+int dshm_release_frame (DSHM_READER r, const dshm_frame* hdr)
+{	// 1 if the frame from dshm_acquire_frame() was not overwritten while it was in use
+	MemoryBarrier ();
+	return r->d->frame[hdr->serial % DSHM_SLOTS].seq == hdr->seq;
+}
+
+DSHM_METER_READER dshm_open_meters (void)
+{	// returns 0 if the meters are not being published
+	DSHM_METER_READER r = (DSHM_METER_READER) calloc (1, sizeof (dshm_meter_reader));
+	if ((r->m = (dshm_meters *) dshm_map (DSHM_METERS_NAME, &r->hmap)) == 0)
+	{
+		free (r);
+		return 0;
+	}
+	if (r->m->magic != DSHM_MAGIC || r->m->version != DSHM_VERSION)
+	{
+		dshm_close_meters (r);
+		return 0;
+	}
+	return r;
+}
+
+void dshm_close_meters (DSHM_METER_READER r)
+{
+	UnmapViewOfFile (r->m);
+	CloseHandle (r->hmap);
+	free (r);
+}
+
+int dshm_read_meters (DSHM_METER_READER r, int channel, double* vals, int max_vals, long long* qpc, long* count)
+{	// latest meter values of a channel, indexed by RXA or TXA meter type; returns the number copied,
+	// 0 if the channel is not published, -1 if the publisher stopped
+	long seq;
+	int n;
+	dshm_meter* b = &r->m->ch[channel];
+	if (r->m->closed) return -1;
+	do
+	{
+		seq = b->seq;
+		MemoryBarrier ();
+		if (b->type < 0)
+			n = 0;
+		else
+		{
+			n = b->n < max_vals ? b->n : max_vals;
+			memcpy (vals, b->val, n * sizeof (double));
+			*qpc = b->qpc;
+			*count = b->count;
+		}
+		MemoryBarrier ();
+	} while ((seq & 1) || b->seq != seq);
+	return n;
+}
@@ -213,42 +213,14 @@ void calc_emnr(EMNR a)
 		3.100, 3.380, 4.150, 4.350, 4.250, 3.900, 4.100, 4.700, 5.000 };
 	a->incr = a->fsize / a->ovrlp;
 	a->gain = a->ogain / a->fsize / (double)a->ovrlp;
-	if (a->fsize > a->bsize)
-		a->iasize = a->fsize;
-	else
-		a->iasize = a->bsize + a->fsize - a->incr;
-	a->iainidx = 0;
-	a->iaoutidx = 0;
-	if (a->fsize > a->bsize)
-	{
-		if (a->bsize > a->incr)  a->oasize = a->bsize;
-		else					 a->oasize = a->incr;
-		a->oainidx = (a->fsize - a->bsize - a->incr) % a->oasize;
-	}
-	else
-	{
-		a->oasize = a->bsize;
-		a->oainidx = a->fsize - a->incr;
-	}
-	a->init_oainidx = a->oainidx;
-	a->oaoutidx = 0;
 	a->msize = a->fsize / 2 + 1;
 	a->window = (double *)malloc0(a->fsize * sizeof(double));
-	a->inaccum = (double *)malloc0(a->iasize * sizeof(double));
-	a->forfftin = (double *)malloc0(a->fsize * sizeof(double));
-	a->forfftout = (double *)malloc0(a->msize * sizeof(complex));
 	a->mask = (double *)malloc0(a->msize * sizeof(double));
-	a->revfftin = (double *)malloc0(a->msize * sizeof(complex));
-	a->revfftout = (double *)malloc0(a->fsize * sizeof(double));
-	a->save = (double **)malloc0(a->ovrlp * sizeof(double *));
-	for (i = 0; i < a->ovrlp; i++)
-		a->save[i] = (double *)malloc0(a->fsize * sizeof(double));
-	a->outaccum = (double *)malloc0(a->oasize * sizeof(double));
-	a->nsamps = 0;
-	a->saveidx = 0;
-	a->Rfor = fftw_plan_dft_r2c_1d(a->fsize, a->forfftin, (fftw_complex *)a->forfftout, FFTW_ESTIMATE);
-	a->Rrev = fftw_plan_dft_c2r_1d(a->fsize, (fftw_complex *)a->revfftin, a->revfftout, FFTW_ESTIMATE);
+	a->stft = create_stft (a->bsize, a->in, a->out, a->fsize, a->ovrlp, frame_emnr, (void *)a);
+	a->forfftout = a->stft->forfftout;
+	a->revfftin = a->stft->revfftin;
 	calc_window(a);
+	setWindow_stft (a->stft, a->window, 1.0, 1.0);
 
 	a->g.msize = a->msize;
 	a->g.mask = a->mask;
@@ -411,9 +383,6 @@ void calc_emnr(EMNR a)
 	a->ae.msize = a->msize;
 	a->ae.lambda_y = a->g.lambda_y;
 
-	a->ae.zetaThresh = 0.75;
-	a->ae.psi = 10.0;
-
 	a->ae.nmask = (double *)malloc0(a->ae.msize * sizeof(double));
 }
 
@@ -452,18 +421,8 @@ void decalc_emnr(EMNR a)
 	_aligned_free(a->g.lambda_d);
 	_aligned_free(a->g.lambda_y);
 
-	fftw_destroy_plan(a->Rrev);
-	fftw_destroy_plan(a->Rfor);
-	_aligned_free(a->outaccum);
-	for (i = 0; i < a->ovrlp; i++)
-		_aligned_free(a->save[i]);
-	_aligned_free(a->save);
-	_aligned_free(a->revfftout);
-	_aligned_free(a->revfftin);
+	destroy_stft (a->stft);
 	_aligned_free(a->mask);
-	_aligned_free(a->forfftout);
-	_aligned_free(a->forfftin);
-	_aligned_free(a->inaccum);
 	_aligned_free(a->window);
 }
 
@@ -485,31 +444,67 @@ EMNR create_emnr (int run, int position, int size, double* in, double* out, int
 	a->g.gain_method = gain_method;
 	a->g.npe_method = npe_method;
 	a->g.ae_run = ae_run;
-	calc_emnr (a);
+	a->ae.zetaThresh = 0.75;
+	a->ae.psi = 10.0;
+	if (a->run) materialize_emnr (a);
 	return a;
 }
 
 void flush_emnr (EMNR a)
 {
-	int i;
-	memset (a->inaccum, 0, a->iasize * sizeof (double));
-	for (i = 0; i < a->ovrlp; i++)
-		memset (a->save[i], 0, a->fsize * sizeof (double));
-	memset (a->outaccum, 0, a->oasize * sizeof (double));
-	a->nsamps   = 0;
-	a->iainidx  = 0;
-	a->iaoutidx = 0;
-	a->oainidx  = a->init_oainidx;
-	a->oaoutidx = 0;
-	a->saveidx  = 0;
+	if (a->live)
+		flush_stft (a->stft);
 }
 
 void destroy_emnr (EMNR a)
 {
-	decalc_emnr (a);
+	release_emnr (a);
 	_aligned_free (a);
 }
 
+void materialize_emnr (EMNR a)
+{	// allocates the internals of a block that was created, or later released, while not running
+	if (!a->live)
+	{
+		calc_emnr (a);
+		a->live = 1;
+	}
+}
+
+void release_emnr (EMNR a)
+{
+	if (a->live)
+	{
+		a->live = 0;
+		decalc_emnr (a);
+	}
+}
+
+void stage_emnr (EMNR a, CRITICAL_SECTION* cs)
+{	// materializes 'a' without holding 'cs' across the allocations and fft planning:  the internals are
+	// built in a private copy, then adopted under 'cs' only if nothing changed the block in the meantime
+	EMNR s = (EMNR) malloc0 (sizeof (emnr));
+	EMNR b = (EMNR) malloc0 (sizeof (emnr));
+	EnterCriticalSection (cs);
+	while (!a->live)
+	{
+		memcpy (s, a, sizeof (emnr));
+		memcpy (b, a, sizeof (emnr));
+		LeaveCriticalSection (cs);
+		materialize_emnr (b);
+		b->stft->ptr = (void *)a;						// frame_emnr must see the adopted block
+		QueryPerformanceCounter (&b->toff);				// the idle-release timer starts now
+		EnterCriticalSection (cs);
+		if (memcmp (a, s, sizeof (emnr)) == 0)
+			memcpy (a, b, sizeof (emnr));
+		else
+			release_emnr (b);
+	}
+	LeaveCriticalSection (cs);
+	_aligned_free (b);
+	_aligned_free (s);
+}
+
 void LambdaD(EMNR a)
 {
 	int k;
@@ -807,57 +802,24 @@ void calc_gain (EMNR a)
 	if (a->g.ae_run) aepf(a);
 }
 
-void xemnr (EMNR a, int pos)
+void frame_emnr (void* ptr)
 {
-	if (a->run && pos == a->position)
+	EMNR a = (EMNR)ptr;
+	int i;
+	double g1;
+	calc_gain(a);
+	for (i = 0; i < a->msize; i++)
 	{
-		int i, j, k, sbuff, sbegin;
-		double g1;
-		for (i = 0; i < 2 * a->bsize; i += 2)
-		{
-			a->inaccum[a->iainidx] = a->in[i];
-			a->iainidx = (a->iainidx + 1) % a->iasize;
-		}
-		a->nsamps += a->bsize;
-		while (a->nsamps >= a->fsize)
-		{
-			for (i = 0, j = a->iaoutidx; i < a->fsize; i++, j = (j + 1) % a->iasize)
-				a->forfftin[i] = a->window[i] * a->inaccum[j];
-			a->iaoutidx = (a->iaoutidx + a->incr) % a->iasize;
-			a->nsamps -= a->incr;
-			fftw_execute (a->Rfor);
-			calc_gain(a);
-			for (i = 0; i < a->msize; i++)
-			{
-				g1 = a->gain * a->mask[i];
-				a->revfftin[2 * i + 0] = g1 * a->forfftout[2 * i + 0];
-				a->revfftin[2 * i + 1] = g1 * a->forfftout[2 * i + 1];
-			}
-			fftw_execute (a->Rrev);
-			for (i = 0; i < a->fsize; i++)
-				a->save[a->saveidx][i] = a->window[i] * a->revfftout[i];
-			for (i = a->ovrlp; i > 0; i--)
-			{
-				sbuff = (a->saveidx + i) % a->ovrlp;
-				sbegin = a->incr * (a->ovrlp - i);
-				for (j = sbegin, k = a->oainidx; j < a->incr + sbegin; j++, k = (k + 1) % a->oasize)
-				{
-					if ( i == a->ovrlp)
-						a->outaccum[k]  = a->save[sbuff][j];
-					else
-						a->outaccum[k] += a->save[sbuff][j];
-				}
-			}
-			a->saveidx = (a->saveidx + 1) % a->ovrlp;
-			a->oainidx = (a->oainidx + a->incr) % a->oasize;
-		}
-		for (i = 0; i < a->bsize; i++)
-		{
-			a->out[2 * i + 0] = a->outaccum[a->oaoutidx];
-			a->out[2 * i + 1] = 0.0;
-			a->oaoutidx = (a->oaoutidx + 1) % a->oasize;
-		}
+		g1 = a->gain * a->mask[i];
+		a->revfftin[2 * i + 0] = g1 * a->forfftout[2 * i + 0];
+		a->revfftin[2 * i + 1] = g1 * a->forfftout[2 * i + 1];
 	}
+}
+
+void xemnr (EMNR a, int pos)
+{
+	if (a->run && pos == a->position)
+		xstft (a->stft);
 	else if (a->out != a->in)
 		memcpy (a->out, a->in, a->bsize * sizeof (complex));
 }
@@ -866,20 +828,22 @@ void setBuffers_emnr (EMNR a, double* in, double* out)
 {
 	a->in = in;
 	a->out = out;
+	if (a->live)
+		setBuffers_stft (a->stft, a->in, a->out);
 }
 
 void setSamplerate_emnr (EMNR a, int rate)
 {
-	decalc_emnr (a);
+	if (a->live) decalc_emnr (a);
 	a->rate = rate;
-	calc_emnr (a);
+	if (a->live) calc_emnr (a);
 }
 
 void setSize_emnr (EMNR a, int size)
 {
-	decalc_emnr (a);
+	if (a->live) decalc_emnr (a);
 	a->bsize = size;
-	calc_emnr (a);
+	if (a->live) calc_emnr (a);
 }
 
 /********************************************************************************************************
@@ -894,9 +858,12 @@ void SetRXAEMNRRun (int channel, int run)
 	EMNR a = rxa[channel].emnr.p;
 	if (a->run != run)
 	{
+		if (run) stage_emnr (a, &ch[channel].csDSP);
 		RXAbp1Check (channel, rxa[channel].amd.p->run, rxa[channel].snba.p->run, 
 			run, rxa[channel].anf.p->run, rxa[channel].anr.p->run);
 		EnterCriticalSection (&ch[channel].csDSP);
+		if (run) materialize_emnr (a);			// no-op unless released since staging
+		else     QueryPerformanceCounter (&a->toff);
 		a->run = run;
 		RXAbp1Set (channel);
 		LeaveCriticalSection (&ch[channel].csDSP);
@@ -30,6 +30,8 @@ warren@wpratt.com
 typedef struct _emnr
 {
 	int run;
+	int live;					// internals are allocated; only while live may 'run' be set
+	LARGE_INTEGER toff;			// time at which 'run' was last cleared
 	int position;
 	int bsize;
 	double* in;
@@ -38,30 +40,15 @@ typedef struct _emnr
 	int ovrlp;
 	int incr;
 	double* window;
-	int iasize;
-	double* inaccum;
-	double* forfftin;
+	STFT stft;
 	double* forfftout;
 	int msize;
 	double* mask;
 	double* revfftin;
-	double* revfftout;
-	double** save;
-	int oasize;
-	double* outaccum;
 	double rate;
 	int wintype;
 	double ogain;
 	double gain;
-	int nsamps;
-	int iainidx;
-	int iaoutidx;
-	int init_oainidx;
-	int oainidx;
-	int oaoutidx;
-	int saveidx;
-	fftw_plan Rfor;
-	fftw_plan Rrev;
 	struct _g
 	{
 		int gain_method;
@@ -162,6 +149,14 @@ extern void destroy_emnr (EMNR a);
 
 extern void flush_emnr (EMNR a);
 
+extern void materialize_emnr (EMNR a);
+
+extern void release_emnr (EMNR a);
+
+extern void stage_emnr (EMNR a, CRITICAL_SECTION* cs);
+
+extern void frame_emnr (void* ptr);
+
 extern void xemnr (EMNR a, int pos);
 
 extern void setBuffers_emnr (EMNR a, double* in, double* out);
@@ -170,14 +170,18 @@ void calc_emph (EMPH a)
 	a->infilt = (double *)malloc0(2 * a->size * sizeof(complex));
 	a->product = (double *)malloc0(2 * a->size * sizeof(complex));
 	a->mults = fc_mults(a->size, a->f_low, a->f_high, -20.0 * log10(a->f_high / a->f_low), 0.0, a->ctype, a->rate, 1.0 / (2.0 * a->size), 0, 0);
+	enter_planner ();
 	a->CFor = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->infilt, (fftw_complex *)a->product, FFTW_FORWARD, FFTW_PATIENT);
 	a->CRev = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->product, (fftw_complex *)a->out, FFTW_BACKWARD, FFTW_PATIENT);
+	leave_planner ();
 }
 
 void decalc_emph (EMPH a)
 {
+	enter_planner ();
 	fftw_destroy_plan(a->CRev);
 	fftw_destroy_plan(a->CFor);
+	leave_planner ();
 	_aligned_free(a->mults);
 	_aligned_free(a->product);
 	_aligned_free(a->infilt);
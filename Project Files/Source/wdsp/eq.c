@@ -289,10 +289,13 @@ void SetRXAEQProfile (int channel, int nfreqs, double* F, double* G)
 	a->G = (double *) malloc0 ((a->nfreqs + 1) * sizeof (double));
 	memcpy (a->F, F, (nfreqs + 1) * sizeof (double));
 	memcpy (a->G, G, (nfreqs + 1) * sizeof (double));
-	impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, 
-		a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
-	setImpulse_fircore (a->p, impulse, 1);
-	_aligned_free (impulse);
+	if (!DeferChannelUpdate (channel, RXA_UPD_EQP))
+	{
+		impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, 
+			a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
+		setImpulse_fircore (a->p, impulse, 1);
+		_aligned_free (impulse);
+	}
 }
 
 PORT
@@ -302,9 +305,12 @@ void SetRXAEQCtfmode (int channel, int mode)
 	double* impulse;
 	a = rxa[channel].eqp.p;
 	a->ctfmode = mode;
-	impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
-	setImpulse_fircore (a->p, impulse, 1);
-	_aligned_free (impulse);
+	if (!DeferChannelUpdate (channel, RXA_UPD_EQP))
+	{
+		impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
+		setImpulse_fircore (a->p, impulse, 1);
+		_aligned_free (impulse);
+	}
 }
 
 PORT
@@ -314,9 +320,12 @@ void SetRXAEQWintype (int channel, int wintype)
 	double* impulse;
 	a = rxa[channel].eqp.p;
 	a->wintype = wintype;
-	impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
-	setImpulse_fircore (a->p, impulse, 1);
-	_aligned_free (impulse);
+	if (!DeferChannelUpdate (channel, RXA_UPD_EQP))
+	{
+		impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
+		setImpulse_fircore (a->p, impulse, 1);
+		_aligned_free (impulse);
+	}
 }
 
 PORT
@@ -340,9 +349,12 @@ void SetRXAGrphEQ (int channel, int *rxeq)
 	a->G[3] = (double)rxeq[2];
 	a->G[4] = (double)rxeq[3];
 	a->ctfmode = 0;
-	impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
-	setImpulse_fircore (a->p, impulse, 1);
-	_aligned_free (impulse);
+	if (!DeferChannelUpdate (channel, RXA_UPD_EQP))
+	{
+		impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
+		setImpulse_fircore (a->p, impulse, 1);
+		_aligned_free (impulse);
+	}
 }
 
 PORT
@@ -370,10 +382,13 @@ void SetRXAGrphEQ10 (int channel, int *rxeq)
 	for (i = 0; i <= a->nfreqs; i++)
 		a->G[i] = (double)rxeq[i];
 	a->ctfmode = 0;
-	impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
-	// print_impulse ("rxeq.txt", a->nc, impulse, 1, 0);
-	setImpulse_fircore (a->p, impulse, 1);
-	_aligned_free (impulse);
+	if (!DeferChannelUpdate (channel, RXA_UPD_EQP))
+	{
+		impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
+		// print_impulse ("rxeq.txt", a->nc, impulse, 1, 0);
+		setImpulse_fircore (a->p, impulse, 1);
+		_aligned_free (impulse);
+	}
 }
 
 /********************************************************************************************************
@@ -432,9 +447,12 @@ void SetTXAEQProfile (int channel, int nfreqs, double* F, double* G)
 	a->G = (double *) malloc0 ((a->nfreqs + 1) * sizeof (double));
 	memcpy (a->F, F, (nfreqs + 1) * sizeof (double));
 	memcpy (a->G, G, (nfreqs + 1) * sizeof (double));
-	impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
-	setImpulse_fircore (a->p, impulse, 1);
-	_aligned_free (impulse);
+	if (!DeferChannelUpdate (channel, TXA_UPD_EQP))
+	{
+		impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
+		setImpulse_fircore (a->p, impulse, 1);
+		_aligned_free (impulse);
+	}
 }
 
 PORT
@@ -444,9 +462,12 @@ void SetTXAEQCtfmode (int channel, int mode)
 	double* impulse;
 	a = txa[channel].eqp.p;
 	a->ctfmode = mode;
-	impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
-	setImpulse_fircore (a->p, impulse, 1);
-	_aligned_free (impulse);
+	if (!DeferChannelUpdate (channel, TXA_UPD_EQP))
+	{
+		impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
+		setImpulse_fircore (a->p, impulse, 1);
+		_aligned_free (impulse);
+	}
 }
 
 PORT
@@ -456,9 +477,12 @@ void SetTXAEQWintype (int channel, int wintype)
 	double* impulse;
 	a = txa[channel].eqp.p;
 	a->wintype = wintype;
-	impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
-	setImpulse_fircore (a->p, impulse, 1);
-	_aligned_free (impulse);
+	if (!DeferChannelUpdate (channel, TXA_UPD_EQP))
+	{
+		impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
+		setImpulse_fircore (a->p, impulse, 1);
+		_aligned_free (impulse);
+	}
 }
 
 PORT
@@ -482,9 +506,12 @@ void SetTXAGrphEQ (int channel, int *txeq)
 	a->G[3] = (double)txeq[2];
 	a->G[4] = (double)txeq[3];
 	a->ctfmode = 0;
-	impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
-	setImpulse_fircore (a->p, impulse, 1);
-	_aligned_free (impulse);
+	if (!DeferChannelUpdate (channel, TXA_UPD_EQP))
+	{
+		impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
+		setImpulse_fircore (a->p, impulse, 1);
+		_aligned_free (impulse);
+	}
 }
 
 PORT
@@ -512,9 +539,12 @@ void SetTXAGrphEQ10 (int channel, int *txeq)
 	for (i = 0; i <= a->nfreqs; i++)
 		a->G[i] = (double)txeq[i];
 	a->ctfmode = 0;
-	impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
-	setImpulse_fircore (a->p, impulse, 1);
-	_aligned_free (impulse);
+	if (!DeferChannelUpdate (channel, TXA_UPD_EQP))
+	{
+		impulse = eq_impulse (a->nc, a->nfreqs, a->F, a->G, a->samplerate, 1.0 / (2.0 * a->size), a->ctfmode, a->wintype);
+		setImpulse_fircore (a->p, impulse, 1);
+		_aligned_free (impulse);
+	}
 }
 
 /********************************************************************************************************
@@ -537,15 +567,19 @@ void calc_eq (EQ a)
 	a->scale = 1.0 / (double)(2 * a->size);
 	a->infilt = (double *)malloc0(2 * a->size * sizeof(complex));
 	a->product = (double *)malloc0(2 * a->size * sizeof(complex));
+	enter_planner ();
 	a->CFor = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->infilt, (fftw_complex *)a->product, FFTW_FORWARD, FFTW_PATIENT);
 	a->CRev = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->product, (fftw_complex *)a->out, FFTW_BACKWARD, FFTW_PATIENT);
+	leave_planner ();
 	a->mults = eq_mults(a->size, a->nfreqs, a->F, a->G, a->samplerate, a->scale, a->ctfmode, a->wintype);
 }
 
 void decalc_eq (EQ a)
 {
+	enter_planner ();
 	fftw_destroy_plan(a->CRev);
 	fftw_destroy_plan(a->CFor);
+	leave_planner ();
 	_aligned_free(a->mults);
 	_aligned_free(a->product);
 	_aligned_free(a->infilt);
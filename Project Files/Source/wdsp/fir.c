@@ -30,13 +30,18 @@ double* fftcv_mults (int NM, double* c_impulse)
 {
 	double* mults        = (double *) malloc0 (NM * sizeof (complex));
 	double* cfft_impulse = (double *) malloc0 (NM * sizeof (complex));
-	fftw_plan ptmp = fftw_plan_dft_1d(NM, (fftw_complex *) cfft_impulse,
+	fftw_plan ptmp;
+	enter_planner ();
+	ptmp = fftw_plan_dft_1d(NM, (fftw_complex *) cfft_impulse,
 			(fftw_complex *) mults, FFTW_FORWARD, FFTW_PATIENT);
+	leave_planner ();
 	memset (cfft_impulse, 0, NM * sizeof (complex));
 	// store complex coefs right-justified in the buffer
 	memcpy (&(cfft_impulse[NM - 2]), c_impulse, (NM / 2 + 1) * sizeof(complex));
 	fftw_execute (ptmp);
+	enter_planner ();
 	fftw_destroy_plan (ptmp);
+	leave_planner ();
 	_aligned_free (cfft_impulse);
 	return mults;
 }
@@ -88,8 +93,11 @@ double* fir_fsamp_odd (int N, double* A, int rtype, double scale, int wintype)
 	double* window;
 	double *fcoef     = (double *) malloc0 (N * sizeof (complex));
 	double *c_impulse = (double *) malloc0 (N * sizeof (complex));
-	fftw_plan ptmp = fftw_plan_dft_1d(N, (fftw_complex *)fcoef, (fftw_complex *)c_impulse, FFTW_BACKWARD, FFTW_PATIENT);
+	fftw_plan ptmp;
 	double local_scale = 1.0 / (double)N;
+	enter_planner ();
+	ptmp = fftw_plan_dft_1d(N, (fftw_complex *)fcoef, (fftw_complex *)c_impulse, FFTW_BACKWARD, FFTW_PATIENT);
+	leave_planner ();
 	for (i = 0; i <= mid; i++)
 	{
 		mag = A[i] * local_scale;
@@ -103,7 +111,9 @@ double* fir_fsamp_odd (int N, double* A, int rtype, double scale, int wintype)
 		fcoef[2 * i + 1] = - fcoef[2 * (mid - j) + 1];
 	}
 	fftw_execute (ptmp);
+	enter_planner ();
 	fftw_destroy_plan (ptmp);
+	leave_planner ();
 	_aligned_free (fcoef);
 	window = get_fsamp_window(N, wintype);
 	switch (rtype)
@@ -295,10 +305,13 @@ void analytic (int N, double* in, double* out)
 	double inv_N = 1.0 / (double)N;
 	double two_inv_N = 2.0 * inv_N;
 	double* x = (double *) malloc0 (N * sizeof (complex));
-	fftw_plan pfor = fftw_plan_dft_1d (N, (fftw_complex *) in,
+	fftw_plan pfor, prev;
+	enter_planner ();
+	pfor = fftw_plan_dft_1d (N, (fftw_complex *) in,
 			(fftw_complex *) x, FFTW_FORWARD, FFTW_PATIENT);
-	fftw_plan prev = fftw_plan_dft_1d (N, (fftw_complex *) x,
+	prev = fftw_plan_dft_1d (N, (fftw_complex *) x,
 			(fftw_complex *) out, FFTW_BACKWARD, FFTW_PATIENT);
+	leave_planner ();
 	fftw_execute (pfor);
 	x[0] *= inv_N;
 	x[1] *= inv_N;
@@ -311,8 +324,10 @@ void analytic (int N, double* in, double* out)
 	x[N + 1] *= inv_N;
 	memset (&x[N + 2], 0, (N - 2) * sizeof (double));
 	fftw_execute (prev);
+	enter_planner ();
 	fftw_destroy_plan (prev);
 	fftw_destroy_plan (pfor);
+	leave_planner ();
 	_aligned_free (x);
 }
 
@@ -327,11 +342,14 @@ void mp_imp (int N, double* fir, double* mpfir, int pfactor, int polarity)
 	double* ana     = (double *) malloc0 (size * sizeof (complex));
 	double* impulse = (double *) malloc0 (size * sizeof (complex));
 	double* newfreq = (double *) malloc0 (size * sizeof (complex));
+	fftw_plan pfor, prev;
 	memcpy (firpad, fir, N * sizeof (complex));
-	fftw_plan pfor = fftw_plan_dft_1d (size, (fftw_complex *) firpad,
+	enter_planner ();
+	pfor = fftw_plan_dft_1d (size, (fftw_complex *) firpad,
 			(fftw_complex *) firfreq, FFTW_FORWARD, FFTW_PATIENT);
-	fftw_plan prev = fftw_plan_dft_1d (size, (fftw_complex *) newfreq,
+	prev = fftw_plan_dft_1d (size, (fftw_complex *) newfreq,
 			(fftw_complex *) impulse, FFTW_BACKWARD, FFTW_PATIENT);
+	leave_planner ();
 	// print_impulse("orig_imp.txt", N, fir, 1, 0);
 	fftw_execute (pfor);
 	for (i = 0; i < size; i++)
@@ -357,8 +375,10 @@ void mp_imp (int N, double* fir, double* mpfir, int pfactor, int polarity)
 	else
 		memcpy (mpfir, impulse, N * sizeof (complex));
 	// print_impulse("min_imp.txt", N, mpfir, 1, 0);
+	enter_planner ();
 	fftw_destroy_plan (prev);
 	fftw_destroy_plan (pfor);
+	leave_planner ();
 	_aligned_free (newfreq);
 	_aligned_free (impulse);
 	_aligned_free (ana);
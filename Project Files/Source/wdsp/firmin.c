@@ -145,11 +145,15 @@ void plan_firopt (FIROPT a)
 	{
 		a->fftout[i] = (double *) malloc0 (2 * a->size * sizeof (complex));
 		a->fmask[i] = (double *) malloc0 (2 * a->size * sizeof (complex));
+		enter_planner ();
 		a->pcfor[i] = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->fftin, (fftw_complex *)a->fftout[i], FFTW_FORWARD, FFTW_PATIENT);
 		a->maskplan[i] = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->maskgen, (fftw_complex *)a->fmask[i], FFTW_FORWARD, FFTW_PATIENT);
+		leave_planner ();
 	}
 	a->accum = (double *) malloc0 (2 * a->size * sizeof (complex));
+	enter_planner ();
 	a->crev = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->accum, (fftw_complex *)a->out, FFTW_BACKWARD, FFTW_PATIENT);
+	leave_planner ();
 }
 
 void calc_firopt (FIROPT a)
@@ -192,14 +196,18 @@ FIROPT create_firopt (int run, int position, int size, double* in, double* out,
 void deplan_firopt (FIROPT a)
 {
 	int i;
+	enter_planner ();
 	fftw_destroy_plan (a->crev);
+	leave_planner ();
 	_aligned_free (a->accum);
 	for (i = 0; i < a->nfor; i++)
 	{
 		_aligned_free (a->fftout[i]);
 		_aligned_free (a->fmask[i]);
+		enter_planner ();
 		fftw_destroy_plan (a->pcfor[i]);
 		fftw_destroy_plan (a->maskplan[i]);
+		leave_planner ();
 	}
 	_aligned_free (a->maskplan);
 	_aligned_free (a->pcfor);
@@ -310,12 +318,16 @@ void plan_fircore (FIRCORE a)
 		a->fftout[i]   = (double *) malloc0 (2 * a->size * sizeof (complex));
 		a->fmask[0][i] = (double *) malloc0 (2 * a->size * sizeof (complex));
 		a->fmask[1][i] = (double *) malloc0 (2 * a->size * sizeof (complex));
+		enter_planner ();
 		a->pcfor[i] = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->fftin, (fftw_complex *)a->fftout[i], FFTW_FORWARD, FFTW_PATIENT);
 		a->maskplan[0][i] = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->maskgen, (fftw_complex *)a->fmask[0][i], FFTW_FORWARD, FFTW_PATIENT);
 		a->maskplan[1][i] = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->maskgen, (fftw_complex *)a->fmask[1][i], FFTW_FORWARD, FFTW_PATIENT);
+		leave_planner ();
 	}
 	a->accum = (double *) malloc0 (2 * a->size * sizeof (complex));
+	enter_planner ();
 	a->crev = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->accum, (fftw_complex *)a->out, FFTW_BACKWARD, FFTW_PATIENT);
+	leave_planner ();
 	a->masks_ready = 0;
 }
 
@@ -365,16 +377,20 @@ FIRCORE create_fircore (int size, double* in, double* out, int nc, int mp, doubl
 void deplan_fircore (FIRCORE a)
 {
 	int i;
+	enter_planner ();
 	fftw_destroy_plan (a->crev);
+	leave_planner ();
 	_aligned_free (a->accum);
 	for (i = 0; i < a->nfor; i++)
 	{
 		_aligned_free (a->fftout[i]);
 		_aligned_free (a->fmask[0][i]);
 		_aligned_free (a->fmask[1][i]);
+		enter_planner ();
 		fftw_destroy_plan (a->pcfor[i]);
 		fftw_destroy_plan (a->maskplan[0][i]);
 		fftw_destroy_plan (a->maskplan[1][i]);
+		leave_planner ();
 	}
 	_aligned_free (a->maskplan[0]);
 	_aligned_free (a->maskplan[1]);
@@ -412,6 +412,9 @@ void create_iobuffs (int channel)
 	n = a->r2_havesamps / a->out_size;
 	a->r2_unqueuedsamps = a->r2_havesamps - n * a->out_size;
 	InitializeCriticalSectionAndSpinCount(&a->r2_ControlSection, 2500);
+	a->r1_tags = create_prbq ();
+	a->r2_tags = create_prbq ();
+	flush_prbq (a->r2_tags, a->r2_havesamps);
 	a->Sem_BuffReady = CreateSemaphore(0, 0, 1000, 0);
 	a->Sem_OutReady  = CreateSemaphore(0, n, 1000, 0);
 	a->bfo = ch[channel].bfo;
@@ -434,6 +437,8 @@ void destroy_iobuffs (int channel)
 	destroy_slews (a);
 	CloseHandle (a->Sem_OutReady);
 	CloseHandle (a->Sem_BuffReady);
+	destroy_prbq (a->r2_tags);
+	destroy_prbq (a->r1_tags);
 	DeleteCriticalSection(&a->r2_ControlSection);
 	_aligned_free (a->r2_baseptr);
 	_aligned_free (a->r1_baseptr);
@@ -457,6 +462,9 @@ void flush_iobuffs (int channel)
 	a->r2_unqueuedsamps = a->r2_havesamps - n * a->out_size;
 	CloseHandle (a->Sem_OutReady);
 	a->Sem_OutReady  = CreateSemaphore(0, n, 1000, 0);
+	flush_prbq (a->r1_tags, 0);
+	flush_prbq (a->r2_tags, a->r2_havesamps);
+	a->torigin = 0;
 	flush_slews (a);
 }
 
@@ -466,12 +474,15 @@ void fexchange0 (int channel, double* in, double* out, int* error)
 {
 	int n;
 	int doit = 0;
+	long long tin, tout;
 	IOB a;
 	*error = 0;
 	if (_InterlockedAnd (&ch[channel].exchange, 1))
 	{
 		EnterCriticalSection (&ch[channel].csEXCH);
 		a = ch[channel].iob.pe;
+		probe_now (&tin);
+		inprbq (a->r1_tags, a->in_size, tin);
 		if (_InterlockedAnd (&a->slew.upflag, 1))
 			upslew0 (a, in);
 		else
@@ -481,6 +492,7 @@ void fexchange0 (int channel, double* in, double* out, int* error)
 		{
 			n = a->r1_unqueuedsamps / a->r1_outsize;
 			ReleaseSemaphore(a->Sem_BuffReady, n, 0);
+			post_sched (channel);
 			a->r1_unqueuedsamps -= n * a->r1_outsize;
 		}
 		if ((a->r1_inidx += a->in_size) == a->r1_active_buffsize)
@@ -511,6 +523,9 @@ void fexchange0 (int channel, double* in, double* out, int* error)
 		}
 		if ((a->r2_outidx += a->out_size) == a->r2_active_buffsize)
 			a->r2_outidx = 0;
+		outprbq (a->r2_tags, a->out_size, &tout);
+		if (tout) probe_now (&tin);
+		xprobe (channel, PRB_DSP, tout, tin);
 		LeaveCriticalSection (&ch[channel].csEXCH);
 	}
 }
@@ -520,12 +535,15 @@ void fexchange2 (int channel, INREAL *Iin, INREAL *Qin, OUTREAL *Iout, OUTREAL *
 {
 	int i, n;
 	int doit = 0;
+	long long tin, tout;
 	IOB a;
 	*error = 0;
 	if (_InterlockedAnd (&ch[channel].exchange, 1))
 	{
 		EnterCriticalSection (&ch[channel].csEXCH);
 		a = ch[channel].iob.pe;
+		probe_now (&tin);
+		inprbq (a->r1_tags, a->in_size, tin);
 		if (_InterlockedAnd (&a->slew.upflag, 1))
 			upslew2 (a, Iin, Qin);
 		else
@@ -539,6 +557,7 @@ void fexchange2 (int channel, INREAL *Iin, INREAL *Qin, OUTREAL *Iout, OUTREAL *
 		{
 			n = a->r1_unqueuedsamps / a->r1_outsize;
 			ReleaseSemaphore(a->Sem_BuffReady, n, 0);	
+			post_sched (channel);
 			a->r1_unqueuedsamps -= n * a->r1_outsize;
 		}
 		if ((a->r1_inidx += a->in_size) == a->r1_active_buffsize)
@@ -576,16 +595,20 @@ void fexchange2 (int channel, INREAL *Iin, INREAL *Qin, OUTREAL *Iout, OUTREAL *
 		}
 		if ((a->r2_outidx += a->out_size) == a->r2_active_buffsize)
 			a->r2_outidx = 0;
+		outprbq (a->r2_tags, a->out_size, &tout);
+		if (tout) probe_now (&tin);
+		xprobe (channel, PRB_DSP, tout, tin);
 		LeaveCriticalSection (&ch[channel].csEXCH);
 	}
 }
 
-void dexchange (int channel, double* in, double* out)
-{
+int dexchange (int channel, double* in, double* out)
+{	// returns 0, exchanging nothing, once the channel has been stopped
 	int n;
 	IOB a = ch[channel].iob.pd;
-	if (!_InterlockedAnd (&ch[channel].run, 1)) _endthread();
+	if (!_InterlockedAnd (&ch[channel].run, 1)) return 0;
 
+	inprbq (a->r2_tags, a->r2_insize, a->torigin);		// tag before the samples are published
 	EnterCriticalSection (&a->r2_ControlSection);
 	a->r2_havesamps += a->r2_insize;
 	LeaveCriticalSection (&a->r2_ControlSection);
@@ -599,6 +622,8 @@ void dexchange (int channel, double* in, double* out)
 		a->r2_unqueuedsamps -= n * a->out_size;
 	}
 	memcpy (out, a->r1_baseptr + 2 * a->r1_outidx, a->r1_outsize * sizeof (complex));
+	outprbq (a->r1_tags, a->r1_outsize, &a->torigin);
 	if ((a->r1_outidx += a->r1_outsize) == a->r1_active_buffsize)
 		a->r1_outidx = 0;
+	return 1;
 }
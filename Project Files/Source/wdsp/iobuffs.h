@@ -50,6 +50,9 @@ typedef struct _iobf
 	int   r2_havesamps;							// number of processed samples in output pseudo-ring
 	int   r2_unqueuedsamps;						// number of output samples not yet queued / released for output
 	CRITICAL_SECTION r2_ControlSection;
+	PRBQ r1_tags;								// arrival times of the samples in the input pseudo-ring
+	PRBQ r2_tags;								// fexchange() arrival times of the samples in the output pseudo-ring
+	long long torigin;							// arrival time of the buffer being processed
 
 	int bfo;									// block_for_output, wait until output is available before proceeding
 	HANDLE Sem_OutReady;						// count = number of 'out_size' buffers processed and available for output
@@ -92,6 +95,6 @@ void fexchange0 (int channel, double* in, double* out, int* error);
 PORT	// separate I/Q buffers
 extern void fexchange2 (int channel, INREAL *Iin, INREAL *Qin, OUTREAL *Iout, OUTREAL *Qout, int* error);
 
-extern void dexchange (int channel, double* in, double* out);
+extern int dexchange (int channel, double* in, double* out);
 
 #endif
\ No newline at end of file
@@ -73,6 +73,7 @@ void calc_iqc (IQC a)
 		a->cup[i] = 0.5 * (1.0 - cos (theta));
 		theta += delta;
 	}
+	a->kbuff = (int *) malloc0 (a->size * sizeof (int));
 	InitializeCriticalSectionAndSpinCount (&a->dog.cs, 2500);
 	size_iqc (a);
 }
@@ -81,6 +82,7 @@ void decalc_iqc (IQC a)
 {
 	desize_iqc (a);
 	DeleteCriticalSection (&a->dog.cs);
+	_aligned_free (a->kbuff);
 	_aligned_free (a->cup);
 }
 
@@ -119,83 +121,178 @@ enum _iqcstate
 	DONE
 };
 
+// Steady-state (RUN) correction kernel.  Processes samples [start, stop) two at a time in SSE2
+// lanes:  both envelopes and interval indices are computed in-register, the coefficients for
+// each lane are gathered by interval index and all three cubics are evaluated by Horner in
+// parallel.  The interval indices are left in kbuff for the watchdog pass.  Operation order
+// is identical to the per-sample code so results are bit-exact with it.
+void xiqc_run (IQC a, int start, int stop)
+{
+	int i, k0, k1;
+	const int cset = a->cset;
+	const double* cm = a->cm[cset];
+	const double* cc = a->cc[cset];
+	const double* cs = a->cs[cset];
+	const double* t = a->t;
+	const __m128d vints = _mm_set1_pd ((double)a->ints);
+	const __m128d vkmax = _mm_set1_pd ((double)(a->ints - 1));
+	__m128d I, Q, env, dx, ym, yc, ys, p0, p1;
+	__m128d v0, v1;
+	__m128i vk;
+	for (i = start; i < stop - 1; i += 2)
+	{
+		v0 = _mm_loadu_pd (&a->in[2 * i + 0]);				// I0, Q0
+		v1 = _mm_loadu_pd (&a->in[2 * i + 2]);				// I1, Q1
+		I = _mm_unpacklo_pd (v0, v1);
+		Q = _mm_unpackhi_pd (v0, v1);
+		env = _mm_sqrt_pd (_mm_add_pd (_mm_mul_pd (I, I), _mm_mul_pd (Q, Q)));
+		vk = _mm_cvttpd_epi32 (_mm_min_pd (_mm_mul_pd (env, vints), vkmax));
+		k0 = _mm_cvtsi128_si32 (vk);
+		k1 = _mm_cvtsi128_si32 (_mm_srli_si128 (vk, 4));
+		a->kbuff[i + 0] = k0;
+		a->kbuff[i + 1] = k1;
+		dx = _mm_sub_pd (env, _mm_set_pd (t[k1], t[k0]));
+		ym = _mm_set_pd (cm[4 * k1 + 3], cm[4 * k0 + 3]);
+		yc = _mm_set_pd (cc[4 * k1 + 3], cc[4 * k0 + 3]);
+		ys = _mm_set_pd (cs[4 * k1 + 3], cs[4 * k0 + 3]);
+		ym = _mm_add_pd (_mm_set_pd (cm[4 * k1 + 2], cm[4 * k0 + 2]), _mm_mul_pd (dx, ym));
+		yc = _mm_add_pd (_mm_set_pd (cc[4 * k1 + 2], cc[4 * k0 + 2]), _mm_mul_pd (dx, yc));
+		ys = _mm_add_pd (_mm_set_pd (cs[4 * k1 + 2], cs[4 * k0 + 2]), _mm_mul_pd (dx, ys));
+		ym = _mm_add_pd (_mm_set_pd (cm[4 * k1 + 1], cm[4 * k0 + 1]), _mm_mul_pd (dx, ym));
+		yc = _mm_add_pd (_mm_set_pd (cc[4 * k1 + 1], cc[4 * k0 + 1]), _mm_mul_pd (dx, yc));
+		ys = _mm_add_pd (_mm_set_pd (cs[4 * k1 + 1], cs[4 * k0 + 1]), _mm_mul_pd (dx, ys));
+		ym = _mm_add_pd (_mm_set_pd (cm[4 * k1 + 0], cm[4 * k0 + 0]), _mm_mul_pd (dx, ym));
+		yc = _mm_add_pd (_mm_set_pd (cc[4 * k1 + 0], cc[4 * k0 + 0]), _mm_mul_pd (dx, yc));
+		ys = _mm_add_pd (_mm_set_pd (cs[4 * k1 + 0], cs[4 * k0 + 0]), _mm_mul_pd (dx, ys));
+		p0 = _mm_mul_pd (ym, _mm_sub_pd (_mm_mul_pd (I, yc), _mm_mul_pd (Q, ys)));
+		p1 = _mm_mul_pd (ym, _mm_add_pd (_mm_mul_pd (I, ys), _mm_mul_pd (Q, yc)));
+		_mm_storeu_pd (&a->out[2 * i + 0], _mm_unpacklo_pd (p0, p1));
+		_mm_storeu_pd (&a->out[2 * i + 2], _mm_unpackhi_pd (p0, p1));
+	}
+	for (; i < stop; i++)
+	{
+		double sI, sQ, senv, sdx, sym, syc, sys;
+		sI = a->in[2 * i + 0];
+		sQ = a->in[2 * i + 1];
+		senv = sqrt (sI * sI + sQ * sQ);
+		if ((k0 = (int)(senv * a->ints)) > a->ints - 1) k0 = a->ints - 1;
+		a->kbuff[i] = k0;
+		sdx = senv - t[k0];
+		sym = cm[4 * k0 + 0] + sdx * (cm[4 * k0 + 1] + sdx * (cm[4 * k0 + 2] + sdx * cm[4 * k0 + 3]));
+		syc = cc[4 * k0 + 0] + sdx * (cc[4 * k0 + 1] + sdx * (cc[4 * k0 + 2] + sdx * cc[4 * k0 + 3]));
+		sys = cs[4 * k0 + 0] + sdx * (cs[4 * k0 + 1] + sdx * (cs[4 * k0 + 2] + sdx * cs[4 * k0 + 3]));
+		a->out[2 * i + 0] = sym * (sI * syc - sQ * sys);
+		a->out[2 * i + 1] = sym * (sI * sys + sQ * syc);
+	}
+}
+
+// Watchdog accounting for the samples processed by xiqc_run(), using the interval indices it left
+// in kbuff.  Kept out of the arithmetic kernel since it is inherently serial.
+void xiqc_dog (IQC a, int start, int stop)
+{
+	int i, k;
+	for (i = start; i < stop; i++)
+	{
+		k = a->kbuff[i];
+		if (a->dog.cpi[k] != a->dog.spi)
+			if (++a->dog.cpi[k] == a->dog.spi)
+				a->dog.full_ints++;
+		if (a->dog.full_ints == a->ints)
+		{
+			EnterCriticalSection (&a->dog.cs);
+			++a->dog.count;
+			LeaveCriticalSection (&a->dog.cs);
+			a->dog.full_ints = 0;
+			memset (a->dog.cpi, 0, a->ints * sizeof (int));
+		}
+	}
+}
+
+// Crossfade states (BEGIN, SWAP, END), one sample at a time.  Returns the index of the first
+// sample not processed, which is either a->size or the sample at which the state became RUN
+// or DONE.
+int xiqc_transition (IQC a, int start)
+{
+	int i, k, cset, mset;
+	double I, Q, env, dx, ym, yc, ys, PRE0, PRE1;
+	for (i = start; i < a->size && a->state != RUN && a->state != DONE; i++)
+	{
+		I = a->in[2 * i + 0];
+		Q = a->in[2 * i + 1];
+		env = sqrt (I * I + Q * Q);
+		if ((k = (int)(env * a->ints)) > a->ints - 1) k = a->ints - 1;
+		dx = env - a->t[k];
+		cset = a->cset;
+		ym = a->cm[cset][4 * k + 0] + dx * (a->cm[cset][4 * k + 1] + dx * (a->cm[cset][4 * k + 2] + dx * a->cm[cset][4 * k + 3]));
+		yc = a->cc[cset][4 * k + 0] + dx * (a->cc[cset][4 * k + 1] + dx * (a->cc[cset][4 * k + 2] + dx * a->cc[cset][4 * k + 3]));
+		ys = a->cs[cset][4 * k + 0] + dx * (a->cs[cset][4 * k + 1] + dx * (a->cs[cset][4 * k + 2] + dx * a->cs[cset][4 * k + 3]));
+		PRE0 = ym * (I * yc - Q * ys);
+		PRE1 = ym * (I * ys + Q * yc);
+
+		switch (a->state)
+		{
+		case BEGIN:
+			PRE0 = (1.0 - a->cup[a->count]) * I + a->cup[a->count] * PRE0;
+			PRE1 = (1.0 - a->cup[a->count]) * Q + a->cup[a->count] * PRE1;
+			if (a->count++ == a->ntup)
+			{
+				a->state = RUN;
+				a->count = 0;
+				InterlockedBitTestAndReset (&a->busy, 0);
+			}
+			break;
+		case SWAP:
+			mset = 1 - cset;
+			ym = a->cm[mset][4 * k + 0] + dx * (a->cm[mset][4 * k + 1] + dx * (a->cm[mset][4 * k + 2] + dx * a->cm[mset][4 * k + 3]));
+			yc = a->cc[mset][4 * k + 0] + dx * (a->cc[mset][4 * k + 1] + dx * (a->cc[mset][4 * k + 2] + dx * a->cc[mset][4 * k + 3]));
+			ys = a->cs[mset][4 * k + 0] + dx * (a->cs[mset][4 * k + 1] + dx * (a->cs[mset][4 * k + 2] + dx * a->cs[mset][4 * k + 3]));
+			PRE0 = (1.0 - a->cup[a->count]) * ym * (I * yc - Q * ys) + a->cup[a->count] * PRE0;
+			PRE1 = (1.0 - a->cup[a->count]) * ym * (I * ys + Q * yc) + a->cup[a->count] * PRE1;
+			if (a->count++ == a->ntup)
+			{
+				a->state = RUN;
+				a->count = 0;
+				InterlockedBitTestAndReset (&a->busy, 0);
+			}
+			break;
+		case END:
+			PRE0 = (1.0 - a->cup[a->count]) * PRE0 + a->cup[a->count] * I;
+			PRE1 = (1.0 - a->cup[a->count]) * PRE1 + a->cup[a->count] * Q;
+			if (a->count++ == a->ntup)
+			{
+				a->state = DONE;
+				a->count = 0;
+				InterlockedBitTestAndReset (&a->busy, 0);
+			}
+			break;
+		}
+		a->out[2 * i + 0] = PRE0;
+		a->out[2 * i + 1] = PRE1;
+		// print_iqc_values("iqc.txt", a->state, env, PRE0, PRE1, ym, yc, ys, 1.1);
+	}
+	return i;
+}
+
 void xiqc (IQC a)
 {
 	if (_InterlockedAnd(&a->run, 1))
 	{
-		int i, k, cset, mset;
-		double I, Q, env, dx, ym, yc, ys, PRE0, PRE1;
-		for (i = 0; i < a->size; i++)
+		int i = 0;
+		if (a->state != RUN && a->state != DONE)
+			i = xiqc_transition (a, 0);
+		if (i < a->size)
 		{
-			I = a->in[2 * i + 0];
-			Q = a->in[2 * i + 1];
-			env = sqrt (I * I + Q * Q);
-			if ((k = (int)(env * a->ints)) > a->ints - 1) k = a->ints - 1;
-			dx = env - a->t[k];
-			cset = a->cset;
-			ym = a->cm[cset][4 * k + 0] + dx * (a->cm[cset][4 * k + 1] + dx * (a->cm[cset][4 * k + 2] + dx * a->cm[cset][4 * k + 3]));
-			yc = a->cc[cset][4 * k + 0] + dx * (a->cc[cset][4 * k + 1] + dx * (a->cc[cset][4 * k + 2] + dx * a->cc[cset][4 * k + 3]));
-			ys = a->cs[cset][4 * k + 0] + dx * (a->cs[cset][4 * k + 1] + dx * (a->cs[cset][4 * k + 2] + dx * a->cs[cset][4 * k + 3]));
-			PRE0 = ym * (I * yc - Q * ys);
-			PRE1 = ym * (I * ys + Q * yc);
-
 			switch (a->state)
 			{
 			case RUN:
-				if (a->dog.cpi[k] != a->dog.spi)
-					if (++a->dog.cpi[k] == a->dog.spi)
-						a->dog.full_ints++;
-				if (a->dog.full_ints == a->ints)
-				{
-					EnterCriticalSection (&a->dog.cs);
-					++a->dog.count;
-					LeaveCriticalSection (&a->dog.cs);
-					a->dog.full_ints = 0;
-					memset (a->dog.cpi, 0, a->ints * sizeof (int));
-				}
-				break;
-			case BEGIN:
-				PRE0 = (1.0 - a->cup[a->count]) * I + a->cup[a->count] * PRE0;
-				PRE1 = (1.0 - a->cup[a->count]) * Q + a->cup[a->count] * PRE1;
-				if (a->count++ == a->ntup)
-				{
-					a->state = RUN;
-					a->count = 0;
-					InterlockedBitTestAndReset (&a->busy, 0);
-				}
-				break;
-			case SWAP:
-				mset = 1 - cset;
-				ym = a->cm[mset][4 * k + 0] + dx * (a->cm[mset][4 * k + 1] + dx * (a->cm[mset][4 * k + 2] + dx * a->cm[mset][4 * k + 3]));
-				yc = a->cc[mset][4 * k + 0] + dx * (a->cc[mset][4 * k + 1] + dx * (a->cc[mset][4 * k + 2] + dx * a->cc[mset][4 * k + 3]));
-				ys = a->cs[mset][4 * k + 0] + dx * (a->cs[mset][4 * k + 1] + dx * (a->cs[mset][4 * k + 2] + dx * a->cs[mset][4 * k + 3]));
-				PRE0 = (1.0 - a->cup[a->count]) * ym * (I * yc - Q * ys) + a->cup[a->count] * PRE0;
-				PRE1 = (1.0 - a->cup[a->count]) * ym * (I * ys + Q * yc) + a->cup[a->count] * PRE1;
-				if (a->count++ == a->ntup)
-				{
-					a->state = RUN;
-					a->count = 0;
-					InterlockedBitTestAndReset (&a->busy, 0);
-				}
-				break;
-			case END:
-				PRE0 = (1.0 - a->cup[a->count]) * PRE0 + a->cup[a->count] * I;
-				PRE1 = (1.0 - a->cup[a->count]) * PRE1 + a->cup[a->count] * Q;
-				if (a->count++ == a->ntup)
-				{
-					a->state = DONE;
-					a->count = 0;
-					InterlockedBitTestAndReset (&a->busy, 0);
-				}
+				xiqc_run (a, i, a->size);
+				xiqc_dog (a, i, a->size);
 				break;
 			case DONE:
-				PRE0 = I;
-				PRE1 = Q;
+				if (a->out != a->in)
+					memcpy (a->out + 2 * i, a->in + 2 * i, (a->size - i) * sizeof (complex));
 				break;
 			}
-			a->out[2 * i + 0] = PRE0;
-			a->out[2 * i + 1] = PRE1;
-			// print_iqc_values("iqc.txt", a->state, env, PRE0, PRE1, ym, yc, ys, 1.1);
 		}
 	}
 	else if (a->out != a->in)
@@ -218,6 +315,8 @@ void setSamplerate_iqc (IQC a, int rate)
 void setSize_iqc (IQC a, int size)
 {
 	a->size = size;
+	_aligned_free (a->kbuff);
+	a->kbuff = (int *) malloc0 (a->size * sizeof (int));
 }
 
 /********************************************************************************************************
@@ -46,6 +46,7 @@ typedef struct _iqc
 	int count;
 	int ntup;
 	int state;
+	int* kbuff;
 	struct
 	{
 		int spi;
@@ -62,6 +63,12 @@ extern void destroy_iqc (IQC a);
 
 extern void flush_iqc (IQC a);
 
+extern void xiqc_run (IQC a, int start, int stop);
+
+extern void xiqc_dog (IQC a, int start, int stop);
+
+extern int xiqc_transition (IQC a, int start);
+
 extern void xiqc (IQC a);
 
 extern void setBuffers_iqc (IQC a, double* in, double* out);
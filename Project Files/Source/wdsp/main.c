@@ -26,6 +26,33 @@ warren@wpratt.com
 
 #include "comm.h"
 
+int xmain (int channel)
+{	// processes one queued dsp buffer; run by the channel's own thread or by a scheduler worker
+	// returns 0 once the channel has been stopped, so that the caller can leave
+	int run = 1;
+	EnterCriticalSection (&ch[channel].csDSP);
+	if (!_InterlockedAnd (&ch[channel].iob.pd->exec_bypass, 1))
+	{
+		switch (ch[channel].type)
+		{
+		case 0:		// rxa
+			if (run = dexchange (channel, rxa[channel].exout, rxa[channel].exin))
+				xrxa (channel);
+			break;
+		case 1:		// txa
+			if (run = dexchange (channel, txa[channel].exout, txa[channel].exin))
+				xtxa (channel);
+			break;
+		case 31:	//
+
+			break;
+		}
+		if (run) xdshm_meters (channel);
+	}
+	LeaveCriticalSection (&ch[channel].csDSP);
+	return run;
+}
+
 void wdspmain (void *pargs)
 {
 	DWORD taskIndex = 0;
@@ -37,25 +64,7 @@ void wdspmain (void *pargs)
 	while (_InterlockedAnd (&ch[channel].run, 1))
 	{
 		WaitForSingleObject(ch[channel].iob.pd->Sem_BuffReady,INFINITE);
-		EnterCriticalSection (&ch[channel].csDSP);
-		if (!_InterlockedAnd (&ch[channel].iob.pd->exec_bypass, 1))
-		{
-			switch (ch[channel].type)
-			{
-			case 0:		// rxa
-				dexchange (channel, rxa[channel].outbuff, rxa[channel].inbuff);
-				xrxa (channel);
-				break;
-			case 1:		// txa
-				dexchange (channel, txa[channel].outbuff, txa[channel].inbuff);
-				xtxa (channel);
-				break;
-			case 31:	//
-
-				break;
-			}
-		}
-		LeaveCriticalSection (&ch[channel].csDSP);
+		if (!xmain (channel)) break;
 	}
 	if (hTask != 0) AvRevertMmThreadCharacteristics (hTask);
 }
@@ -171,3 +180,56 @@ void setDSPBuffsize_main (int channel)
 		break;
 	}
 }
+
+void designBatch_main (int channel, int dirty)
+{
+	switch (ch[channel].type)
+	{
+	case 0:
+		designBatch_rxa (channel, dirty);
+		break;
+	case 1:
+		designBatch_txa (channel, dirty);
+		break;
+	case 31:  //
+
+		break;
+	}
+}
+
+void applyBatch_main (int channel, int dirty)
+{
+	switch (ch[channel].type)
+	{
+	case 0:
+		applyBatch_rxa (channel, dirty);
+		break;
+	case 1:
+		applyBatch_txa (channel, dirty);
+		break;
+	case 31:  //
+
+		break;
+	}
+}
+
+PORT
+void GetChannelBufferFootprint (int channel, int* used, int* committed, int* peak)
+{	// bytes held by the arena behind the channel's midbuff, inbuff and outbuff; the blocks' own allocations
+	// are not included
+	ARENA a = 0;
+	EnterCriticalSection (&ch[channel].csDSP);
+	switch (ch[channel].type)
+	{
+	case 0:
+		a = rxa[channel].arena;
+		break;
+	case 1:
+		a = txa[channel].arena;
+		break;
+	}
+	*used      = a ? a->used   : 0;
+	*committed = a ? a->commit : 0;
+	*peak      = a ? a->peak   : 0;
+	LeaveCriticalSection (&ch[channel].csDSP);
+}
@@ -27,6 +27,8 @@ warren@wpratt.com
 #ifndef _mainloop_h
 #define _mainloop_h
 
+extern int xmain (int channel);
+
 extern void wdspmain (void *pargs);
 
 extern void create_main (int channel);
@@ -43,4 +45,10 @@ extern void setDSPSamplerate_main (int channel);
 
 extern void setDSPBuffsize_main (int channel);
 
+extern void designBatch_main (int channel, int dirty);
+
+extern void applyBatch_main (int channel, int dirty);
+
+extern __declspec (dllexport) void GetChannelBufferFootprint (int channel, int* used, int* committed, int* peak);
+
 #endif
\ No newline at end of file
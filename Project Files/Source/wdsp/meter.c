@@ -33,7 +33,7 @@ void calc_meter (METER a)
 	flush_meter(a);
 }
 
-METER create_meter (int run, int* prun, int size, double* buff, int rate, double tau_av, double tau_decay, double* result, CRITICAL_SECTION** pmtupdate, int enum_av, int enum_pk, int enum_gain, double* pgain)
+METER create_meter (int run, int* prun, int size, double* buff, int rate, double tau_av, double tau_decay, double* result, volatile long* pseq, int enum_av, int enum_pk, int enum_gain, double* pgain)
 {
 	METER a = (METER) malloc0 (sizeof (meter));
 	a->run = run;
@@ -48,17 +48,13 @@ METER create_meter (int run, int* prun, int size, double* buff, int rate, double
 	a->enum_pk = enum_pk;
 	a->enum_gain = enum_gain;
 	a->pgain = pgain;
+	a->pseq = pseq;
 	calc_meter(a);
-	InitializeCriticalSectionAndSpinCount (&a->mtupdate, 2500);
-	pmtupdate[enum_av]   = &a->mtupdate;
-	pmtupdate[enum_pk]   = &a->mtupdate;
-	pmtupdate[enum_gain] = &a->mtupdate;
 	return a;
 }
 
 void destroy_meter (METER a)
 {
-	DeleteCriticalSection (&a->mtupdate);
 	_aligned_free (a);
 }
 
@@ -66,16 +62,38 @@ void flush_meter (METER a)
 {
 	a->avg  = 0.0;
 	a->peak = 0.0;
+	InterlockedIncrement (a->pseq);
 	a->result[a->enum_av] = -400.0;
 	a->result[a->enum_pk] = -400.0;
 	if ((a->pgain != 0) && (a->enum_gain >= 0))
 		a->result[a->enum_gain] = -400.0;
+	InterlockedIncrement (a->pseq);
+}
+
+void results_meter (METER a, int active, double np)
+{	// np is the largest squared magnitude seen in the block just accumulated
+	InterlockedIncrement (a->pseq);			// odd:  results are being written
+	if (active)
+	{
+		if (np > a->peak) a->peak = np;
+		a->result[a->enum_av] = 10.0 * mlog10 (a->avg + 1.0e-40);
+		a->result[a->enum_pk] = 10.0 * mlog10 (a->peak + 1.0e-40);
+		if ((a->pgain != 0) && (a->enum_gain >= 0))
+			a->result[a->enum_gain] = 20.0 * mlog10 (*a->pgain + 1.0e-40);
+	}
+	else
+	{
+		if (a->enum_av   >= 0) a->result[a->enum_av]   = - 400.0;
+		if (a->enum_pk   >= 0) a->result[a->enum_pk]   = - 400.0;
+		if (a->enum_gain >= 0) a->result[a->enum_gain] = +   0.0;
+	}
+	InterlockedIncrement (a->pseq);			// even:  results are consistent
 }
 
 void xmeter (METER a)
 {
 	int srun;
-	EnterCriticalSection (&a->mtupdate);
+	double np = 0.0;
 	if (a->prun != 0)
 		srun = *(a->prun);
 	else
@@ -84,7 +102,6 @@ void xmeter (METER a)
 	{
 		int i;
 		double smag;
-		double np = 0.0;
 		for (i = 0; i < a->size; i++)
 		{
 			smag = a->buff[2 * i + 0] * a->buff[2 * i + 0] + a->buff[2 * i + 1] * a->buff[2 * i + 1];
@@ -92,19 +109,8 @@ void xmeter (METER a)
 			a->peak *= a->mult_peak;
 			if (smag > np) np = smag;
 		}
-		if (np > a->peak) a->peak = np;
-		a->result[a->enum_av] = 10.0 * mlog10 (a->avg + 1.0e-40);
-		a->result[a->enum_pk] = 10.0 * mlog10 (a->peak + 1.0e-40);
-		if ((a->pgain != 0) && (a->enum_gain >= 0))
-			a->result[a->enum_gain] = 20.0 * mlog10 (*a->pgain + 1.0e-40);
 	}
-	else
-	{
-		if (a->enum_av   >= 0) a->result[a->enum_av]   = - 400.0;
-		if (a->enum_pk   >= 0) a->result[a->enum_pk]   = - 400.0;
-		if (a->enum_gain >= 0) a->result[a->enum_gain] = +   0.0;
-	}
-	LeaveCriticalSection (&a->mtupdate);
+	results_meter (a, a->run && srun, np);
 }
 
 void setBuffers_meter (METER a, double* in)
@@ -124,6 +130,19 @@ void setSize_meter (METER a, int size)
 	flush_meter (a);
 }
 
+void read_meters (volatile long* pseq, double* result, double* vals, int n)
+{	// seqlock read of a channel's meter results; retried if the DSP thread published during the copy
+	long seq;
+	do
+	{
+		while ((seq = *pseq) & 1)
+			MemoryBarrier ();
+		MemoryBarrier ();
+		memcpy (vals, result, n * sizeof (double));
+		MemoryBarrier ();
+	} while (*pseq != seq);
+}
+
 /********************************************************************************************************
 *																										*
 *											RXA Properties												*
@@ -134,13 +153,16 @@ PORT
 double GetRXAMeter (int channel, int mt)
 {
 	double val;
-	CRITICAL_SECTION* a = rxa[channel].pmtupdate[mt];
-	EnterCriticalSection (a);
-	val = rxa[channel].meter[mt];
-	LeaveCriticalSection (a);
+	read_meters (&rxa[channel].mseq, &rxa[channel].meter[mt], &val, 1);
 	return val;
 }
 
+PORT
+void GetRXAMeters (int channel, double* meters)
+{	// all RXA meter values, indexed by meter type, from a single consistent snapshot
+	read_meters (&rxa[channel].mseq, rxa[channel].meter, meters, RXA_METERTYPE_LAST);
+}
+
 /********************************************************************************************************
 *																										*
 *											TXA Properties												*
@@ -151,9 +173,12 @@ PORT
 double GetTXAMeter (int channel, int mt)
 {
 	double val;
-	CRITICAL_SECTION* a = txa[channel].pmtupdate[mt];
-	EnterCriticalSection (a);
-	val = txa[channel].meter[mt];
-	LeaveCriticalSection (a);
+	read_meters (&txa[channel].mseq, &txa[channel].meter[mt], &val, 1);
 	return val;
+}
+
+PORT
+void GetTXAMeters (int channel, double* meters)
+{	// all TXA meter values, indexed by meter type, from a single consistent snapshot
+	read_meters (&txa[channel].mseq, txa[channel].meter, meters, TXA_METERTYPE_LAST);
 }
\ No newline at end of file
@@ -45,15 +45,17 @@ typedef struct _meter
 	double* pgain;
 	double avg;
 	double peak;
-	CRITICAL_SECTION mtupdate;
+	volatile long* pseq;				// channel's meter sequence count, odd while results are written
 } meter, *METER;
 
-extern METER create_meter (int run, int* prun, int size, double* buff, int rate, double tau_av, double tau_decay, double* result, CRITICAL_SECTION** pmtupdate, int enum_av, int enum_pk, int enum_gain, double* pgain);
+extern METER create_meter (int run, int* prun, int size, double* buff, int rate, double tau_av, double tau_decay, double* result, volatile long* pseq, int enum_av, int enum_pk, int enum_gain, double* pgain);
 
 extern void destroy_meter (METER a);
 
 extern void flush_meter (METER a);
 
+extern void results_meter (METER a, int active, double np);
+
 extern void xmeter (METER a);
 
 extern void setBuffers_meter (METER a, double* in);
@@ -62,12 +64,18 @@ extern void setSamplerate_meter (METER a, int rate);
 
 extern void setSize_meter (METER a, int size);
 
+extern void read_meters (volatile long* pseq, double* result, double* vals, int n);
+
 // RXA Properties
 
 extern __declspec (dllexport) double GetRXAMeter (int channel, int mt);
 
+extern __declspec (dllexport) void GetRXAMeters (int channel, double* meters);
+
 // TXA Properties
 
 extern __declspec (dllexport) double GetTXAMeter (int channel, int mt);
 
+extern __declspec (dllexport) void GetTXAMeters (int channel, double* meters);
+
 #endif
\ No newline at end of file
@@ -62,20 +62,89 @@ void destroy_notchdb (NOTCHDB b)
 ********************************************************************************************************/
 
 double* fir_mbandpass (int N, int nbp, double* flow, double* fhigh, double rate, double scale, int wintype)
-{
-	int i, k;
+{	// Sum of fir_bandpass(N, flow[k], fhigh[k], rate, wintype, 1, scale).  Each band's term is
+	//	w(t) / (2j * PI * t) * (E(flow) - E(fhigh)), E(f) = exp(-j * TWOPI * f * t / rate), so the sum needs
+	//	one rotating phasor per band edge and a single window, instead of trig per band and coefficient.
+	//	Changing a notch or the tune frequency costs O(N) per band edge.
 	double* impulse = (double *) malloc0 (N * sizeof (complex));
-	double* imp;
+	double* er = (double *) malloc0 ((2 * nbp + 1) * sizeof (double));	// phasors, flow edges then fhigh edges
+	double* ei = (double *) malloc0 ((2 * nbp + 1) * sizeof (double));
+	double* rr = (double *) malloc0 ((2 * nbp + 1) * sizeof (double));	// per-coefficient rotations
+	double* ri = (double *) malloc0 ((2 * nbp + 1) * sizeof (double));
+	double m = 0.5 * (double)(N - 1);
+	double delta = PI / m;
+	double cosphi, window, K, pos, theta, Sr, Si;
+	double bw = 0.0;
+	int i, j, k, e;
+	const int ne = 2 * nbp;
 	for (k = 0; k < nbp; k++)
 	{
-		imp = fir_bandpass (N, flow[k], fhigh[k], rate, wintype, 1, scale);
-		for (i = 0; i < N; i++)
+		bw += fhigh[k] - flow[k];
+		rr[k]       = cos (TWOPI * flow[k]  / rate);
+		ri[k]       = -sin (TWOPI * flow[k]  / rate);
+		rr[nbp + k] = cos (TWOPI * fhigh[k] / rate);
+		ri[nbp + k] = -sin (TWOPI * fhigh[k] / rate);
+	}
+	if (N & 1)
+	{
+		impulse[N - 1] = scale * bw / rate;
+		impulse[  N  ] = 0.0;
+	}
+	for (i = (N + 1) / 2, j = N / 2 - 1; i < N; i++, j--)
+	{
+		pos = (double)i - m;
+		if (((i - (N + 1) / 2) & 255) == 0)
+		{	// start, and periodically re-seed, the phasors exactly
+			for (e = 0; e < ne; e++)
+			{
+				theta = TWOPI * (e < nbp ? flow[e] : fhigh[e - nbp]) * pos / rate;
+				er[e] = cos (theta);
+				ei[e] = -sin (theta);
+			}
+		}
+		Sr = Si = 0.0;
+		for (e = 0; e < nbp; e++)
 		{
-			impulse[2 * i + 0] += imp[2 * i + 0];
-			impulse[2 * i + 1] += imp[2 * i + 1];
+			Sr += er[e] - er[nbp + e];
+			Si += ei[e] - ei[nbp + e];
+		}
+		switch (wintype)
+		{
+		case 0:	// Blackman-Harris 4-term
+			cosphi = cos (delta * i);
+			window  =             + 0.21747
+					+ cosphi *  ( - 0.45325
+					+ cosphi *  ( + 0.28256
+					+ cosphi *  ( - 0.04672 )));
+			break;
+		case 1:	// Blackman-Harris 7-term
+		default:
+			cosphi = cos (delta * i);
+			window	=			  + 6.3964424114390378e-02
+					+ cosphi *  ( - 2.3993864599352804e-01
+					+ cosphi *  ( + 3.5015956323820469e-01
+					+ cosphi *	( - 2.4774111897080783e-01
+					+ cosphi *  ( + 8.5438256055858031e-02
+					+ cosphi *	( - 1.2320203369293225e-02
+					+ cosphi *	( + 4.3778825791773474e-04 ))))));
+			break;
+		}
+		K = 0.5 * scale * window / (PI * pos);
+		impulse[2 * i + 0] = + K * Si;
+		impulse[2 * i + 1] = - K * Sr;
+		impulse[2 * j + 0] = + K * Si;
+		impulse[2 * j + 1] = + K * Sr;
+		for (e = 0; e < ne; e++)
+		{	// advance to pos + 1
+			double t = er[e] * rr[e] - ei[e] * ri[e];
+			ei[e]    = er[e] * ri[e] + ei[e] * rr[e];
+			er[e]    = t;
 		}
-		_aligned_free (imp);
 	}
+	_aligned_free (ri);
+	_aligned_free (rr);
+	_aligned_free (ei);
+	_aligned_free (er);
 	return impulse;
 }
 
@@ -335,21 +404,23 @@ void setMp_nbp (NBP a)
 
 void UpdateNBPFiltersLightWeight (int channel)
 {	// called when setting tune freq or shift freq
-	calc_nbp_lightweight (rxa[channel].nbp0.p);
-	calc_nbp_lightweight (rxa[channel].bpsnba.p->bpsnba);
+	if (!DeferChannelUpdate (channel, RXA_UPD_NBP0))
+		calc_nbp_lightweight (rxa[channel].nbp0.p);
+	if (!DeferChannelUpdate (channel, RXA_UPD_BPSNBA))
+		calc_nbp_lightweight (rxa[channel].bpsnba.p->bpsnba);
 }
 
 void UpdateNBPFilters(int channel)
 {
 	NBP a = rxa[channel].nbp0.p;
 	BPSNBA b = rxa[channel].bpsnba.p;
-	if (a->fnfrun)
+	if (a->fnfrun && !DeferChannelUpdate (channel, RXA_UPD_NBP0))
 	{
 		calc_nbp_impulse (a);
 		setImpulse_fircore (a->p, a->impulse, 1);
 		_aligned_free (a->impulse);
 	}
-	if (b->bpsnba->fnfrun)
+	if (b->bpsnba->fnfrun && !DeferChannelUpdate (channel, RXA_UPD_BPSNBA))
 	{
 		recalc_bpsnba_filter (b, 1);
 	}
@@ -502,9 +573,12 @@ void RXANBPSetNotchesRun (int channel, int run)
 		a->master_run = run;							// update variables
 		b->fnfrun = a->master_run;
 		RXAbpsnbaCheck (channel, rxa[channel].mode, run);
-		calc_nbp_impulse (b);							// recalc nbp impulse response
-		setImpulse_fircore (b->p, b->impulse, 0);		// calculate new filter masks
-		_aligned_free (b->impulse);
+		if (!DeferChannelUpdate (channel, RXA_UPD_NBP0))
+		{
+			calc_nbp_impulse (b);						// recalc nbp impulse response
+			setImpulse_fircore (b->p, b->impulse, 0);	// calculate new filter masks
+			_aligned_free (b->impulse);
+		}
 		EnterCriticalSection (&ch[channel].csDSP);		// block DSP channel processing
 		RXAbpsnbaSet (channel);
 		setUpdate_fircore (b->p);						// apply new filter masks
@@ -533,9 +607,12 @@ void RXANBPSetFreqs (int channel, double flow, double fhigh)
 	{
 		a->flow = flow;
 		a->fhigh = fhigh;
-		calc_nbp_impulse (a);
-		setImpulse_fircore (a->p, a->impulse, 1);
-		_aligned_free (a->impulse);
+		if (!DeferChannelUpdate (channel, RXA_UPD_NBP0))
+		{
+			calc_nbp_impulse (a);
+			setImpulse_fircore (a->p, a->impulse, 1);
+			_aligned_free (a->impulse);
+		}
 	}
 }
 
@@ -549,14 +626,18 @@ void RXANBPSetWindow (int channel, int wintype)
 	if ((a->wintype != wintype))
 	{
 		a->wintype = wintype;
-		calc_nbp_impulse (a);
-		setImpulse_fircore (a->p, a->impulse, 1);
-		_aligned_free (a->impulse);
+		if (!DeferChannelUpdate (channel, RXA_UPD_NBP0))
+		{
+			calc_nbp_impulse (a);
+			setImpulse_fircore (a->p, a->impulse, 1);
+			_aligned_free (a->impulse);
+		}
 	}
 	if ((b->wintype != wintype))
 	{
 		b->wintype = wintype;
-		recalc_bpsnba_filter (b, 1);
+		if (!DeferChannelUpdate (channel, RXA_UPD_BPSNBA))
+			recalc_bpsnba_filter (b, 1);
 	}
 }
 
@@ -607,13 +688,17 @@ void RXANBPSetAutoIncrease (int channel, int autoincr)
 	if ((a->autoincr != autoincr))
 	{
 		a->autoincr = autoincr;
-		calc_nbp_impulse (a);
-		setImpulse_fircore (a->p, a->impulse, 1);
-		_aligned_free (a->impulse);
+		if (!DeferChannelUpdate (channel, RXA_UPD_NBP0))
+		{
+			calc_nbp_impulse (a);
+			setImpulse_fircore (a->p, a->impulse, 1);
+			_aligned_free (a->impulse);
+		}
 	}
 	if ((b->autoincr != autoincr))
 	{
 		b->autoincr = autoincr;
-		recalc_bpsnba_filter (b, 1);
+		if (!DeferChannelUpdate (channel, RXA_UPD_BPSNBA))
+			recalc_bpsnba_filter (b, 1);
 	}
 }
@@ -0,0 +1,374 @@
+/*  probe.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+#include "comm.h"
+
+/********************************************************************************************************
+*																										*
+*										End-to-End Latency Probes										*
+*																										*
+********************************************************************************************************/
+
+// Latency is measured hop by hop.  Each ring between two threads carries a tag queue recording the
+// arrival time of the samples written into it; the consumer looks up the arrival time of the first sample
+// it reads, so the time spent in the ring, including any prefill, is measured exactly rather than
+// estimated from the fill level.  The latency of a path is the sum of its most recent hop values;
+// a histogram of it is kept per path and may also be written to a trace file.  Trace rows go into a
+// preallocated ring that a writer thread drains to the file, so the measured threads never do file I/O;
+// rows that find the ring full are dropped and counted.  Everything is off by default:  while probes are
+// stopped the queues only advance their sample counts.
+
+typedef struct _prbrow
+{
+	double t;									// seconds since start / reset
+	int path;
+	double total;								// milliseconds
+	double hop[PRB_HOPS];
+} prbrow;
+
+struct _probes
+{
+	volatile long init;							// 1 while initializing, 2 when initialized
+	volatile long run;							// probes are active
+	LARGE_INTEGER freq;							// performance counter frequency
+	long long tbase;							// performance counter at start / reset
+	CRITICAL_SECTION cs;						// guards the statistics and the opening / closing of the trace
+	FILE* trace;								// written only by the trace writer while it runs
+	prbrow* rows;								// trace ring, filled under 'cs', drained by the writer
+	volatile long thead;						// next row to fill
+	volatile long ttail;						// next row to write, owned by the writer
+	volatile long tdropped;						// rows lost because the ring was full
+	volatile long trun;							// the trace writer keeps running
+	HANDLE tdone;								// released by the trace writer as it exits
+	double ob[PRB_OUTBOUNDS];					// Outbound() hops, milliseconds; shared by the paths using that id
+	volatile long obvalid;						// one bit per Outbound() id that has been measured
+	struct
+	{
+		double hop[PRB_HOPS];					// most recent hop values, milliseconds
+		volatile long valid;					// one bit per hop that has been measured
+		int bins[PRB_BINS];
+		int count;
+		double sum;
+		double min;
+		double max;
+	} path[PRB_PATHS];
+} prb;
+
+void init_probes (void)
+{
+	if (!InterlockedCompareExchange (&prb.init, 1, 0))
+	{
+		QueryPerformanceFrequency (&prb.freq);
+		InitializeCriticalSectionAndSpinCount (&prb.cs, 2500);
+		InterlockedExchange (&prb.init, 2);
+	}
+	while (_InterlockedAnd (&prb.init, 0xffffffff) != 2) Sleep (0);
+}
+
+void clear_probes (void)
+{
+	int i;
+	LARGE_INTEGER now;
+	QueryPerformanceCounter (&now);
+	prb.tbase = now.QuadPart;
+	memset (prb.ob, 0, sizeof (prb.ob));
+	InterlockedExchange (&prb.obvalid, 0);
+	for (i = 0; i < PRB_PATHS; i++)
+	{
+		memset (prb.path[i].hop,  0, sizeof (prb.path[i].hop));
+		memset (prb.path[i].bins, 0, sizeof (prb.path[i].bins));
+		InterlockedExchange (&prb.path[i].valid, 0);
+		prb.path[i].count = 0;
+		prb.path[i].sum = 0.0;
+		prb.path[i].min = 0.0;
+		prb.path[i].max = 0.0;
+	}
+}
+
+/********************************************************************************************************
+*																										*
+*											   Tag Queues												*
+*																										*
+********************************************************************************************************/
+
+PORT
+PRBQ create_prbq (void)
+{
+	PRBQ q = (PRBQ) malloc0 (sizeof (prbq));
+	flush_prbq (q, 0);
+	return q;
+}
+
+PORT
+void destroy_prbq (PRBQ q)
+{
+	_aligned_free (q);
+}
+
+// called only while the ring's producer and consumer are stopped; 'prefill' is the number of
+//	untagged samples (e.g., zeros) the ring starts with
+PORT
+void flush_prbq (PRBQ q, int prefill)
+{
+	q->incount = prefill;
+	q->outcount = 0;
+	InterlockedExchange (&q->head, 0);
+	InterlockedExchange (&q->tail, 0);
+}
+
+// producer:  'nsamples' were written, arriving at time 't' (0 if unknown)
+PORT
+void inprbq (PRBQ q, int nsamples, long long t)
+{
+	int head, next;
+	long long first = q->incount;
+	q->incount += nsamples;
+	if (t == 0) return;
+	head = _InterlockedAnd (&q->head, 0xffffffff);
+	if ((next = head + 1) == PRBQ_SIZE) next = 0;
+	if (next == _InterlockedAnd (&q->tail, 0xffffffff)) return;	// full, leave these samples untagged
+	q->tag[head].first = first;
+	q->tag[head].last = q->incount;
+	q->tag[head].t = t;
+	InterlockedExchange (&q->head, next);
+}
+
+// consumer:  'nsamples' were read; '*t' returns the arrival time of the first of them, 0 if unknown
+PORT
+void outprbq (PRBQ q, int nsamples, long long* t)
+{
+	int tail, head;
+	long long s = q->outcount + 1;
+	q->outcount += nsamples;
+	*t = 0;
+	tail = _InterlockedAnd (&q->tail, 0xffffffff);
+	head = _InterlockedAnd (&q->head, 0xffffffff);
+	while (tail != head && q->tag[tail].last < s)
+		if (++tail == PRBQ_SIZE) tail = 0;
+	if (tail != head && q->tag[tail].first < s)
+		*t = q->tag[tail].t;
+	InterlockedExchange (&q->tail, tail);
+}
+
+/********************************************************************************************************
+*																										*
+*												 Probes													*
+*																										*
+********************************************************************************************************/
+
+PORT
+void probe_now (long long* t)
+{
+	LARGE_INTEGER now;
+	if (_InterlockedAnd (&prb.run, 1))
+	{
+		QueryPerformanceCounter (&now);
+		*t = now.QuadPart;
+	}
+	else
+		*t = 0;
+}
+
+// records the hop 't0' -> 't1' for a path; either time may be 0 (unknown) in which case nothing is recorded
+PORT
+void xprobe (int path, int hop, long long t0, long long t1)
+{
+	if (t0 == 0 || t1 == 0 || path < 0 || path >= PRB_PATHS) return;
+	if (!_InterlockedAnd (&prb.run, 1)) return;
+	prb.path[path].hop[hop] = 1000.0 * (double)(t1 - t0) / (double)prb.freq.QuadPart;
+	if (!(prb.path[path].valid & (1 << hop)))
+		_InterlockedOr (&prb.path[path].valid, 1 << hop);
+}
+
+PORT
+void xprobeob (int id, long long t0, long long t1)
+{
+	if (t0 == 0 || t1 == 0 || id < 0 || id >= PRB_OUTBOUNDS) return;
+	if (!_InterlockedAnd (&prb.run, 1)) return;
+	prb.ob[id] = 1000.0 * (double)(t1 - t0) / (double)prb.freq.QuadPart;
+	if (!(prb.obvalid & (1 << id)))
+		_InterlockedOr (&prb.obvalid, 1 << id);
+}
+
+// called once per block by the thread that owns the path, after its last per-path hop;
+//	'obid' is the Outbound() id the path leaves through.  Only the audio outbound (id 0) is fed by the mixer.
+PORT
+void sumprobe (int path, int obid)
+{
+	int i, bin, need, head, next;
+	double total;
+	LARGE_INTEGER now;
+	if (path < 0 || path >= PRB_PATHS || obid < 0 || obid >= PRB_OUTBOUNDS) return;
+	if (!_InterlockedAnd (&prb.run, 1)) return;
+	need = (1 << PRB_ROUTER) | (1 << PRB_PIPE0) | (1 << PRB_DSP) | (1 << PRB_PIPE1);
+	if (obid == 0) need |= 1 << PRB_MIX;
+	if ((_InterlockedAnd (&prb.path[path].valid, 0xffffffff) & need) != need) return;
+	if (!(_InterlockedAnd (&prb.obvalid, 0xffffffff) & (1 << obid))) return;
+	EnterCriticalSection (&prb.cs);
+	if (obid != 0) prb.path[path].hop[PRB_MIX] = 0.0;
+	prb.path[path].hop[PRB_OUTBOUND] = prb.ob[obid];
+	for (i = 0, total = 0.0; i < PRB_HOPS; i++)
+		total += prb.path[path].hop[i];
+	if ((bin = (int)(total / PRB_BINWIDTH)) >= PRB_BINS) bin = PRB_BINS - 1;
+	if (bin < 0) bin = 0;
+	prb.path[path].bins[bin]++;
+	if (prb.path[path].count == 0 || total < prb.path[path].min) prb.path[path].min = total;
+	if (prb.path[path].count == 0 || total > prb.path[path].max) prb.path[path].max = total;
+	prb.path[path].count++;
+	prb.path[path].sum += total;
+	if (prb.rows)
+	{
+		head = prb.thead;
+		if ((next = head + 1) == PRB_TRACEROWS) next = 0;
+		if (next == _InterlockedAnd (&prb.ttail, 0xffffffff))
+			_InterlockedIncrement (&prb.tdropped);
+		else
+		{
+			QueryPerformanceCounter (&now);
+			prb.rows[head].t = (double)(now.QuadPart - prb.tbase) / (double)prb.freq.QuadPart;
+			prb.rows[head].path = path;
+			prb.rows[head].total = total;
+			memcpy (prb.rows[head].hop, prb.path[path].hop, PRB_HOPS * sizeof (double));
+			InterlockedExchange (&prb.thead, next);
+		}
+	}
+	LeaveCriticalSection (&prb.cs);
+}
+
+void trace_main (void* pargs)
+{	// drains the trace ring every 50 ms; a final pass after 'trun' is cleared writes what is left
+	int i, tail, run;
+	prbrow* r;
+	while (1)
+	{
+		run = _InterlockedAnd (&prb.trun, 1);
+		tail = _InterlockedAnd (&prb.ttail, 0xffffffff);
+		while (tail != _InterlockedAnd (&prb.thead, 0xffffffff))
+		{
+			r = &prb.rows[tail];
+			fprintf (prb.trace, "%.6f\t%d\t%.4f", r->t, r->path, r->total);
+			for (i = 0; i < PRB_HOPS; i++)
+				fprintf (prb.trace, "\t%.4f", r->hop[i]);
+			fprintf (prb.trace, "\n");
+			if (++tail == PRB_TRACEROWS) tail = 0;
+			InterlockedExchange (&prb.ttail, tail);
+		}
+		if (!run) break;
+		Sleep (50);
+	}
+	ReleaseSemaphore (prb.tdone, 1, 0);
+	_endthread ();
+}
+
+/********************************************************************************************************
+*																										*
+*											   Properties												*
+*																										*
+********************************************************************************************************/
+
+PORT
+void SetLatencyProbes (int run)
+{
+	init_probes ();
+	EnterCriticalSection (&prb.cs);
+	if (run && !_InterlockedAnd (&prb.run, 1))
+		clear_probes ();
+	InterlockedExchange (&prb.run, run != 0);
+	LeaveCriticalSection (&prb.cs);
+}
+
+PORT
+void ResetLatencyProbes (void)
+{
+	init_probes ();
+	EnterCriticalSection (&prb.cs);
+	clear_probes ();
+	LeaveCriticalSection (&prb.cs);
+}
+
+// 'bins' must have room for PRB_BINS values, bin 'i' counting totals in [i, i + 1) * PRB_BINWIDTH ms;
+//	times are returned in milliseconds
+PORT
+void GetLatencyHistogram (int path, int* bins, int* count, double* mean, double* min, double* max)
+{
+	if (path < 0 || path >= PRB_PATHS) return;
+	init_probes ();
+	EnterCriticalSection (&prb.cs);
+	memcpy (bins, prb.path[path].bins, PRB_BINS * sizeof (int));
+	*count = prb.path[path].count;
+	*mean = *count ? prb.path[path].sum / *count : 0.0;
+	*min = prb.path[path].min;
+	*max = prb.path[path].max;
+	LeaveCriticalSection (&prb.cs);
+}
+
+// 'hops' must have room for PRB_HOPS values, milliseconds
+PORT
+void GetLatencyHops (int path, double* hops)
+{
+	if (path < 0 || path >= PRB_PATHS) return;
+	init_probes ();
+	EnterCriticalSection (&prb.cs);
+	memcpy (hops, prb.path[path].hop, PRB_HOPS * sizeof (double));
+	LeaveCriticalSection (&prb.cs);
+}
+
+// opens a tab-separated trace of every measured block; a null or empty 'filename' closes it
+PORT
+void SetLatencyTrace (const char* filename)
+{
+	init_probes ();
+	EnterCriticalSection (&prb.cs);
+	if (prb.trace)
+	{	// the writer empties the ring before it exits
+		InterlockedExchange (&prb.trun, 0);
+		WaitForSingleObject (prb.tdone, INFINITE);
+		CloseHandle (prb.tdone);
+		fclose (prb.trace);
+		_aligned_free (prb.rows);
+		prb.trace = 0;
+		prb.rows = 0;
+	}
+	if (filename && filename[0] && (prb.trace = fopen (filename, "w")))
+	{
+		fprintf (prb.trace, "time\tpath\ttotal\trouter\tpipe0\tdsp\tpipe1\tmix\toutbound\n");
+		InterlockedExchange (&prb.thead, 0);
+		InterlockedExchange (&prb.ttail, 0);
+		InterlockedExchange (&prb.tdropped, 0);
+		InterlockedExchange (&prb.trun, 1);
+		prb.tdone = CreateSemaphore (0, 0, 1, 0);
+		prb.rows = (prbrow *) malloc0 (PRB_TRACEROWS * sizeof (prbrow));
+		_beginthread (trace_main, 0, 0);
+	}
+	LeaveCriticalSection (&prb.cs);
+}
+
+// trace rows dropped since the trace was opened because the writer fell behind
+PORT
+void GetLatencyTraceDropped (int* dropped)
+{
+	*dropped = _InterlockedAnd (&prb.tdropped, 0xffffffff);
+}
@@ -0,0 +1,92 @@
+/*  probe.h
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+#ifndef _probe_h
+#define _probe_h
+
+#define PRBQ_SIZE						128					// tags per queue
+#define PRB_PATHS						32					// one path per wdsp channel
+#define PRB_OUTBOUNDS					16					// Outbound() ids
+#define PRB_BINS						200					// histogram bins, the last one collects overflow
+#define PRB_BINWIDTH					0.5					// histogram bin width, milliseconds
+#define PRB_TRACEROWS					4096				// trace rows buffered ahead of the trace writer
+
+enum _prbhop
+{
+	PRB_ROUTER,									// Inbound() to the cmaster thread (cmbuffs ring)
+	PRB_PIPE0,									// cmaster thread to fexchange0() entry (nb, nb2, panadapter, pipe 0)
+	PRB_DSP,									// fexchange0() entry to the return of the processed samples
+	PRB_PIPE1,									// fexchange0() return to xMixAudio() / xilv() (pipe 1, tx gain, eer)
+	PRB_MIX,									// xMixAudio() to the mixer's Outbound() (aamix ring)
+	PRB_OUTBOUND,								// Outbound() to the return of sendOutbound() (obbuffs ring)
+	PRB_HOPS
+};
+
+typedef struct _prbq
+{	// arrival times of the samples in a single-producer / single-consumer ring
+	long long incount;							// samples written, owned by the producer
+	long long outcount;							// samples read, owned by the consumer
+	volatile long head;							// next tag to write, owned by the producer
+	volatile long tail;							// oldest tag, owned by the consumer
+	struct
+	{
+		long long first;						// count of the sample before the first one tagged
+		long long last;							// count of the last sample tagged
+		long long t;							// performance counter at arrival
+	} tag[PRBQ_SIZE];
+} prbq, *PRBQ;
+
+extern __declspec (dllexport) PRBQ create_prbq (void);
+
+extern __declspec (dllexport) void destroy_prbq (PRBQ q);
+
+extern __declspec (dllexport) void flush_prbq (PRBQ q, int prefill);
+
+extern __declspec (dllexport) void inprbq (PRBQ q, int nsamples, long long t);
+
+extern __declspec (dllexport) void outprbq (PRBQ q, int nsamples, long long* t);
+
+extern __declspec (dllexport) void probe_now (long long* t);
+
+extern __declspec (dllexport) void xprobe (int path, int hop, long long t0, long long t1);
+
+extern __declspec (dllexport) void xprobeob (int id, long long t0, long long t1);
+
+extern __declspec (dllexport) void sumprobe (int path, int obid);
+
+extern __declspec (dllexport) void SetLatencyProbes (int run);
+
+extern __declspec (dllexport) void ResetLatencyProbes (void);
+
+extern __declspec (dllexport) void GetLatencyHistogram (int path, int* bins, int* count, double* mean, double* min, double* max);
+
+extern __declspec (dllexport) void GetLatencyHops (int path, double* hops);
+
+extern __declspec (dllexport) void SetLatencyTrace (const char* filename);
+
+extern __declspec (dllexport) void GetLatencyTraceDropped (int* dropped);
+
+#endif
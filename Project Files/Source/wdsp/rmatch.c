@@ -24,6 +24,7 @@ warren@wpratt.com
 
 */
 
+#define _CRT_SECURE_NO_WARNINGS
 #include "comm.h"
 
 MAV create_mav (int ringmin, int ringmax, double nom_value)
@@ -125,6 +126,93 @@ void xaamav (AAMAV a, int input, double* output)
     a->i = (a->i + 1) & a->mask;
 }
 
+/********************************************************************************************************
+*																										*
+*											Telemetry													*
+*																										*
+********************************************************************************************************/
+
+RMTLM create_rmtlm (int size)
+{
+	RMTLM t = (RMTLM) malloc0 (sizeof (rmtlm));
+	int n = 1;
+	while (n < size) n <<= 1;
+	t->size = n;
+	t->mask = n - 1;
+	t->rec = (rmtlm_rec *) malloc0 (t->size * sizeof (rmtlm_rec));
+	t->widx = 0;
+	t->ridx = 0;
+	t->lost = 0;
+	QueryPerformanceFrequency (&t->freq);
+	QueryPerformanceCounter (&t->t0);
+	return t;
+}
+
+void destroy_rmtlm (RMTLM t)
+{
+	_aligned_free (t->rec);
+	_aligned_free (t);
+}
+
+void xrmtlm (RMATCH a, int flags)
+{	// may be called concurrently by the input and output sides; each call claims its own record
+	RMTLM t;
+	InterlockedIncrement (&a->tlm_users);
+	if ((t = a->tlm) != 0)
+	{
+		LARGE_INTEGER now;
+		long idx = InterlockedIncrement (&t->widx) - 1;
+		rmtlm_rec* r = &t->rec[idx & t->mask];
+		QueryPerformanceCounter (&now);
+		InterlockedExchange (&r->seq, 2 * idx + 1);
+		r->t = now.QuadPart;
+		r->nring = nring_rmatch (a);
+		r->var = a->var;
+		r->flags = flags | (a->control_flag ? RMT_CONTROL : 0) | (a->force ? RMT_FORCE : 0);
+		InterlockedExchange (&r->seq, 2 * idx + 2);
+	}
+	InterlockedDecrement (&a->tlm_users);
+}
+
+int read_rmtlm (RMTLM t, int max, double* tm, int* nring, double* var, int* flags)
+{	// copies up to 'max' unread records, oldest first; call with cs_tlm held
+	int n = 0;
+	long seq, want;
+	long widx = InterlockedAnd (&t->widx, 0xFFFFFFFF);
+	rmtlm_rec* r;
+	rmtlm_rec c;
+	if (widx - t->ridx > t->size)
+	{
+		t->lost += (widx - t->ridx) - t->size;
+		t->ridx = widx - t->size;
+	}
+	while (n < max && t->ridx != widx)
+	{
+		r = &t->rec[t->ridx & t->mask];
+		want = 2 * t->ridx + 2;
+		seq = InterlockedAnd (&r->seq, 0xFFFFFFFF);
+		if (seq - want < 0) break;					// this lap's record is not complete yet
+		if (seq == want)
+		{
+			c = *r;
+			_ReadWriteBarrier ();
+		}
+		if ((seq != want) || (InterlockedAnd (&r->seq, 0xFFFFFFFF) != want))
+		{											// overwritten by a later lap, before or while copying
+			t->lost++;
+			t->ridx++;
+			continue;
+		}
+		tm[n]    = (double)(c.t - t->t0.QuadPart) / (double)t->freq.QuadPart;
+		nring[n] = c.nring;
+		var[n]   = c.var;
+		flags[n] = c.flags;
+		n++;
+		t->ridx++;
+	}
+	return n;
+}
+
 void calc_rmatch (RMATCH a)
 {
 	int m;
@@ -136,20 +224,22 @@ void calc_rmatch (RMATCH a)
 	if (a->ringsize < 2 * a->outsize) a->ringsize = 2 * a->outsize;
 	a->ring = (double *) malloc0 (a->ringsize * sizeof (complex));
 	a->rsize = a->ringsize;
-	a->n_ring = a->rsize / 2;
 	a->iin = a->rsize / 2;
 	a->iout = 0;
+	a->wcount = a->rsize / 2;
+	a->rcount = 0;
+	a->outcalls = 0;
+	a->upslew_req = 0;
 	a->resout = (double *) malloc0 (max_ring_insize * sizeof (complex));
 	a->v = create_varsamp (1, a->insize, a->in, a->resout, a->nom_inrate, a->nom_outrate, 
 		a->fc_high, a->fc_low, a->R, a->gain, a->var, a->varmode);
+	setInterp_varsamp (a->v, a->interp);
 	a->ffmav = create_aamav (a->ff_ringmin, a->ff_ringmax, a->nom_ratio);
 	a->propmav = create_mav (a->prop_ringmin, a->prop_ringmax, 0.0);
 	a->pr_gain = a->prop_gain * 48000.0 / (double)a->nom_outrate;	// adjust gain for rate
 	a->inv_nom_ratio = (double)a->nom_inrate / (double)a->nom_outrate;
 	a->feed_forward = 1.0;
 	a->av_deviation = 0.0;
-	InitializeCriticalSectionAndSpinCount (&a->cs_ring, 2500);
-	InitializeCriticalSectionAndSpinCount (&a->cs_var,  2500);
 	a->ntslew = (int)(a->tslew * a->nom_outrate);
 	if (a->ntslew + 1 > a->rsize / 2) a->ntslew = a->rsize / 2 - 1;
 	a->cslew = (double *) malloc0 ((a->ntslew + 1) * sizeof (double));
@@ -160,7 +250,6 @@ void calc_rmatch (RMATCH a)
 		a->cslew[m] = 0.5 * (1.0 - cos (theta));
 		theta += dtheta;
 	}
-	a->baux = (double *) malloc0 (a->ringsize / 2 * sizeof (complex));
 	a->readsamps = 0;
 	a->writesamps = 0;
 	a->read_startup = (unsigned int)((double)a->nom_outrate * a->startup_delay);
@@ -173,10 +262,7 @@ void calc_rmatch (RMATCH a)
 
 void decalc_rmatch (RMATCH a)
 {
-	_aligned_free (a->baux);
 	_aligned_free (a->cslew);
-	DeleteCriticalSection (&a->cs_var);
-	DeleteCriticalSection (&a->cs_ring);
 	destroy_mav (a->propmav);
 	destroy_aamav (a->ffmav);
 	destroy_varsamp (a->v);
@@ -233,13 +319,17 @@ RMATCH create_rmatch (
 	a->prop_ringmax = prop_ringmax;	// must be a power of two
 	a->prop_gain = prop_gain;
 	a->varmode = varmode;
+	a->interp = 1;
 	a->tslew = tslew;
+	InitializeCriticalSectionAndSpinCount (&a->cs_tlm, 2500);
 	calc_rmatch(a);
 	return a;
 }
 
 void destroy_rmatch (RMATCH a)
 {
+	if (a->tlm) destroy_rmtlm (a->tlm);
+	DeleteCriticalSection (&a->cs_tlm);
 	decalc_rmatch (a);
 	_aligned_free (a);
 }
@@ -253,8 +343,21 @@ void reset_rmatch (RMATCH a)
 	InterlockedBitTestAndSet (&a->run, 0);
 }
 
-void control (RMATCH a, int change)
+int nring_rmatch (RMATCH a)
+{	// samples in the ring, as seen from either side
+	return (int)((unsigned long)InterlockedAnd (&a->wcount, 0xFFFFFFFF) - (unsigned long)InterlockedAnd (&a->rcount, 0xFFFFFFFF));
+}
+
+void publish_var (RMATCH a, double var)
 {
+	union { double d; LONG64 l; } u;
+	u.d = var;
+	InterlockedExchange64 ((volatile LONG64 *)&a->var, u.l);
+}
+
+void control (RMATCH a, int change)
+{	// runs only on the input side; var is published for everyone else
+	double var;
 	{
 		double current_ratio;
 		xaamav (a->ffmav, change, &current_ratio);
@@ -262,38 +365,36 @@ void control (RMATCH a, int change)
 		a->feed_forward = a->ff_alpha * current_ratio + (1.0 - a->ff_alpha) * a->feed_forward;
 	}
 	{
-		int deviation = a->n_ring - a->rsize / 2;
+		int deviation = nring_rmatch (a) - a->rsize / 2;
 		xmav (a->propmav, deviation, &a->av_deviation);
 	}
-	EnterCriticalSection (&a->cs_var);
-	a->var = a->feed_forward - a->pr_gain * a->av_deviation;
-	if (a->var > 1.04) a->var = 1.04;
-	if (a->var < 0.96) a->var = 0.96;
-	LeaveCriticalSection (&a->cs_var);
+	var = a->feed_forward - a->pr_gain * a->av_deviation;
+	if (var > 1.04) var = 1.04;
+	if (var < 0.96) var = 0.96;
+	publish_var (a, var);
 }
 
-void blend (RMATCH a)
-{
-	int i, j;
-	for (i = 0, j = a->iout; i <= a->ntslew; i++, j = (j + 1) % a->rsize)
+void upslew (RMATCH a, int newsamps)
+{	// fade in, applied to resampler output before it is published to the ring
+	int i = 0;
+	while (a->ucnt >= 0 && i < newsamps)
 	{
-		a->ring[2 * j + 0] = a->cslew[i] * a->ring[2 * j + 0] + (1.0 - a->cslew[i]) * a->baux[2 * i + 0];
-		a->ring[2 * j + 1] = a->cslew[i] * a->ring[2 * j + 1] + (1.0 - a->cslew[i]) * a->baux[2 * i + 1];
+		a->resout[2 * i + 0] *= a->cslew[a->ntslew - a->ucnt];
+		a->resout[2 * i + 1] *= a->cslew[a->ntslew - a->ucnt];
+		a->ucnt--;
+		i++;
 	}
 }
 
-void upslew (RMATCH a, int newsamps)
-{
+void oslew (RMATCH a, int nwrite)
+{	// fade out the tail of what fits in the ring when the remainder must be dropped
 	int i, j;
-	i = 0;
-	j = a->iin;
-	while (a->ucnt >= 0 && i < newsamps)
+	i = nwrite > a->ntslew + 1 ? nwrite - (a->ntslew + 1) : 0;
+	j = a->ntslew;
+	for (; i < nwrite; i++, j--)
 	{
-		a->ring[2 * j + 0] *= a->cslew[a->ntslew - a->ucnt];
-		a->ring[2 * j + 1] *= a->cslew[a->ntslew - a->ucnt];
-		a->ucnt--;
-		i++;
-		j = (j + 1) % a->rsize;
+		a->resout[2 * i + 0] *= a->cslew[j];
+		a->resout[2 * i + 1] *= a->cslew[j];
 	}
 }
 
@@ -303,125 +404,87 @@ void xrmatchIN (void* b, double* in)
 	RMATCH a = (RMATCH)b;
 	if (InterlockedAnd (&a->run, 1))
 	{
-		int newsamps, first, second, ovfl;
+		int newsamps, nwrite, nfree, first, second, nout;
+		int tflags = RMT_IN;
 		double var;
 		a->v->in = a->in = in;
-		EnterCriticalSection (&a->cs_var);
-		if (!a->force)
+		if (!InterlockedAnd (&a->force, 1))
 			var = a->var;
 		else
 			var = a->fvar;
-		LeaveCriticalSection (&a->cs_var);
 		newsamps = xvarsamp (a->v, var);
-		EnterCriticalSection (&a->cs_ring);
-		a->n_ring += newsamps;
-		if ((ovfl = a->n_ring - a->rsize) > 0)
-		{	
+		if (InterlockedExchange (&a->upslew_req, 0))
+			a->ucnt = a->ntslew;
+		if (a->ucnt >= 0)
+		{
+			upslew (a, newsamps);
+			tflags |= RMT_SLEW;
+		}
+		nfree = a->rsize - nring_rmatch (a);
+		if (newsamps > nfree)
+		{
 			InterlockedIncrement (&a->overflows);
-			// a->n_ring = a->rsize / 2;
-			a->n_ring = a->rsize; //
-			if ((a->ntslew + 1) > (a->rsize - a->iout))
-			{
-				first = a->rsize - a->iout;
-				second = (a->ntslew + 1) - first;
-			}
-			else
-			{
-				first = a->ntslew + 1;
-				second = 0;
-			}
-			memcpy (a->baux, a->ring + 2 * a->iout, first * sizeof (complex));
-			memcpy (a->baux + 2 * first, a->ring, second * sizeof (complex));
-			// a->iout = (a->iout + ovfl + a->rsize / 2) % a->rsize;
-			a->iout = (a->iout + ovfl) % a->rsize; //
+			tflags |= RMT_OVERFLOW | RMT_SLEW;
+			nwrite = nfree;
+			oslew (a, nwrite);
+			a->ucnt = a->ntslew;
 		}
-		if (newsamps > (a->rsize - a->iin))
+		else
+			nwrite = newsamps;
+		if (nwrite > (a->rsize - a->iin))
 		{
 			first = a->rsize - a->iin;
-			second = newsamps - first;
+			second = nwrite - first;
 		}
 		else
 		{
-			first = newsamps;
+			first = nwrite;
 			second = 0;
 		}
 		memcpy (a->ring + 2 * a->iin, a->resout, first * sizeof (complex));
 		memcpy (a->ring, a->resout + 2 * first, second * sizeof (complex));
-		if (a->ucnt >= 0) upslew(a, newsamps);
-		a->iin = (a->iin + newsamps) % a->rsize;
-		if (ovfl > 0) blend (a);
+		a->iin = (a->iin + nwrite) % a->rsize;
+		InterlockedExchangeAdd (&a->wcount, nwrite);
+		nout = InterlockedExchange (&a->outcalls, 0);
 		if (!a->control_flag)
 		{
 			a->writesamps += a->insize;
-			if ((a->readsamps >= a->read_startup) && (a->writesamps >= a->write_startup))
-				a->control_flag = 1;
+			if (((unsigned int)InterlockedAnd (&a->readsamps, 0xFFFFFFFF) >= a->read_startup) && (a->writesamps >= a->write_startup))
+				InterlockedExchange (&a->control_flag, 1);
 		}
-		if (a->control_flag) control (a, a->insize);
-		LeaveCriticalSection (&a->cs_ring);
+		if (a->control_flag)
+		{
+			while (nout-- > 0)
+				control (a, -(a->outsize));
+			control (a, a->insize);
+		}
+		xrmtlm (a, tflags);
 	}
 }
 
-void dslew (RMATCH a)
-{
-	int i, j, k, n;
-	int zeros, first, second;
-	if (a->n_ring > a->ntslew + 1)
+void dslew (RMATCH a, int nread)
+{	// fade out the samples that were available and fill the remainder of the output buffer
+	int i, j;
+	i = nread > a->ntslew + 1 ? nread - (a->ntslew + 1) : 0;
+	j = a->ntslew;
+	if (nread > 0)
 	{
-		i = (a->iout + (a->n_ring - (a->ntslew + 1))) % a->rsize;
-		j = a->ntslew;
-		k = a->ntslew + 1;
-		n = a->n_ring - (a->ntslew + 1);
+		a->dlast[0] = a->out[2 * (nread - 1) + 0];
+		a->dlast[1] = a->out[2 * (nread - 1) + 1];
 	}
-	else
+	for (; i < nread; i++, j--)
 	{
-		i = a->iout;
-		j = a->ntslew;
-		k = a->n_ring;
-		n = 0;
+		a->out[2 * i + 0] *= a->cslew[j];
+		a->out[2 * i + 1] *= a->cslew[j];
 	}
-	while (k > 0 && j >= 0)
+	for (; i < a->outsize && j >= 0; i++, j--)
 	{
-		if (k == 1)
-		{
-			a->dlast[0] = a->ring[2 * i + 0];
-			a->dlast[1] = a->ring[2 * i + 1];
-		}
-		a->ring[2 * i + 0] *= a->cslew[j];
-		a->ring[2 * i + 1] *= a->cslew[j];
-		i = (i + 1) % a->rsize;
-		j--;
-		k--;
-		n++;
+		a->out[2 * i + 0] = a->dlast[0] * a->cslew[j];
+		a->out[2 * i + 1] = a->dlast[1] * a->cslew[j];
 	}
-	while (j >= 0)
-	{
-		a->ring[2 * i + 0] = a->dlast[0] * a->cslew[j];
-		a->ring[2 * i + 1] = a->dlast[1] * a->cslew[j];
-		i = (i + 1) % a->rsize;
-		j--;
-		n++;
-	}
-	// zeros = a->outsize + a->rsize / 2 - n;
-	if ((zeros = a->outsize - n) > 0) //
-	{ //
-		if (zeros > a->rsize - i)
-		{
-			first = a->rsize - i;
-			second = zeros - first;
-		}
-		else
-		{
-			first = zeros;
-			second = 0;
-		}
-		memset (a->ring + 2 * i, 0, first  * sizeof (complex));
-		memset (a->ring,         0, second * sizeof (complex));
-		n += zeros; //
-	} //
-	// a->n_ring = a->outsize + a->rsize / 2;
-	a->n_ring = n; //
-	// a->iin = (a->iout + a->outsize + a->rsize/2) % a->rsize;
-	a->iin = (a->iout + a->n_ring) % a->rsize; //
+	memset (a->out + 2 * i, 0, (a->outsize - i) * sizeof (complex));
+	a->dlast[0] = 0.0;
+	a->dlast[1] = 0.0;
 }
 
 PORT
@@ -430,39 +493,41 @@ void xrmatchOUT (void* b, double* out)
 	RMATCH a = (RMATCH)b;
 	if (InterlockedAnd (&a->run, 1))
 	{
-		int first, second;
+		int nread, first, second;
+		int tflags = RMT_OUT;
 		a->out = out;
-		EnterCriticalSection (&a->cs_ring);
-		if (a->n_ring < a->outsize) 
-		{
-			dslew (a);
-			a->ucnt = a->ntslew;
-			InterlockedIncrement (&a->underflows);
-		}
-		if (a->outsize > (a->rsize - a->iout))
+		if ((nread = nring_rmatch (a)) > a->outsize)
+			nread = a->outsize;
+		if (nread > (a->rsize - a->iout))
 		{
 			first = a->rsize - a->iout;
-			second = a->outsize - first;
+			second = nread - first;
 		}
 		else
 		{
-			first = a->outsize;
+			first = nread;
 			second = 0;
 		}
 		memcpy (a->out, a->ring + 2 * a->iout, first * sizeof (complex));
 		memcpy (a->out + 2 * first, a->ring, second * sizeof (complex));
-		a->iout = (a->iout + a->outsize) % a->rsize;
-		a->n_ring -= a->outsize;
-		a->dlast[0] = a->out[2 * (a->outsize - 1) + 0];
-		a->dlast[1] = a->out[2 * (a->outsize - 1) + 1];
-		if (!a->control_flag)
+		a->iout = (a->iout + nread) % a->rsize;
+		InterlockedExchangeAdd (&a->rcount, nread);
+		if (nread < a->outsize)
 		{
-			a->readsamps += a->outsize;
-			if ((a->readsamps >= a->read_startup) && (a->writesamps >= a->write_startup))
-				a->control_flag = 1;
+			dslew (a, nread);
+			InterlockedExchange (&a->upslew_req, 1);
+			InterlockedIncrement (&a->underflows);
+			tflags |= RMT_UNDERFLOW | RMT_SLEW;
+		}
+		else
+		{
+			a->dlast[0] = a->out[2 * (a->outsize - 1) + 0];
+			a->dlast[1] = a->out[2 * (a->outsize - 1) + 1];
 		}
-		if (a->control_flag) control (a, -(a->outsize));
-		LeaveCriticalSection (&a->cs_ring);
+		if (!InterlockedAnd (&a->control_flag, 1))
+			InterlockedExchangeAdd (&a->readsamps, a->outsize);
+		InterlockedIncrement (&a->outcalls);
+		xrmtlm (a, tflags);
 	}
 }
 
@@ -472,11 +537,9 @@ void getRMatchDiags (void* b, int* underflows, int* overflows, double* var, int*
 	RMATCH a = (RMATCH)b;
 	*underflows = InterlockedAnd (&a->underflows, 0xFFFFFFFF);
 	*overflows  = InterlockedAnd (&a->overflows,  0xFFFFFFFF);
-	EnterCriticalSection (&a->cs_var);
 	*var = a->var;
 	*ringsize = a->ringsize;
-	*nring = a->n_ring;
-	LeaveCriticalSection (&a->cs_var);
+	*nring = nring_rmatch (a);
 }
 
 PORT
@@ -491,10 +554,90 @@ PORT
 void forceRMatchVar (void* b, int force, double fvar)
 {
 	RMATCH a = (RMATCH)b;
-	EnterCriticalSection (&a->cs_var);
-	a->force = force;
-	a->fvar = fvar;
-	LeaveCriticalSection (&a->cs_var);
+	union { double d; LONG64 l; } u;
+	u.d = fvar;
+	InterlockedExchange64 ((volatile LONG64 *)&a->fvar, u.l);
+	InterlockedExchange (&a->force, force);
+}
+
+PORT
+void setRMatchTelemetry (void* b, int run, int size)
+{	// run = 1 starts a new recording of the most recent 'size' records; run = 0 stops it
+	RMATCH a = (RMATCH)b;
+	RMTLM old;
+	EnterCriticalSection (&a->cs_tlm);
+	old = (RMTLM)InterlockedExchangePointer ((void* volatile*)&a->tlm, run ? create_rmtlm (size) : 0);
+	if (old)
+	{
+		while (InterlockedAnd (&a->tlm_users, 0xFFFFFFFF))	// let any record in progress complete
+			Sleep (0);
+		destroy_rmtlm (old);
+	}
+	LeaveCriticalSection (&a->cs_tlm);
+}
+
+PORT
+void getRMatchTelemetry (void* b, int max, int* count, int* lost, double* t, int* nring, double* var, int* flags)
+{	// t is seconds since recording started
+	RMATCH a = (RMATCH)b;
+	RMTLM tlm;
+	*count = 0;
+	*lost = 0;
+	EnterCriticalSection (&a->cs_tlm);
+	if ((tlm = a->tlm) != 0)
+	{
+		*count = read_rmtlm (tlm, max, t, nring, var, flags);
+		*lost = tlm->lost;
+		tlm->lost = 0;
+	}
+	LeaveCriticalSection (&a->cs_tlm);
+}
+
+PORT
+void dumpRMatchTelemetry (void* b, const char* filename, int binary, int* count)
+{	// appends all unread records to the file; binary records are {double t, double var, int nring, int flags}
+	RMATCH a = (RMATCH)b;
+	RMTLM tlm;
+	*count = 0;
+	EnterCriticalSection (&a->cs_tlm);
+	if ((tlm = a->tlm) != 0)
+	{
+		const int chunk = 1024;
+		FILE* file;
+		int i, n;
+		double* t     = (double *) malloc0 (chunk * sizeof (double));
+		double* var   = (double *) malloc0 (chunk * sizeof (double));
+		int*    nring = (int *)    malloc0 (chunk * sizeof (int));
+		int*    flags = (int *)    malloc0 (chunk * sizeof (int));
+		if ((file = fopen (filename, binary ? "ab" : "a")) != NULL)
+		{
+			fseek (file, 0, SEEK_END);
+			if (!binary && ftell (file) == 0)
+				fprintf (file, "t,nring,var,flags\n");
+			while ((n = read_rmtlm (tlm, chunk, t, nring, var, flags)) > 0)
+			{
+				for (i = 0; i < n; i++)
+				{
+					if (binary)
+					{
+						fwrite (&t[i],     sizeof (double), 1, file);
+						fwrite (&var[i],   sizeof (double), 1, file);
+						fwrite (&nring[i], sizeof (int),    1, file);
+						fwrite (&flags[i], sizeof (int),    1, file);
+					}
+					else
+						fprintf (file, "%.9f,%d,%.12f,0x%04x\n", t[i], nring[i], var[i], flags[i]);
+				}
+				*count += n;
+			}
+			fclose (file);
+		}
+		_aligned_free (flags);
+		_aligned_free (nring);
+		_aligned_free (var);
+		_aligned_free (t);
+	}
+	LeaveCriticalSection (&a->cs_tlm);
 }
 
 PORT
@@ -597,10 +740,8 @@ PORT
 void setRMatchFeedbackGain (void* b, double feedback_gain)
 {
 	RMATCH a = (RMATCH)b;
-	EnterCriticalSection(&a->cs_var);
 	a->prop_gain = feedback_gain;
 	a->pr_gain = a->prop_gain * 48000.0 / (double)a->nom_outrate;
-	LeaveCriticalSection(&a->cs_var);
 }
 
 PORT
@@ -700,9 +841,7 @@ PORT
 void getControlFlag(void* ptr, int* control_flag)
 {
 	RMATCH a = (RMATCH)ptr;
-	EnterCriticalSection(&a->cs_ring);
-	*control_flag = a->control_flag;
-	LeaveCriticalSection(&a->cs_ring);
+	*control_flag = InterlockedAnd (&a->control_flag, 1);
 }
 
 // the following function is DEPRECATED
@@ -734,4 +873,12 @@ void* create_rmatchLegacyV(int in_size, int out_size, int nom_inrate, int nom_ou
 		1.0e-06,				// proportional feedback gain  ***W4WMT - reduce loop gain a bit for PowerSDR to help Primary buffers > 512
 		0,						// linearly interpolate cvar by sample  ***W4WMT - set varmode = 0 for PowerSDR (doesn't work otherwise!?!)
 		0.003);					// slew time (seconds)
-}
\ No newline at end of file
+}
+
+PORT
+void setRMatchInterp(void* ptr, int interp)
+{	// 1 = cubic, 0 = linear interpolation between polyphase rows
+	RMATCH a = (RMATCH)ptr;
+	a->interp = interp;
+	setInterp_varsamp (a->v, interp);
+}
@@ -54,6 +54,36 @@ typedef struct _aamav
 	double nom_ratio;
 } aamav, *AAMAV;
 
+// telemetry record flags
+#define RMT_IN					0x0001				// recorded by xrmatchIN()
+#define RMT_OUT					0x0002				// recorded by xrmatchOUT()
+#define RMT_OVERFLOW			0x0004				// ring overflowed during this call
+#define RMT_UNDERFLOW			0x0008				// ring underflowed during this call
+#define RMT_SLEW				0x0010				// up-slew or down-slew active during this call
+#define RMT_CONTROL				0x0020				// control loop active (control_flag)
+#define RMT_FORCE				0x0040				// var is forced
+
+typedef struct _rmtlm_rec
+{
+	volatile long seq;		// 2 * index + 1 while record 'index' is being written, 2 * index + 2 once complete
+	int nring;
+	int flags;
+	long long t;
+	double var;
+} rmtlm_rec;
+
+typedef struct _rmtlm
+{
+	int size;				// must be a power of two
+	int mask;
+	rmtlm_rec* rec;
+	volatile long widx;		// next record to be written (producers)
+	long ridx;				// next record to be read (consumer)
+	long lost;				// records overwritten before they were read
+	LARGE_INTEGER t0;
+	LARGE_INTEGER freq;
+} rmtlm, *RMTLM;
+
 typedef struct _rmatch
 {
 	volatile long run;
@@ -74,10 +104,13 @@ typedef struct _rmatch
 	int ringsize;
 	int rsize;
 	double* ring;
-	int n_ring;
-	int iin;
-	int iout;
-	double var;
+	int iin;						// owned by xrmatchIN()
+	int iout;						// owned by xrmatchOUT()
+	volatile long wcount;			// total samples written to the ring
+	volatile long rcount;			// total samples read from the ring
+	volatile long outcalls;			// xrmatchOUT() calls not yet seen by control()
+	volatile long upslew_req;		// set by xrmatchOUT() after an underflow
+	volatile double var;
 	int R;
 	AAMAV ffmav;
 	MAV propmav;
@@ -92,26 +125,28 @@ typedef struct _rmatch
 	double av_deviation;
 	VARSAMP v;
 	int varmode;
-	CRITICAL_SECTION cs_ring;
-	CRITICAL_SECTION cs_var;
+	int interp;						// varsamp phase interpolation:  1 = cubic, 0 = linear
 	// blend / slew
 	double tslew;
 	int ntslew;
 	double* cslew;
-	double* baux;
 	double dlast[2];
 	int ucnt;
 	// variables to check start-up time for control to become active
-	unsigned int readsamps;
+	volatile long readsamps;
 	unsigned int writesamps;
 	unsigned int read_startup;
 	unsigned int write_startup;
-	int control_flag;
+	volatile long control_flag;
 	// diagnostics
 	volatile long underflows;
 	volatile long overflows;
-	int force;
-	double fvar;
+	volatile long force;
+	volatile double fvar;
+	// telemetry
+	RMTLM volatile tlm;
+	volatile long tlm_users;		// producers currently holding 'tlm'
+	CRITICAL_SECTION cs_tlm;		// serializes the readers with starting and stopping; never taken by the producers
 } rmatch, *RMATCH;
 
 extern __declspec (dllexport) void* create_rmatchV(int in_size, int out_size, int nom_inrate, int nom_outrate, int ringsize, double var);
@@ -138,6 +173,12 @@ extern __declspec (dllexport) void resetRMatchDiags (void* b);
 
 extern __declspec (dllexport) void forceRMatchVar (void* b, int force, double fvar);
 
+extern __declspec (dllexport) void setRMatchTelemetry (void* b, int run, int size);
+
+extern __declspec (dllexport) void getRMatchTelemetry (void* b, int max, int* count, int* lost, double* t, int* nring, double* var, int* flags);
+
+extern __declspec (dllexport) void dumpRMatchTelemetry (void* b, const char* filename, int binary, int* count);
+
 extern __declspec (dllexport) void setRMatchFeedbackGain(void* b, double feedback_gain);
 
 extern __declspec (dllexport) void setRMatchSlewTime(void* b, double slew_time);
@@ -156,4 +197,6 @@ extern __declspec (dllexport) void setRMatchFFAlpha(void* ptr, double ff_alpha);
 
 extern __declspec (dllexport) void getControlFlag(void* ptr, int* control_flag);
 
+extern __declspec (dllexport) void setRMatchInterp(void* ptr, int interp);
+
 #endif
@@ -0,0 +1,267 @@
+/*  sched.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+
+#include "comm.h"
+
+/********************************************************************************************************
+*																										*
+*											DSP Scheduler												*
+*																										*
+********************************************************************************************************/
+
+// Optional replacement for the one-thread-per-channel model of wdspmain().  A fixed pool of workers
+// executes channels as tasks:  fexchange() posts a channel when it queues a buffer, and a free worker
+// runs that channel, earliest deadline first within a priority, until its queued buffers are consumed.
+// Channels opened while the pool exists are attached to it; others keep their dedicated thread.  A
+// stopped channel is never ended from inside a worker:  xmain() reports it and the worker moves on.
+
+#define SCHED_MAX_WORKERS				64
+
+struct _dspsched
+{
+	volatile long run;							// workers loop while set
+	int nworkers;								// number of worker threads
+	int affinity;								// when 1, worker 'i' is pinned to logical processor 'i'
+	volatile long nattached;					// channels currently executed by the pool
+	volatile long nactive;						// workers that have not yet exited
+	HANDLE Sem_Work;							// count = number of queued channel tasks
+	int csinit;									// cs_queue has been initialized; it is never deleted
+	CRITICAL_SECTION cs_queue;
+	int depth;									// channels waiting in 'queue'
+	int queue[MAX_CHANNELS];
+	int maxdepth;								// statistics
+	volatile long tasks;
+	volatile long misses;
+	struct
+	{
+		int pooled;								// channel is executed by the pool rather than its own thread
+		int priority;							// higher runs first; deadline breaks ties
+		volatile long queued;					// channel is in 'queue'
+		volatile long busy;						// a worker is executing the channel
+		long long deadline;						// QPC time by which the queued buffer should be processed
+	} chan[MAX_CHANNELS];
+};
+
+struct _dspsched dspsched;
+
+long long period_sched (int channel)
+{	// QPC ticks spanned by one dsp buffer
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency (&freq);
+	return freq.QuadPart * ch[channel].dsp_size / ch[channel].dsp_rate;
+}
+
+int pop_sched (void)
+{	// called with cs_queue held; removes and returns the most urgent queued channel
+	int i, k = 0, c, best;
+	if (dspsched.depth == 0) return -1;
+	best = dspsched.queue[0];
+	for (i = 1; i < dspsched.depth; i++)
+	{
+		c = dspsched.queue[i];
+		if (dspsched.chan[c].priority > dspsched.chan[best].priority ||
+			(dspsched.chan[c].priority == dspsched.chan[best].priority && dspsched.chan[c].deadline < dspsched.chan[best].deadline))
+		{
+			best = c;
+			k = i;
+		}
+	}
+	dspsched.queue[k] = dspsched.queue[--dspsched.depth];
+	return best;
+}
+
+void schedmain (void* pargs)
+{
+	int worker = (int)(uintptr_t)pargs;
+	int channel;
+	long long deadline;
+	LARGE_INTEGER now;
+	DWORD taskIndex = 0;
+	HANDLE hTask = AvSetMmThreadCharacteristics(TEXT("Pro Audio"), &taskIndex);
+	if (hTask != 0) AvSetMmThreadPriority(hTask, 2);
+	else SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+	if (dspsched.affinity)
+		SetThreadAffinityMask (GetCurrentThread(), (DWORD_PTR)1 << worker);
+
+	while (_InterlockedAnd (&dspsched.run, 1))
+	{
+		WaitForSingleObject (dspsched.Sem_Work, INFINITE);
+		EnterCriticalSection (&dspsched.cs_queue);
+		if ((channel = pop_sched ()) >= 0)
+		{
+			deadline = dspsched.chan[channel].deadline;
+			InterlockedIncrement (&dspsched.chan[channel].busy);
+		}
+		LeaveCriticalSection (&dspsched.cs_queue);
+		if (channel < 0) continue;
+		// clear 'queued' before draining so that a buffer posted meanwhile queues the channel again
+		InterlockedBitTestAndReset (&dspsched.chan[channel].queued, 0);
+		while (dspsched.chan[channel].pooled && _InterlockedAnd (&ch[channel].run, 1) && 
+			WaitForSingleObject (ch[channel].iob.pd->Sem_BuffReady, 0) == WAIT_OBJECT_0)
+		{
+			if (!xmain (channel)) break;
+			InterlockedIncrement (&dspsched.tasks);
+			QueryPerformanceCounter (&now);
+			if (now.QuadPart > deadline)
+				InterlockedIncrement (&dspsched.misses);
+			deadline += period_sched (channel);
+		}
+		InterlockedDecrement (&dspsched.chan[channel].busy);
+	}
+	if (hTask != 0) AvRevertMmThreadCharacteristics (hTask);
+	InterlockedDecrement (&dspsched.nactive);
+}
+
+int attach_sched (int channel)
+{	// returns 1 if the channel will be executed by the pool
+	int pooled = 0;
+	if (!dspsched.csinit) return 0;
+	EnterCriticalSection (&dspsched.cs_queue);
+	if (_InterlockedAnd (&dspsched.run, 1))
+	{
+		dspsched.chan[channel].queued = 0;
+		dspsched.chan[channel].busy = 0;
+		dspsched.chan[channel].pooled = pooled = 1;
+		InterlockedIncrement (&dspsched.nattached);
+	}
+	LeaveCriticalSection (&dspsched.cs_queue);
+	return pooled;
+}
+
+int detach_sched (int channel)
+{	// returns 1, once no worker is executing the channel, if the channel was attached to the pool
+	int i, pooled;
+	if (!dspsched.csinit) return 0;
+	EnterCriticalSection (&dspsched.cs_queue);
+	if (pooled = dspsched.chan[channel].pooled)
+	{
+		dspsched.chan[channel].pooled = 0;
+		for (i = 0; i < dspsched.depth; i++)
+			if (dspsched.queue[i] == channel)
+			{
+				dspsched.queue[i] = dspsched.queue[--dspsched.depth];
+				break;
+			}
+	}
+	LeaveCriticalSection (&dspsched.cs_queue);
+	if (!pooled) return 0;
+	while (_InterlockedAnd (&dspsched.chan[channel].busy, 0xffffffff)) Sleep (1);
+	InterlockedDecrement (&dspsched.nattached);
+	return 1;
+}
+
+void post_sched (int channel)
+{	// called from fexchange() after buffers were queued for the channel
+	LARGE_INTEGER now;
+	if (dspsched.chan[channel].pooled && !InterlockedBitTestAndSet (&dspsched.chan[channel].queued, 0))
+	{
+		QueryPerformanceCounter (&now);
+		EnterCriticalSection (&dspsched.cs_queue);
+		if (dspsched.chan[channel].pooled)
+		{
+			dspsched.chan[channel].deadline = now.QuadPart + period_sched (channel);
+			dspsched.queue[dspsched.depth++] = channel;
+			if (dspsched.depth > dspsched.maxdepth)
+				dspsched.maxdepth = dspsched.depth;
+		}
+		LeaveCriticalSection (&dspsched.cs_queue);
+		ReleaseSemaphore (dspsched.Sem_Work, 1, 0);
+	}
+}
+
+/********************************************************************************************************
+*																										*
+*											Properties													*
+*																										*
+********************************************************************************************************/
+
+PORT
+void CreateDSPScheduler (int nworkers, int affinity)
+{	// nworkers <= 0 selects one worker per logical processor
+	int i;
+	SYSTEM_INFO si;
+	if (_InterlockedAnd (&dspsched.run, 1)) return;
+	if (nworkers <= 0)
+	{
+		GetSystemInfo (&si);
+		nworkers = si.dwNumberOfProcessors;
+	}
+	if (nworkers > SCHED_MAX_WORKERS) nworkers = SCHED_MAX_WORKERS;
+	dspsched.nworkers = nworkers;
+	dspsched.affinity = affinity;
+	dspsched.depth = 0;
+	dspsched.maxdepth = 0;
+	dspsched.tasks = 0;
+	dspsched.misses = 0;
+	if (!dspsched.csinit)
+	{
+		InitializeCriticalSectionAndSpinCount (&dspsched.cs_queue, 2500);
+		dspsched.csinit = 1;
+	}
+	dspsched.Sem_Work = CreateSemaphore (0, 0, 1000000, 0);
+	dspsched.nactive = dspsched.nworkers;
+	InterlockedBitTestAndSet (&dspsched.run, 0);
+	for (i = 0; i < dspsched.nworkers; i++)
+		_beginthread (schedmain, 0, (void *)(uintptr_t)i);
+}
+
+PORT
+void DestroyDSPScheduler (void)
+{	// channels still attached are handed back to dedicated threads before the workers are stopped
+	int channel;
+	if (!_InterlockedAnd (&dspsched.run, 1)) return;
+	EnterCriticalSection (&dspsched.cs_queue);
+	InterlockedBitTestAndReset (&dspsched.run, 0);			// no channel attaches from here on
+	LeaveCriticalSection (&dspsched.cs_queue);
+	for (channel = 0; channel < MAX_CHANNELS; channel++)
+		if (detach_sched (channel) && _InterlockedAnd (&ch[channel].run, 1))
+			start_thread (channel);
+	ReleaseSemaphore (dspsched.Sem_Work, dspsched.nworkers, 0);
+	while (_InterlockedAnd (&dspsched.nactive, 0xffffffff)) Sleep (1);
+	CloseHandle (dspsched.Sem_Work);
+}
+
+PORT
+void SetChannelPriority (int channel, int priority)
+{
+	dspsched.chan[channel].priority = priority;
+}
+
+PORT
+void GetDSPSchedulerStats (int* depth, int* maxdepth, int* tasks, int* misses)
+{
+	*depth = *maxdepth = 0;
+	if (dspsched.csinit)
+	{
+		EnterCriticalSection (&dspsched.cs_queue);
+		*depth    = dspsched.depth;
+		*maxdepth = dspsched.maxdepth;
+		LeaveCriticalSection (&dspsched.cs_queue);
+	}
+	*tasks    = dspsched.tasks;
+	*misses   = dspsched.misses;
+}
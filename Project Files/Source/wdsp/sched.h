@@ -0,0 +1,45 @@
+/*  sched.h
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+
+#ifndef _sched_h
+#define _sched_h
+
+extern int attach_sched (int channel);
+
+extern int detach_sched (int channel);
+
+extern void post_sched (int channel);
+
+extern __declspec (dllexport) void CreateDSPScheduler (int nworkers, int affinity);
+
+extern __declspec (dllexport) void DestroyDSPScheduler (void);
+
+extern __declspec (dllexport) void SetChannelPriority (int channel, int priority);
+
+extern __declspec (dllexport) void GetDSPSchedulerStats (int* depth, int* maxdepth, int* tasks, int* misses);
+
+#endif
@@ -67,7 +67,9 @@ SIPHON create_siphon (int run, int position, int mode, int disp, int insize,
 	a->idx = 0;
 	a->sipout  = (double *) malloc0 (a->sipsize * sizeof (complex));
 	a->specout = (double *) malloc0 (a->fftsize * sizeof (complex));
+	enter_planner ();
 	a->sipplan = fftw_plan_dft_1d (a->fftsize, (fftw_complex *)a->sipout, (fftw_complex *)a->specout, FFTW_FORWARD, FFTW_PATIENT);
+	leave_planner ();
 	a->window  = (double *) malloc0 (a->fftsize * sizeof (complex));
 	InitializeCriticalSectionAndSpinCount(&a->update, 2500);
 	build_window (a);
@@ -77,7 +79,9 @@ SIPHON create_siphon (int run, int position, int mode, int disp, int insize,
 void destroy_siphon (SIPHON a)
 {
 	DeleteCriticalSection(&a->update);
+	enter_planner ();
 	fftw_destroy_plan (a->sipplan);
+	leave_planner ();
 	_aligned_free (a->window);
 	_aligned_free (a->specout);
 	_aligned_free (a->sipout);
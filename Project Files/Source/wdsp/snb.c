@@ -88,8 +88,28 @@ SNBA create_snba (int run, double* in, double* out, int inrate, int internalrate
 	d->out_low_cut = out_low_cut;
 	d->out_high_cut = out_high_cut;
 
-	calc_snba (d);
+	if (d->run) materialize_snba (d);
+	return d;
+}
+
+void decalc_snba (SNBA d)
+{
+	destroy_resample (d->outresamp);
+	destroy_resample (d->inresamp);
+	_aligned_free (d->outbuff);
+	_aligned_free (d->inbuff);
+	_aligned_free (d->outaccum);
+	_aligned_free (d->inaccum);
+}
+
+void destroy_snba (SNBA d)
+{
+	release_snba (d);
+	_aligned_free (d);
+}
 
+void calc_work_snba (SNBA d)
+{
 	d->xbase    = (double *) malloc0 (2 * d->xsize * sizeof (double));
 	d->xaux     = d->xbase + d->xsize;
 	d->exec.a       = (double *) malloc0 (d->xsize * sizeof (double));
@@ -114,21 +134,9 @@ SNBA create_snba (int run, double* in, double* out, int inrate, int internalrate
 	d->wrk.dR_z            = (double *) malloc0 ((d->xsize - 2) * sizeof(double));
 	d->wrk.asolve_r        = (double *) malloc0 ((d->exec.asize + 1) * sizeof(double));
 	d->wrk.asolve_z        = (double *) malloc0 ((d->exec.asize + 1) * sizeof(double));
-
-	return d;
-}
-
-void decalc_snba (SNBA d)
-{
-	destroy_resample (d->outresamp);
-	destroy_resample (d->inresamp);
-	_aligned_free (d->outbuff);
-	_aligned_free (d->inbuff);
-	_aligned_free (d->outaccum);
-	_aligned_free (d->inaccum);
 }
 
-void destroy_snba (SNBA d)
+void decalc_work_snba (SNBA d)
 {
 	_aligned_free (d->wrk.xHat_r);
 	_aligned_free (d->wrk.xHat_ATAI);
@@ -152,14 +160,57 @@ void destroy_snba (SNBA d)
 	_aligned_free (d->exec.a);
 
 	_aligned_free (d->xbase);
+}
+
+void materialize_snba (SNBA d)
+{	// allocates the internals of a block that was created, or later released, while not running
+	if (!d->live)
+	{
+		calc_snba (d);
+		calc_work_snba (d);
+		if (d->out_bw_set)
+			setBandwidth_resample (d->outresamp, d->out_f_low, d->out_f_high);
+		d->live = 1;
+	}
+}
 
-	decalc_snba (d);
+void release_snba (SNBA d)
+{
+	if (d->live)
+	{
+		d->live = 0;
+		decalc_work_snba (d);
+		decalc_snba (d);
+	}
+}
 
-	_aligned_free (d);
+void stage_snba (SNBA d, CRITICAL_SECTION* cs)
+{	// materializes 'd' without holding 'cs' across the allocations and fft planning:  the internals are
+	// built in a private copy, then adopted under 'cs' only if nothing changed the block in the meantime
+	SNBA s = (SNBA) malloc0 (sizeof (snba));
+	SNBA b = (SNBA) malloc0 (sizeof (snba));
+	EnterCriticalSection (cs);
+	while (!d->live)
+	{
+		memcpy (s, d, sizeof (snba));
+		memcpy (b, d, sizeof (snba));
+		LeaveCriticalSection (cs);
+		materialize_snba (b);
+		QueryPerformanceCounter (&b->toff);				// the idle-release timer starts now
+		EnterCriticalSection (cs);
+		if (memcmp (d, s, sizeof (snba)) == 0)
+			memcpy (d, b, sizeof (snba));
+		else
+			release_snba (b);
+	}
+	LeaveCriticalSection (cs);
+	_aligned_free (b);
+	_aligned_free (s);
 }
 
 void flush_snba (SNBA d)
 {
+	if (!d->live) return;
 	d->iainidx = 0;
 	d->iaoutidx = 0;
 	d->nsamps = 0;
@@ -186,24 +237,24 @@ void flush_snba (SNBA d)
 
 void setBuffers_snba (SNBA a, double* in, double* out)
 {
-	decalc_snba (a);
+	if (a->live) decalc_snba (a);
 	a->in = in;
 	a->out = out;
-	calc_snba (a);
+	if (a->live) calc_snba (a);
 }
 
 void setSamplerate_snba (SNBA a, int rate)
 {
-	decalc_snba (a);
+	if (a->live) decalc_snba (a);
 	a->inrate = rate;
-	calc_snba (a);
+	if (a->live) calc_snba (a);
 }
 
 void setSize_snba (SNBA a, int size)
 {
-	decalc_snba (a);
+	if (a->live) decalc_snba (a);
 	a->bsize = size;
-	calc_snba (a);
+	if (a->live) calc_snba (a);
 }
 
 void ATAc0 (int n, int nr, double* A, double* r)
@@ -581,10 +632,13 @@ PORT void SetRXASNBARun (int channel, int run)
 	SNBA a = rxa[channel].snba.p;
 	if (a->run != run)
 	{
+		if (run) stage_snba (a, &ch[channel].csDSP);
 		RXAbpsnbaCheck (channel, rxa[channel].mode, rxa[channel].ndb.p->master_run);
 		RXAbp1Check (channel, rxa[channel].amd.p->run, run, rxa[channel].emnr.p->run, 
 			rxa[channel].anf.p->run, rxa[channel].anr.p->run);
 		EnterCriticalSection (&ch[channel].csDSP);
+		if (run) materialize_snba (a);			// no-op unless released since staging
+		else     QueryPerformanceCounter (&a->toff);
 		a->run = run;
 		RXAbp1Set (channel);
 		RXAbpsnbaSet (channel);
@@ -594,10 +648,11 @@ PORT void SetRXASNBARun (int channel, int run)
 
 PORT void SetRXASNBAovrlp (int channel, int ovrlp)
 {
+	SNBA a = rxa[channel].snba.p;
 	EnterCriticalSection (&ch[channel].csDSP);
-	decalc_snba (rxa[channel].snba.p);
-	rxa[channel].snba.p->ovrlp = ovrlp;
-	calc_snba (rxa[channel].snba.p);
+	if (a->live) decalc_snba (a);
+	a->ovrlp = ovrlp;
+	if (a->live) calc_snba (a);
 	LeaveCriticalSection (&ch[channel].csDSP);
 }
 
@@ -660,11 +715,9 @@ PORT void SetRXASNBApmultmin (int channel, double pmultmin)
 PORT void SetRXASNBAOutputBandwidth (int channel, double flow, double fhigh)
 {
 	SNBA a;
-	RESAMPLE d;
 	double f_low, f_high;
 	EnterCriticalSection (&ch[channel].csDSP);
 	a = rxa[channel].snba.p;
-	d = a->outresamp;
 
 	if (flow >= 0 && fhigh >= 0)
 	{
@@ -688,7 +741,11 @@ PORT void SetRXASNBAOutputBandwidth (int channel, double flow, double fhigh)
 		f_high = min (a->out_high_cut, absmax);
 	}
 
-	setBandwidth_resample (d, f_low, f_high);
+	a->out_bw_set = 1;
+	a->out_f_low  = f_low;
+	a->out_f_high = f_high;
+	if (a->live)
+		setBandwidth_resample (a->outresamp, f_low, f_high);
 	LeaveCriticalSection (&ch[channel].csDSP);
 }
 
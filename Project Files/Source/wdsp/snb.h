@@ -32,6 +32,8 @@ warren@wpratt.com
 typedef struct _snba
 {
 	int run;
+	int live;						// internals are allocated; only while live may 'run' be set
+	LARGE_INTEGER toff;				// time at which 'run' was last cleared
 	double* in;
 	double* out;
 	int inrate;
@@ -102,6 +104,9 @@ typedef struct _snba
 	} wrk;
 	double out_low_cut;
 	double out_high_cut;
+	int out_bw_set;					// an output bandwidth was requested; re-applied on materialization
+	double out_f_low;
+	double out_f_high;
 } snba, *SNBA;
 
 extern SNBA create_snba (int run, double* in, double* out, int inrate, int internalrate, int bsize, int ovrlp, int xsize,
@@ -111,6 +116,12 @@ extern void destroy_snba (SNBA d);
 
 extern void flush_snba (SNBA d);
 
+extern void materialize_snba (SNBA d);
+
+extern void release_snba (SNBA d);
+
+extern void stage_snba (SNBA d, CRITICAL_SECTION* cs);
+
 extern void xsnba (SNBA d);
 
 extern void setBuffers_snba (SNBA a, double* in, double* out);
@@ -0,0 +1,213 @@
+/*  stft.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+#include "comm.h"
+
+/********************************************************************************************************
+*																										*
+*								Short-Time Fourier Transform / Overlap-Add								*
+*																										*
+********************************************************************************************************/
+
+// Real-input STFT engine shared by the spectral processors (EMNR, CFCOMP).  Each block of 'bsize'
+// samples is appended to a linear analysis buffer; every 'incr' samples a frame of 'fsize' is windowed,
+// transformed, handed to the owner's frame function, inverse transformed, windowed again and
+// overlap-added into a linear output buffer.  Both buffers are compacted only when they run out of
+// room, so the per-sample work is free of modulo indexing.
+
+void calc_stft (STFT a)
+{
+	int i, g, r, t;
+	a->incr = a->fsize / a->ovrlp;
+	a->msize = a->fsize / 2 + 1;
+	// latency of the overlap-add:  fsize - gcd(bsize, incr), the smallest that never reads unwritten output;
+	// for the power-of-two sizes used here this is fsize - min(bsize, incr), as in the original ring arithmetic
+	g = a->bsize;
+	r = a->incr;
+	while (r)
+	{
+		t = g % r;
+		g = r;
+		r = t;
+	}
+	a->delay = a->fsize - g;
+	a->ibsize = 2 * (a->fsize + a->bsize);
+	a->obsize = 2 * (a->fsize + a->bsize + a->incr);
+	a->awin      = (double *)malloc0 (a->fsize  * sizeof(double));
+	a->swin      = (double *)malloc0 (a->fsize  * sizeof(double));
+	a->inbuff    = (double *)malloc0 (a->ibsize * sizeof(double));
+	a->forfftin  = (double *)malloc0 (a->fsize  * sizeof(double));
+	a->forfftout = (double *)malloc0 (a->msize  * sizeof(complex));
+	a->revfftin  = (double *)malloc0 (a->msize  * sizeof(complex));
+	a->revfftout = (double *)malloc0 (a->fsize  * sizeof(double));
+	a->save      = (double **)malloc0 (a->ovrlp * sizeof(double *));
+	for (i = 0; i < a->ovrlp; i++)
+		a->save[i] = (double *)malloc0 (a->fsize * sizeof(double));
+	a->outbuff   = (double *)malloc0 (a->obsize * sizeof(double));
+	enter_planner ();
+	a->Rfor = fftw_plan_dft_r2c_1d (a->fsize, a->forfftin, (fftw_complex *)a->forfftout, FFTW_ESTIMATE);
+	a->Rrev = fftw_plan_dft_c2r_1d (a->fsize, (fftw_complex *)a->revfftin, a->revfftout, FFTW_ESTIMATE);
+	leave_planner ();
+	flush_stft (a);
+}
+
+void decalc_stft (STFT a)
+{
+	int i;
+	enter_planner ();
+	fftw_destroy_plan (a->Rrev);
+	fftw_destroy_plan (a->Rfor);
+	leave_planner ();
+	_aligned_free (a->outbuff);
+	for (i = 0; i < a->ovrlp; i++)
+		_aligned_free (a->save[i]);
+	_aligned_free (a->save);
+	_aligned_free (a->revfftout);
+	_aligned_free (a->revfftin);
+	_aligned_free (a->forfftout);
+	_aligned_free (a->forfftin);
+	_aligned_free (a->inbuff);
+	_aligned_free (a->swin);
+	_aligned_free (a->awin);
+}
+
+STFT create_stft (int bsize, double* in, double* out, int fsize, int ovrlp, void (*frame)(void* ptr), void* ptr)
+{
+	STFT a = (STFT) malloc0 (sizeof (stft));
+	a->bsize = bsize;
+	a->in = in;
+	a->out = out;
+	a->fsize = fsize;
+	a->ovrlp = ovrlp;
+	a->frame = frame;
+	a->ptr = ptr;
+	calc_stft (a);
+	return a;
+}
+
+void destroy_stft (STFT a)
+{
+	decalc_stft (a);
+	_aligned_free (a);
+}
+
+void flush_stft (STFT a)
+{
+	int i;
+	memset (a->inbuff, 0, a->ibsize * sizeof (double));
+	for (i = 0; i < a->ovrlp; i++)
+		memset (a->save[i], 0, a->fsize * sizeof (double));
+	memset (a->outbuff, 0, a->obsize * sizeof (double));
+	a->ibinidx  = 0;
+	a->iboutidx = 0;
+	a->saveidx  = 0;
+	a->obinidx  = a->delay;
+	a->oboutidx = 0;
+}
+
+void setWindow_stft (STFT a, double* window, double again, double sgain)
+{	// the gains are folded into the windows; again * window[i] * x is evaluated left to right, so this is exact
+	int i;
+	for (i = 0; i < a->fsize; i++)
+	{
+		a->awin[i] = again * window[i];
+		a->swin[i] = sgain * window[i];
+	}
+}
+
+void mulwin_stft (int n, double* w, double* x, double* y)
+{	// y[i] = w[i] * x[i]
+	int i;
+	const int n2 = n & ~1;
+	for (i = 0; i < n2; i += 2)
+		_mm_storeu_pd (&y[i], _mm_mul_pd (_mm_loadu_pd (&w[i]), _mm_loadu_pd (&x[i])));
+	for (; i < n; i++)
+		y[i] = w[i] * x[i];
+}
+
+void ola_stft (STFT a, double* y)
+{	// one 'incr' segment of output:  newest frame first, then progressively older frames
+	int i, k, sb;
+	const int n2 = a->incr & ~1;
+	double* s;
+	memcpy (y, a->save[a->saveidx], a->incr * sizeof (double));
+	for (k = 1; k < a->ovrlp; k++)
+	{
+		if ((sb = a->saveidx - k) < 0) sb += a->ovrlp;
+		s = a->save[sb] + k * a->incr;
+		for (i = 0; i < n2; i += 2)
+			_mm_storeu_pd (&y[i], _mm_add_pd (_mm_loadu_pd (&y[i]), _mm_loadu_pd (&s[i])));
+		for (; i < a->incr; i++)
+			y[i] += s[i];
+	}
+}
+
+void xstft (STFT a)
+{
+	int i;
+	double* p;
+	if (a->ibinidx + a->bsize > a->ibsize)
+	{
+		memmove (a->inbuff, a->inbuff + a->iboutidx, (a->ibinidx - a->iboutidx) * sizeof (double));
+		a->ibinidx -= a->iboutidx;
+		a->iboutidx = 0;
+	}
+	p = a->inbuff + a->ibinidx;
+	for (i = 0; i < a->bsize; i++)
+		p[i] = a->in[2 * i + 0];
+	a->ibinidx += a->bsize;
+	while (a->ibinidx - a->iboutidx >= a->fsize)
+	{
+		mulwin_stft (a->fsize, a->awin, a->inbuff + a->iboutidx, a->forfftin);
+		a->iboutidx += a->incr;
+		fftw_execute (a->Rfor);
+		(*a->frame)(a->ptr);
+		fftw_execute (a->Rrev);
+		mulwin_stft (a->fsize, a->swin, a->revfftout, a->save[a->saveidx]);
+		if (a->obinidx + a->incr > a->obsize)
+		{
+			memmove (a->outbuff, a->outbuff + a->oboutidx, (a->obinidx - a->oboutidx) * sizeof (double));
+			a->obinidx -= a->oboutidx;
+			a->oboutidx = 0;
+		}
+		ola_stft (a, a->outbuff + a->obinidx);
+		a->obinidx += a->incr;
+		if (++a->saveidx == a->ovrlp) a->saveidx = 0;
+	}
+	p = a->outbuff + a->oboutidx;
+	for (i = 0; i < a->bsize; i++)
+	{
+		a->out[2 * i + 0] = p[i];
+		a->out[2 * i + 1] = 0.0;
+	}
+	a->oboutidx += a->bsize;
+}
+
+void setBuffers_stft (STFT a, double* in, double* out)
+{
+	a->in = in;
+	a->out = out;
+}
@@ -0,0 +1,74 @@
+/*  stft.h
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+#ifndef _stft_h
+#define _stft_h
+
+typedef struct _stft
+{
+	int bsize;									// block size, complex samples
+	double* in;									// input buffer, real part is processed
+	double* out;								// output buffer, imaginary part is zeroed
+	int fsize;									// fft size
+	int ovrlp;									// number of overlapping frames
+	int incr;									// frame advance, fsize / ovrlp
+	int msize;									// number of bins, fsize / 2 + 1
+	double* awin;								// analysis window, including any pre-fft gain
+	double* swin;								// synthesis window, including any post-fft gain
+	int ibsize;									// size of the linear analysis buffer
+	double* inbuff;								// analysis buffer, frames start at iboutidx
+	int ibinidx;
+	int iboutidx;
+	double* forfftin;
+	double* forfftout;							// complex spectrum handed to the frame function
+	double* revfftin;							// complex spectrum written by the frame function
+	double* revfftout;
+	double** save;								// last 'ovrlp' synthesized frames
+	int saveidx;
+	int delay;									// output latency, samples
+	int obsize;									// size of the linear overlap-add output buffer
+	double* outbuff;
+	int obinidx;
+	int oboutidx;
+	fftw_plan Rfor;
+	fftw_plan Rrev;
+	void (*frame)(void* ptr);					// per-frame processing:  forfftout -> revfftin
+	void* ptr;									// argument passed to 'frame'
+} stft, *STFT;
+
+extern STFT create_stft (int bsize, double* in, double* out, int fsize, int ovrlp, void (*frame)(void* ptr), void* ptr);
+
+extern void destroy_stft (STFT a);
+
+extern void flush_stft (STFT a);
+
+extern void xstft (STFT a);
+
+extern void setWindow_stft (STFT a, double* window, double again, double sgain);
+
+extern void setBuffers_stft (STFT a, double* in, double* out);
+
+#endif
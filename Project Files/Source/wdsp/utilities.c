@@ -42,6 +42,38 @@ void *malloc0 (int size)
 	return p;
 }
 
+struct _planlock
+{
+	volatile long init;										// 1 while initializing, 2 when initialized
+	CRITICAL_SECTION cs;
+} planlock;
+
+CRITICAL_SECTION* get_planlock (void)
+{	// fftw's planner and fftw_destroy_plan() are not thread-safe; every wdsp call to either holds this lock
+	if (!InterlockedCompareExchange (&planlock.init, 1, 0))
+	{
+		InitializeCriticalSectionAndSpinCount (&planlock.cs, 0);
+		InterlockedExchange (&planlock.init, 2);
+	}
+	while (_InterlockedAnd (&planlock.init, 0xffffffff) != 2) Sleep (0);
+	return &planlock.cs;
+}
+
+void enter_planner (void)
+{
+	EnterCriticalSection (get_planlock ());
+}
+
+int try_enter_planner (void)
+{
+	return TryEnterCriticalSection (get_planlock ());
+}
+
+void leave_planner (void)
+{
+	LeaveCriticalSection (&planlock.cs);
+}
+
 // Exported calls
 
 PORT void
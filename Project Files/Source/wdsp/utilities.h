@@ -26,6 +26,12 @@ warren@wpratt.com
 
 __declspec (dllexport) void *malloc0 (int size);
 
+extern void enter_planner (void);
+
+extern int try_enter_planner (void);
+
+extern void leave_planner (void);
+
 extern void print_impulse (const char* filename, int N, double* impulse, int rtype, int pr_mode);
 
 extern __declspec (dllexport) void analyze_bandpass_filter (int N, double f_low, double f_high, double samplerate, int wintype, int rtype, double scale);
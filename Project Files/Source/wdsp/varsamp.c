@@ -26,6 +26,20 @@ warren@wpratt.com
 
 #include "comm.h"
 
+void calc_bank_varsamp (VARSAMP a)
+{	// polyphase bank:  row (p + 1) holds phase p, p = -1 ... R + 1, in the tap order of the ring
+	int p, i, j;
+	a->rstride = a->rsize + (a->rsize & 1);
+	a->bank = (double *)malloc0 ((a->R + 3) * a->rstride * sizeof (double));
+	for (p = -1; p <= a->R + 1; p++)
+		for (i = 0; i < a->rsize; i++)
+		{
+			j = p + a->R * (a->rsize - 1 - i);
+			if (j >= 0 && j < a->ncoef)
+				a->bank[(p + 1) * a->rstride + i] = a->h[j];
+		}
+}
+
 void calc_varsamp (VARSAMP a)
 {
 	double min_rate, max_rate, norm_rate;
@@ -60,18 +74,20 @@ void calc_varsamp (VARSAMP a)
 	a->ncoef += (a->R - 1) * (a->ncoef - 1);
 	a->h = fir_bandpass(a->ncoef, fc_norm_low, fc_norm_high, (double)a->R, 1, 0, (double)a->R * a->gain);
 	// print_impulse ("imp.txt", a->ncoef, a->h, 0, 0);
-	a->ring = (double *)malloc0(a->rsize * sizeof(complex));
+	calc_bank_varsamp (a);
+	_aligned_free (a->h);
+	a->h = 0;
+	// the ring is stored twice, back to back, so every inner product is over contiguous memory
+	a->ring = (double *)malloc0(2 * a->rstride * sizeof(complex));
 	a->idx_in = a->rsize - 1;
 	a->h_offset = 0.0;
-	a->hs = (double *)malloc0 (a->rsize * sizeof (double));
 	a->isamps = 0.0;
 }
 
 void decalc_varsamp (VARSAMP a)
 {
-	_aligned_free (a->hs);
 	_aligned_free (a->ring);
-	_aligned_free (a->h);
+	_aligned_free (a->bank);
 }
 
 VARSAMP create_varsamp ( int run, int size, double* in, double* out, 
@@ -91,6 +107,7 @@ VARSAMP create_varsamp ( int run, int size, double* in, double* out,
 	a->gain = gain;
 	a->var = var;
 	a->varmode = varmode;
+	a->interp = 1;
 	calc_varsamp (a);
 	return a;
 }
@@ -103,22 +120,57 @@ void destroy_varsamp (VARSAMP a)
 
 void flush_varsamp (VARSAMP a)
 {
-	memset (a->ring, 0, a->rsize * sizeof (complex));
+	memset (a->ring, 0, 2 * a->rstride * sizeof (complex));
 	a->idx_in = a->rsize - 1;
 	a->h_offset = 0.0;
 	a->isamps = 0.0;
 }
 
-void hshift (VARSAMP a)
-{
-	int i, j, k;
-	int hidx;
+void dot_varsamp (VARSAMP a, double* out)
+{	// one output sample:  filter taps are interpolated between adjacent polyphase rows
+	// and applied to the contiguous ring in a single pass, two taps per iteration
+	int j, hidx;
 	double frac, pos;
+	const double* x = a->ring + 2 * a->idx_in;
+	const double* b0;
+	__m128d acc0 = _mm_setzero_pd ();
+	__m128d acc1 = _mm_setzero_pd ();
+	__m128d hs;
 	pos = (double)a->R * a->h_offset;
 	hidx = (int)(pos);
 	frac = pos - (double)hidx;
-	for (i = a->rsize - 1, j = hidx, k = hidx + 1; i >= 0; i--, j += a->R, k += a->R)
-		a->hs[i] = a->h[j] + frac * (a->h[k] - a->h[j]);
+	b0 = a->bank + (hidx + 1) * a->rstride;
+	if (a->interp)
+	{	// cubic (Lagrange) interpolation across phases hidx - 1 ... hidx + 2
+		const double* bm = b0 - a->rstride;
+		const double* b1 = b0 + a->rstride;
+		const double* b2 = b1 + a->rstride;
+		const __m128d wm = _mm_set1_pd (- frac * (frac - 1.0) * (frac - 2.0) / 6.0);
+		const __m128d w0 = _mm_set1_pd (  (frac + 1.0) * (frac - 1.0) * (frac - 2.0) / 2.0);
+		const __m128d w1 = _mm_set1_pd (- (frac + 1.0) * frac * (frac - 2.0) / 2.0);
+		const __m128d w2 = _mm_set1_pd (  (frac + 1.0) * frac * (frac - 1.0) / 6.0);
+		for (j = 0; j < a->rstride; j += 2)
+		{
+			hs = _mm_add_pd (_mm_add_pd (_mm_mul_pd (wm, _mm_loadu_pd (bm + j)), _mm_mul_pd (w0, _mm_loadu_pd (b0 + j))),
+				_mm_add_pd (_mm_mul_pd (w1, _mm_loadu_pd (b1 + j)), _mm_mul_pd (w2, _mm_loadu_pd (b2 + j))));
+			acc0 = _mm_add_pd (acc0, _mm_mul_pd (_mm_unpacklo_pd (hs, hs), _mm_loadu_pd (x + 2 * j + 0)));
+			acc1 = _mm_add_pd (acc1, _mm_mul_pd (_mm_unpackhi_pd (hs, hs), _mm_loadu_pd (x + 2 * j + 2)));
+		}
+	}
+	else
+	{	// linear interpolation across phases hidx, hidx + 1
+		const double* b1 = b0 + a->rstride;
+		const __m128d f = _mm_set1_pd (frac);
+		__m128d h0;
+		for (j = 0; j < a->rstride; j += 2)
+		{
+			h0 = _mm_loadu_pd (b0 + j);
+			hs = _mm_add_pd (h0, _mm_mul_pd (f, _mm_sub_pd (_mm_loadu_pd (b1 + j), h0)));
+			acc0 = _mm_add_pd (acc0, _mm_mul_pd (_mm_unpacklo_pd (hs, hs), _mm_loadu_pd (x + 2 * j + 0)));
+			acc1 = _mm_add_pd (acc1, _mm_mul_pd (_mm_unpackhi_pd (hs, hs), _mm_loadu_pd (x + 2 * j + 2)));
+		}
+	}
+	_mm_storeu_pd (out, _mm_add_pd (acc0, acc1));
 }
 
 int xvarsamp (VARSAMP a, double var)
@@ -138,13 +190,11 @@ int xvarsamp (VARSAMP a, double var)
 	else            a->dicvar = 0.0;
 	if (a->run)
 	{
-		int i, j;
-		int idx_out;
-		double I, Q;
+		int i;
 		for (i = 0; i < a->size; i++)
 		{
-			a->ring[2 * a->idx_in + 0] = a->in[2 * i + 0];
-			a->ring[2 * a->idx_in + 1] = a->in[2 * i + 1];
+			a->ring[2 * a->idx_in + 0] = a->ring[2 * (a->idx_in + a->rsize) + 0] = a->in[2 * i + 0];
+			a->ring[2 * a->idx_in + 1] = a->ring[2 * (a->idx_in + a->rsize) + 1] = a->in[2 * i + 1];
 			a->inv_cvar += a->dicvar;
 			picvar = (uint64_t*)(&a->inv_cvar);
 			N = *picvar & 0xffffffffffff0000;
@@ -152,20 +202,10 @@ int xvarsamp (VARSAMP a, double var)
 			a->delta = 1.0 - a->inv_cvar;
 			while (a->isamps < 1.0)
 			{
-				I = 0.0;
-				Q = 0.0;
-				hshift (a);
+				dot_varsamp (a, a->out + 2 * outsamps);
 				a->h_offset += a->delta;
 				while (a->h_offset >= 1.0) a->h_offset -= 1.0;
 				while (a->h_offset <  0.0) a->h_offset += 1.0;
-				for (j = 0; j < a->rsize; j++)
-				{
-					if ((idx_out = a->idx_in + j) >= a->rsize) idx_out -= a->rsize;
-					I += a->hs[j] * a->ring[2 * idx_out + 0];
-					Q += a->hs[j] * a->ring[2 * idx_out + 1];
-				}
-				a->out[2 * outsamps + 0] = I;
-				a->out[2 * outsamps + 1] = Q;
 				outsamps++;
 				a->isamps += a->inv_cvar;
 			}
@@ -225,6 +265,11 @@ void setBandwidth_varsamp (VARSAMP a, double fc_low, double fc_high)
 	}
 }
 
+void setInterp_varsamp (VARSAMP a, int interp)
+{
+	a->interp = interp;
+}
+
 // exported calls
 
 PORT
@@ -51,8 +51,10 @@ typedef struct _varsamp
 	double old_inv_cvar;
 	double dicvar;
 	double delta;
-	double* hs;
 	int R;
+	double* bank;
+	int rstride;
+	int interp;
 	double h_offset;
 	double isamps;
 	double nom_ratio;
@@ -79,4 +81,6 @@ extern void setFCLow_varsamp (VARSAMP a, double fc_low);
 
 extern void setBandwidth_varsamp (VARSAMP a, double fc_low, double fc_high);
 
+extern void setInterp_varsamp (VARSAMP a, int interp);
+
 #endif
\ No newline at end of file
@@ -48,11 +48,15 @@ void calc_wcpagc (WCPAGC a)
 	a->state = 0;
 	a->ring = (double *)malloc0(RB_SIZE * sizeof(complex));
 	a->abs_ring = (double *)malloc0(RB_SIZE * sizeof(double));
+	a->peak = (int *)malloc0(RB_SIZE * sizeof(int));
+	a->abs_in = (double *)malloc0(a->io_buffsize * sizeof(double));
 	loadWcpAGC(a);
 }
 
 void decalc_wcpagc (WCPAGC a)
 {
+	_aligned_free(a->abs_in);
+	_aligned_free(a->peak);
 	_aligned_free(a->abs_ring);
 	_aligned_free(a->ring);
 }
@@ -143,6 +147,70 @@ void loadWcpAGC (WCPAGC a)
 	a->onemhang_backmult = 1.0 - a->hang_backmult;
 
 	a->hang_decay_mult = 1.0 - exp(-1.0 / (a->sample_rate * a->tau_hang_decay));
+
+	reset_peak_wcpagc (a);
+}
+
+void reset_peak_wcpagc (WCPAGC a)
+{	// rebuild the peak deque over the current look-ahead window, out_index + 1 ... in_index
+	int j, k, idx;
+	a->peak_head = 0;
+	a->peak_count = 0;
+	k = a->out_index;
+	for (j = 0; j < a->attack_buffsize; j++)
+	{
+		if (++k >= a->ring_buffsize)
+			k -= a->ring_buffsize;
+		while (a->peak_count > 0)
+		{
+			idx = a->peak_head + a->peak_count - 1;
+			if (idx >= a->ring_buffsize) idx -= a->ring_buffsize;
+			if (a->abs_ring[a->peak[idx]] > a->abs_ring[k]) break;
+			a->peak_count--;
+		}
+		idx = a->peak_head + a->peak_count;
+		if (idx >= a->ring_buffsize) idx -= a->ring_buffsize;
+		a->peak[idx] = k;
+		a->peak_count++;
+	}
+	if (a->peak_count > 0)
+		a->ring_max = a->abs_ring[a->peak[a->peak_head]];
+	else
+		a->ring_max = 0.0;
+}
+
+void mag_wcpagc (WCPAGC a)
+{	// magnitude pre-pass over the input block:  max(|I|, |Q|) for pmode 0, sqrt(I*I + Q*Q) otherwise
+	int i;
+	const int n2 = a->io_buffsize & ~1;
+	const __m128d nosign = _mm_castsi128_pd (_mm_set1_epi64x (0x7fffffffffffffffLL));
+	__m128d v0, v1, I, Q;
+	if (a->pmode == 0)
+	{
+		for (i = 0; i < n2; i += 2)
+		{
+			v0 = _mm_loadu_pd (&a->in[2 * i + 0]);
+			v1 = _mm_loadu_pd (&a->in[2 * i + 2]);
+			I = _mm_and_pd (_mm_unpacklo_pd (v0, v1), nosign);
+			Q = _mm_and_pd (_mm_unpackhi_pd (v0, v1), nosign);
+			_mm_storeu_pd (&a->abs_in[i], _mm_max_pd (Q, I));
+		}
+		for (; i < a->io_buffsize; i++)
+			a->abs_in[i] = max(fabs(a->in[2 * i + 0]), fabs(a->in[2 * i + 1]));
+	}
+	else
+	{
+		for (i = 0; i < n2; i += 2)
+		{
+			v0 = _mm_loadu_pd (&a->in[2 * i + 0]);
+			v1 = _mm_loadu_pd (&a->in[2 * i + 2]);
+			I = _mm_unpacklo_pd (v0, v1);
+			Q = _mm_unpackhi_pd (v0, v1);
+			_mm_storeu_pd (&a->abs_in[i], _mm_sqrt_pd (_mm_add_pd (_mm_mul_pd (I, I), _mm_mul_pd (Q, Q))));
+		}
+		for (; i < a->io_buffsize; i++)
+			a->abs_in[i] = sqrt(a->in[2 * i + 0] * a->in[2 * i + 0] + a->in[2 * i + 1] * a->in[2 * i + 1]);
+	}
 }
 
 void destroy_wcpagc (WCPAGC a)
@@ -156,11 +224,13 @@ void flush_wcpagc (WCPAGC a)
 	memset ((void *)a->ring, 0, sizeof(double) * RB_SIZE * 2);
 	a->ring_max = 0.0;
 	memset ((void *)a->abs_ring, 0, sizeof(double)* RB_SIZE);
+	a->peak_head = 0;
+	a->peak_count = 0;
 }
 
 void xwcpagc (WCPAGC a)
 {
-	int i, j, k;
+	int i, idx;
 	double mult;
 	if (a->run)
 	{
@@ -173,7 +243,8 @@ void xwcpagc (WCPAGC a)
 			}
 			return;
 		}
-	
+
+		mag_wcpagc (a);
 		for (i = 0; i < a->io_buffsize; i++)
 		{
 			if (++a->out_index >= a->ring_buffsize)
@@ -186,28 +257,31 @@ void xwcpagc (WCPAGC a)
 			a->abs_out_sample = a->abs_ring[a->out_index];
 			a->ring[2 * a->in_index + 0] = a->in[2 * i + 0];
 			a->ring[2 * a->in_index + 1] = a->in[2 * i + 1];
-			if (a->pmode == 0)
-				a->abs_ring[a->in_index] = max(fabs(a->ring[2 * a->in_index + 0]), fabs(a->ring[2 * a->in_index + 1]));
-			else
-				a->abs_ring[a->in_index] = sqrt(a->ring[2 * a->in_index + 0] * a->ring[2 * a->in_index + 0] + a->ring[2 * a->in_index + 1] * a->ring[2 * a->in_index + 1]);
+			a->abs_ring[a->in_index] = a->abs_in[i];
 
 			a->fast_backaverage = a->fast_backmult * a->abs_out_sample + a->onemfast_backmult * a->fast_backaverage;
 			a->hang_backaverage = a->hang_backmult * a->abs_out_sample + a->onemhang_backmult * a->hang_backaverage;
 
-			if ((a->abs_out_sample >= a->ring_max) && (a->abs_out_sample > 0.0))
+			// sliding-window maximum over out_index + 1 ... in_index:  retire the outgoing
+			// index from the front, drop dominated entries from the back, append the new one
+			if (a->peak_count > 0 && a->peak[a->peak_head] == a->out_index)
 			{
-				a->ring_max = 0.0;
-				k = a->out_index;
-				for (j = 0; j < a->attack_buffsize; j++)
-				{
-					if (++k == a->ring_buffsize)
-						k = 0;
-					if (a->abs_ring[k] > a->ring_max)
-						a->ring_max = a->abs_ring[k];
-				}
+				if (++a->peak_head >= a->ring_buffsize)
+					a->peak_head -= a->ring_buffsize;
+				a->peak_count--;
+			}
+			while (a->peak_count > 0)
+			{
+				idx = a->peak_head + a->peak_count - 1;
+				if (idx >= a->ring_buffsize) idx -= a->ring_buffsize;
+				if (a->abs_ring[a->peak[idx]] > a->abs_in[i]) break;
+				a->peak_count--;
 			}
-			if (a->abs_ring[a->in_index] > a->ring_max)
-				a->ring_max = a->abs_ring[a->in_index];
+			idx = a->peak_head + a->peak_count;
+			if (idx >= a->ring_buffsize) idx -= a->ring_buffsize;
+			a->peak[idx] = a->in_index;
+			a->peak_count++;
+			a->ring_max = a->abs_ring[a->peak[a->peak_head]];
 
 			if (a->hang_counter > 0)
 				--a->hang_counter;
@@ -68,6 +68,10 @@ typedef struct _wcpagc
 	double* abs_ring;
 	int ring_buffsize;
 	double ring_max;
+	int* peak;					// monotonic deque of abs_ring indices, front holds the window maximum
+	int peak_head;
+	int peak_count;
+	double* abs_in;				// per-block magnitude pre-pass
 
 	double attack_mult;
 	double decay_mult;
@@ -102,6 +106,10 @@ typedef struct _wcpagc
 
 extern void loadWcpAGC (WCPAGC a);
 
+extern void reset_peak_wcpagc (WCPAGC a);
+
+extern void mag_wcpagc (WCPAGC a);
+
 extern void xwcpagc (WCPAGC a);
 
 extern WCPAGC create_wcpagc (	int run,
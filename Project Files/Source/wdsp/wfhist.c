@@ -0,0 +1,251 @@
+/*  wfhist.c
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+#include "comm.h"
+
+/********************************************************************************************************
+*																										*
+*										Waterfall History												*
+*																										*
+********************************************************************************************************/
+
+// Optional per-display store of waterfall rows.  Each frame of the selected pixel output is quantized to
+// 8 or 16 bits and written to a fixed ring along with its time and frequency limits.  The analyzer thread
+// claims rows with an interlocked serial number and publishes each one with a per-row sequence count, so
+// it never waits on a reader; readers select rows by time and copy them out in bulk without consuming them.
+// stitch() appends rows under ResampleSection, so serial order is time order and rows can be searched by time.
+
+WFHIST create_wfhist (int pixout, int rows, int max_pixels, int bits, double db_min, double db_max)
+{
+	WFHIST a = (WFHIST) malloc0 (sizeof (wfhist));
+	int n = 1;
+	while (n < rows) n <<= 1;
+	a->pixout = pixout;
+	a->rows = n;
+	a->mask = n - 1;
+	a->max_pixels = max_pixels;
+	a->bits = (bits > 8) ? 16 : 8;
+	a->db_min = db_min;
+	a->step = (db_max - db_min) / (double)((1 << a->bits) - 1);
+	a->inv_step = 1.0 / a->step;
+	a->widx = 0;
+	a->row = (wfhist_row *) malloc0 (a->rows * sizeof (wfhist_row));
+	a->data = (unsigned char *) malloc0 (a->rows * a->max_pixels * (a->bits >> 3));
+	QueryPerformanceFrequency (&a->freq);
+	QueryPerformanceCounter (&a->t0);
+	return a;
+}
+
+void destroy_wfhist (WFHIST a)
+{
+	_aligned_free (a->data);
+	_aligned_free (a->row);
+	_aligned_free (a);
+}
+
+void xwfhist (WFHIST a, int n, double f_min, double f_max, dOUTREAL* pixels)
+{
+	int i, q;
+	const int qmax = (1 << a->bits) - 1;
+	LARGE_INTEGER now;
+	long s = InterlockedIncrement (&a->widx) - 1;
+	wfhist_row* r = &a->row[s & a->mask];
+	QueryPerformanceCounter (&now);
+	if (n > a->max_pixels) n = a->max_pixels;
+	InterlockedIncrement (&r->seq);
+	r->serial = s;
+	r->n = n;
+	r->t = now.QuadPart;
+	r->f_min = f_min;
+	r->f_max = f_max;
+	if (a->bits == 8)
+	{
+		unsigned char* d = a->data + (size_t)(s & a->mask) * a->max_pixels;
+		for (i = 0; i < n; i++)
+		{
+			q = (int)(((double)pixels[i] - a->db_min) * a->inv_step + 0.5);
+			d[i] = (unsigned char)(q < 0 ? 0 : (q > qmax ? qmax : q));
+		}
+	}
+	else
+	{
+		unsigned short* d = (unsigned short *)a->data + (size_t)(s & a->mask) * a->max_pixels;
+		for (i = 0; i < n; i++)
+		{
+			q = (int)(((double)pixels[i] - a->db_min) * a->inv_step + 0.5);
+			d[i] = (unsigned short)(q < 0 ? 0 : (q > qmax ? qmax : q));
+		}
+	}
+	InterlockedIncrement (&r->seq);
+}
+
+long find_wfhist (WFHIST a, long first, long last, long long t)
+{	// serial of the first row in [first, last) produced at or after t; rows are in time order
+	long mid;
+	wfhist_row* r;
+	while (first < last)
+	{
+		mid = first + (last - first) / 2;
+		r = &a->row[mid & a->mask];
+		if (r->serial > mid || (r->serial == mid && r->t < t))
+			first = mid + 1;				// overwritten by a newer row, or too old
+		else
+			last = mid;						// not written yet, or new enough
+	}
+	return first;
+}
+
+int read_wfhist (WFHIST a, double t_from, double t_to, int max_rows, int stride,
+	double* t, double* f_min, double* f_max, int* n, dOUTREAL* pix, void* raw)
+{	// copies up to 'max_rows' rows produced between t_from and t_to (seconds since the history started),
+	// oldest first, either dequantized to 'pix' or as stored to 'raw'; 'stride' is in pixels
+	int i, m, k = 0;
+	long s, seq;
+	long last = InterlockedAnd (&a->widx, 0xFFFFFFFF);
+	long first = last - a->rows;
+	const double freq = (double)a->freq.QuadPart;
+	const long long tt = a->t0.QuadPart + (long long)(t_to * freq);
+	const int bytes = a->bits >> 3;
+	wfhist_row* r;
+	wfhist_row c;
+	if (first < 0) first = 0;
+	s = find_wfhist (a, first, last, a->t0.QuadPart + (long long)(t_from * freq));
+	for (; s < last && k < max_rows; s++)
+	{
+		r = &a->row[s & a->mask];
+		seq = InterlockedAnd (&r->seq, 0xFFFFFFFF);
+		if (seq & 1)
+		{	// being overwritten at the old end, or still being written at the new end
+			if (s < last - a->rows / 2) continue;
+			break;
+		}
+		c = *r;
+		_ReadWriteBarrier ();
+		if (c.serial < s || c.t > tt) break;						// not written yet, or past the range
+		if (c.serial > s) continue;									// already overwritten
+		m = (c.n < stride) ? c.n : stride;
+		if (raw)
+			memcpy ((unsigned char *)raw + (size_t)k * stride * bytes, a->data + (size_t)(s & a->mask) * a->max_pixels * bytes, m * bytes);
+		else if (bytes == 1)
+		{
+			unsigned char* d = a->data + (size_t)(s & a->mask) * a->max_pixels;
+			for (i = 0; i < m; i++)
+				pix[(size_t)k * stride + i] = (dOUTREAL)(a->db_min + a->step * (double)d[i]);
+		}
+		else
+		{
+			unsigned short* d = (unsigned short *)a->data + (size_t)(s & a->mask) * a->max_pixels;
+			for (i = 0; i < m; i++)
+				pix[(size_t)k * stride + i] = (dOUTREAL)(a->db_min + a->step * (double)d[i]);
+		}
+		_ReadWriteBarrier ();
+		if (InterlockedAnd (&r->seq, 0xFFFFFFFF) != seq) continue;	// overwritten while copying
+		t[k]     = (double)(c.t - a->t0.QuadPart) / freq;
+		f_min[k] = c.f_min;
+		f_max[k] = c.f_max;
+		n[k]     = m;
+		k++;
+	}
+	return k;
+}
+
+/********************************************************************************************************
+*																										*
+*											Properties													*
+*																										*
+********************************************************************************************************/
+
+PORT
+void SetDisplayHistory (int disp, int pixout, int run, int rows, int max_pixels, int bits, double db_min, double db_max)
+{	// run = 1 starts a new history of the most recent 'rows' frames of 'pixout'; run = 0 discards it
+	DP a = pdisp[disp];
+	WFHIST old;
+	EnterCriticalSection (&a->HistorySection);
+	old = (WFHIST)InterlockedExchangePointer ((void* volatile*)&a->hist,
+		run ? create_wfhist (pixout, rows, max_pixels, bits, db_min, db_max) : 0);
+	if (old)
+	{	// a stitch that captured 'old' before the exchange is still counted in stitch_users
+		while (_InterlockedAnd (&a->stitch_users, 0xffffffff)) Sleep (0);
+		destroy_wfhist (old);
+	}
+	LeaveCriticalSection (&a->HistorySection);
+}
+
+PORT
+void GetDisplayHistoryInfo (int disp, int* count, double* t_first, double* t_last, int* bits, double* db_min, double* step)
+{	// times of the oldest and newest rows held, and the quantization needed to interpret raw rows
+	DP a = pdisp[disp];
+	WFHIST h;
+	long last, first;
+	*count = 0;
+	*t_first = 0.0;
+	*t_last = 0.0;
+	*bits = 0;
+	*db_min = 0.0;
+	*step = 0.0;
+	EnterCriticalSection (&a->HistorySection);
+	h = a->hist;
+	if (h)
+	{
+		last = InterlockedAnd (&h->widx, 0xFFFFFFFF);
+		first = last - h->rows;
+		if (first < 0) first = 0;
+		if (last > first)
+		{
+			*count = last - first;
+			*t_first = (double)(h->row[first & h->mask].t - h->t0.QuadPart) / (double)h->freq.QuadPart;
+			*t_last  = (double)(h->row[(last - 1) & h->mask].t - h->t0.QuadPart) / (double)h->freq.QuadPart;
+		}
+		*bits = h->bits;
+		*db_min = h->db_min;
+		*step = h->step;
+	}
+	LeaveCriticalSection (&a->HistorySection);
+}
+
+PORT
+void GetDisplayHistory (int disp, double t_from, double t_to, int max_rows, int stride,
+	int* count, double* t, double* f_min, double* f_max, int* n, dOUTREAL* pix)
+{	// rows as dB values, 'stride' pixels apart in 'pix'
+	DP a = pdisp[disp];
+	*count = 0;
+	EnterCriticalSection (&a->HistorySection);
+	if (a->hist)
+		*count = read_wfhist (a->hist, t_from, t_to, max_rows, stride, t, f_min, f_max, n, pix, 0);
+	LeaveCriticalSection (&a->HistorySection);
+}
+
+PORT
+void GetDisplayHistoryRaw (int disp, double t_from, double t_to, int max_rows, int stride,
+	int* count, double* t, double* f_min, double* f_max, int* n, void* raw)
+{	// rows as stored, 'stride' pixels apart in 'raw'; dB = db_min + step * level
+	DP a = pdisp[disp];
+	*count = 0;
+	EnterCriticalSection (&a->HistorySection);
+	if (a->hist)
+		*count = read_wfhist (a->hist, t_from, t_to, max_rows, stride, t, f_min, f_max, n, 0, raw);
+	LeaveCriticalSection (&a->HistorySection);
+}
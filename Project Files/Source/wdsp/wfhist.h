@@ -0,0 +1,79 @@
+/*  wfhist.h
+
+This file is part of a program that implements a Software-Defined Radio.
+
+Copyright (C) 2026 Warren Pratt, NR0V
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+The author can be reached by email at
+
+warren@wpratt.com
+
+*/
+
+#ifndef _wfhist_h
+#define _wfhist_h
+#include "comm.h"
+
+typedef struct _wfhist_row
+{
+	volatile long seq;							// odd while the row is being written
+	long serial;								// serial number of the row held
+	int n;										// number of pixels held
+	long long t;								// performance counter when the row was produced
+	double f_min;								// frequency at the first pixel
+	double f_max;								// frequency at the last pixel
+} wfhist_row;
+
+typedef struct _wfhist
+{
+	int pixout;									// pixel output that feeds the history
+	int rows;									// number of rows held, a power of two
+	int mask;
+	int max_pixels;								// pixels stored per row; wider frames are truncated
+	int bits;									// 8 or 16 bits per pixel
+	double db_min;								// dB value of quantization level zero
+	double step;								// dB per quantization level
+	double inv_step;
+	volatile long widx;							// serial number of the next row to be written
+	wfhist_row* row;
+	unsigned char* data;						// rows * max_pixels quantized pixels
+	LARGE_INTEGER freq;
+	LARGE_INTEGER t0;							// row times are reported as seconds since t0
+} wfhist, *WFHIST;
+
+extern WFHIST create_wfhist (int pixout, int rows, int max_pixels, int bits, double db_min, double db_max);
+
+extern void destroy_wfhist (WFHIST a);
+
+extern void xwfhist (WFHIST a, int n, double f_min, double f_max, dOUTREAL* pixels);
+
+extern int read_wfhist (WFHIST a, double t_from, double t_to, int max_rows, int stride,
+	double* t, double* f_min, double* f_max, int* n, dOUTREAL* pix, void* raw);
+
+// Display Properties
+
+extern __declspec (dllexport) void SetDisplayHistory (int disp, int pixout, int run, int rows, int max_pixels, int bits, double db_min, double db_max);
+
+extern __declspec (dllexport) void GetDisplayHistoryInfo (int disp, int* count, double* t_first, double* t_last, int* bits, double* db_min, double* step);
+
+extern __declspec (dllexport) void GetDisplayHistory (int disp, double t_from, double t_to, int max_rows, int stride,
+	int* count, double* t, double* f_min, double* f_max, int* n, dOUTREAL* pix);
+
+extern __declspec (dllexport) void GetDisplayHistoryRaw (int disp, double t_from, double t_to, int max_rows, int stride,
+	int* count, double* t, double* f_min, double* f_max, int* n, void* raw);
+
+#endif
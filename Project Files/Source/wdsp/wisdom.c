@@ -39,7 +39,7 @@ PORT
 void WDSPwisdom (char* directory)
 {
 	fftw_plan tplan;
-	int psize;
+	int psize, imported;
 	FILE *stream;
 	double* fftin;
 	double* fftout;
@@ -47,7 +47,10 @@ void WDSPwisdom (char* directory)
 	const int maxsize = max (MAX_WISDOM_SIZE_DISPLAY, MAX_WISDOM_SIZE_FILTER + 1);
 	strcpy (wisdom_file, directory);
 	strncat (wisdom_file, "wdspWisdom00", 16);
-	if(!fftw_import_wisdom_from_filename(wisdom_file))
+	enter_planner ();
+	imported = fftw_import_wisdom_from_filename(wisdom_file);
+	leave_planner ();
+	if(!imported)
 	{
 		fftin =  (double *) malloc0 (maxsize * sizeof (complex));
 		fftout = (double *) malloc0 (maxsize * sizeof (complex));
@@ -62,21 +65,33 @@ void WDSPwisdom (char* directory)
 			fprintf(stdout, "Planning COMPLEX FORWARD  FFT size %d\n", psize);
 			fflush(stdout);
 			sprintf(status, "Planning COMPLEX FORWARD  FFT size %d\n", psize);
+			enter_planner ();
 			tplan = fftw_plan_dft_1d(psize, (fftw_complex *)fftin, (fftw_complex *)fftout, FFTW_FORWARD, FFTW_PATIENT);
+			leave_planner ();
 			fftw_execute (tplan);
+			enter_planner ();
 			fftw_destroy_plan (tplan);
+			leave_planner ();
 			fprintf(stdout, "Planning COMPLEX BACKWARD FFT size %d\n", psize);
 			fflush(stdout);
 			sprintf(status, "Planning COMPLEX BACKWARD FFT size %d\n", psize);
+			enter_planner ();
 			tplan = fftw_plan_dft_1d(psize, (fftw_complex *)fftin, (fftw_complex *)fftout, FFTW_BACKWARD, FFTW_PATIENT);
+			leave_planner ();
 			fftw_execute (tplan);
+			enter_planner ();
 			fftw_destroy_plan (tplan);
+			leave_planner ();
 			fprintf(stdout, "Planning COMPLEX BACKWARD FFT size %d\n", psize + 1);
 			fflush(stdout);
 			sprintf(status, "Planning COMPLEX BACKWARD FFT size %d\n", psize + 1);
+			enter_planner ();
 			tplan = fftw_plan_dft_1d(psize + 1, (fftw_complex *)fftin, (fftw_complex *)fftout, FFTW_BACKWARD, FFTW_PATIENT);
+			leave_planner ();
 			fftw_execute (tplan);
+			enter_planner ();
 			fftw_destroy_plan (tplan);
+			leave_planner ();
 			psize *= 2;
 		}
 		psize = 64;
@@ -87,22 +102,32 @@ void WDSPwisdom (char* directory)
 				fprintf(stdout, "Planning COMPLEX FORWARD  FFT size %d\n", psize);
 				fflush(stdout);
 				sprintf(status, "Planning COMPLEX FORWARD  FFT size %d\n", psize);
+				enter_planner ();
 				tplan = fftw_plan_dft_1d(psize, (fftw_complex *)fftin, (fftw_complex *)fftout, FFTW_FORWARD, FFTW_PATIENT);
+				leave_planner ();
 				fftw_execute (tplan);
+				enter_planner ();
 				fftw_destroy_plan (tplan);
+				leave_planner ();
 			}
 			fprintf(stdout, "Planning REAL    FORWARD  FFT size %d\n", psize);
 			fflush(stdout);
 			sprintf(status, "Planning REAL    FORWARD  FFT size %d\n", psize);
+			enter_planner ();
 			tplan = fftw_plan_dft_r2c_1d(psize, fftin, (fftw_complex *)fftout, FFTW_PATIENT);
+			leave_planner ();
 			fftw_execute (tplan);
+			enter_planner ();
 			fftw_destroy_plan (tplan);
+			leave_planner ();
 			psize *= 2;
 		}
 		fprintf(stdout, "\nFFTW planning complete.\n");
 		fflush(stdout);
 		sprintf(status, "\nFFTW planning complete.\n");
+		enter_planner ();
 		fftw_export_wisdom_to_filename(wisdom_file);
+		leave_planner ();
 		_aligned_free (fftout);
 		_aligned_free (fftin);
 		FreeConsole();							// dismiss console